@@ -13,6 +13,7 @@
 #pragma once
 
 #include "atlas/array/Array.h"
+#include "atlas/array/ArrayAllocation.h"
 #include "atlas/array/ArrayShape.h"
 #include "atlas/array/ArraySpec.h"
 #include "atlas/array/ArrayStrides.h"
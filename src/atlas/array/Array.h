@@ -40,6 +40,8 @@ public:
 
     static Array* create( array::DataType, const ArrayShape&, const ArrayLayout& );
 
+    static Array* create( array::DataType, const ArraySpec& );
+
     virtual size_t footprint() const = 0;
 
     template <typename Value>
@@ -0,0 +1,47 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <sstream>
+
+#include "eckit/config/Parametrisation.h"
+#include "eckit/exception/Exceptions.h"
+
+#include "atlas/array/ArrayAllocation.h"
+
+namespace atlas {
+namespace array {
+
+ArrayAllocation::ArrayAllocation( const eckit::Parametrisation& config ) {
+    long alignment = alignment_;
+    config.get( "alignment", alignment );
+    if ( alignment <= 0 ) {
+        std::stringstream msg;
+        msg << "Array alignment must be positive, got " << alignment;
+        throw eckit::BadParameter( msg.str(), Here() );
+    }
+    this->alignment( alignment );
+    config.get( "initialise", initialise_ );
+    config.get( "first_touch", first_touch_ );
+    config.get( "huge_pages", huge_pages_ );
+    config.get( "pool", pool_ );
+}
+
+ArrayAllocation& ArrayAllocation::alignment( size_t bytes ) {
+    if ( bytes == 0 || ( bytes & ( bytes - 1 ) ) ) {
+        std::stringstream msg;
+        msg << "Array alignment must be a power of two, got " << bytes;
+        throw eckit::BadParameter( msg.str(), Here() );
+    }
+    alignment_ = bytes;
+    return *this;
+}
+
+}  // namespace array
+}  // namespace atlas
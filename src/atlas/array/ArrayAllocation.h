@@ -0,0 +1,79 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+namespace eckit {
+class Parametrisation;
+}
+
+//------------------------------------------------------------------------------------------------------
+
+namespace atlas {
+namespace array {
+
+/// @brief How the storage of an Array is allocated and initialised
+///
+/// Honoured by the native backend; the gridtools backend manages its own storage.
+/// The default gives zero-initialised storage aligned to a cache line, which is what
+/// Array::create has always provided, minus the alignment guarantee.
+///
+/// Configuration keys:
+///   - "alignment"   : alignment of the first element in bytes, a power of two (default 64)
+///   - "initialise"  : zero the storage (default true). Without it the values are undefined.
+///   - "first_touch" : touch the pages with a static OpenMP schedule, so that each page is
+///                     placed on the NUMA node of the thread that will process it in an
+///                     equally scheduled loop (default false)
+///   - "huge_pages"  : advise the kernel to back large arrays by transparent huge pages (default false)
+///   - "pool"        : return the storage to a pool on destruction, and take storage of the same
+///                     size from that pool on creation (default false)
+class ArrayAllocation {
+public:
+    ArrayAllocation() = default;
+    ArrayAllocation( const eckit::Parametrisation& );
+
+    size_t alignment() const { return alignment_; }
+    bool initialise() const { return initialise_; }
+    bool first_touch() const { return first_touch_; }
+    bool huge_pages() const { return huge_pages_; }
+    bool pool() const { return pool_; }
+
+    ArrayAllocation& alignment( size_t bytes );
+    ArrayAllocation& initialise( bool value ) {
+        initialise_ = value;
+        return *this;
+    }
+    ArrayAllocation& first_touch( bool value ) {
+        first_touch_ = value;
+        return *this;
+    }
+    ArrayAllocation& huge_pages( bool value ) {
+        huge_pages_ = value;
+        return *this;
+    }
+    ArrayAllocation& pool( bool value ) {
+        pool_ = value;
+        return *this;
+    }
+
+private:
+    size_t alignment_{64};
+    bool initialise_{true};
+    bool first_touch_{false};
+    bool huge_pages_{false};
+    bool pool_{false};
+};
+
+//------------------------------------------------------------------------------------------------------
+
+}  // namespace array
+}  // namespace atlas
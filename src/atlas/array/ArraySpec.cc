@@ -50,6 +50,10 @@ ArraySpec::ArraySpec( const ArrayShape& shape, ArrayAlignment&& alignment ) {
     default_layout_ = true;
 };
 
+ArraySpec::ArraySpec( const ArrayShape& shape, const ArrayAllocation& allocation ) : ArraySpec( shape ) {
+    allocation_ = allocation;
+}
+
 ArraySpec::ArraySpec( const ArrayShape& shape, const ArrayStrides& strides ) :
     ArraySpec( shape, strides, ArrayAlignment() ) {}
 
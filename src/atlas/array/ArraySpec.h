@@ -13,6 +13,7 @@
 #include <stddef.h>
 #include <vector>
 
+#include "atlas/array/ArrayAllocation.h"
 #include "atlas/array/ArrayIdx.h"
 #include "atlas/array/ArrayLayout.h"
 #include "atlas/array/ArrayShape.h"
@@ -32,6 +33,7 @@ private:
     ArrayStrides strides_;
     ArrayLayout layout_;
     ArrayAlignment alignment_;
+    ArrayAllocation allocation_;
     mutable std::vector<int> shapef_;
     mutable std::vector<int> stridesf_;
     bool contiguous_;
@@ -45,11 +47,13 @@ public:
     ArraySpec( const ArrayShape&, ArrayAlignment&& );
     ArraySpec( const ArrayShape&, const ArrayStrides&, ArrayAlignment&& );
     ArraySpec( const ArrayShape&, const ArrayStrides&, const ArrayLayout&, ArrayAlignment&& );
+    ArraySpec( const ArrayShape&, const ArrayAllocation& );
     size_t allocatedSize() const { return allocated_size_; }
     size_t size() const { return size_; }
     size_t rank() const { return rank_; }
     const ArrayShape& shape() const { return shape_; }
     const ArrayAlignment& alignment() const { return alignment_; }
+    const ArrayAllocation& allocation() const { return allocation_; }
     const ArrayStrides& strides() const { return strides_; }
     const ArrayLayout& layout() const { return layout_; }
     const std::vector<int>& shapef() const;
@@ -37,9 +37,9 @@ public:
         externally_allocated_( other.externally_allocated_ ) {}
 
     ATLAS_HOST_DEVICE
-    SVector( T* data, size_t size ) : data_( data ), size_( size ) {}
+    SVector( T* data, size_t size ) : data_( data ), size_( size ), externally_allocated_( true ) {}
 
-    SVector( size_t N ) : size_( N ) {
+    SVector( size_t N ) : size_( N ), externally_allocated_( false ) {
 #if ATLAS_GRIDTOOLS_STORAGE_BACKEND_CUDA
         cudaError_t err = cudaMallocManaged( &data_, N * sizeof( T ) );
         if ( err != cudaSuccess ) throw eckit::AssertionFailed( "failed to allocate GPU memory" );
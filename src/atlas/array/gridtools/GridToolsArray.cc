@@ -314,6 +314,28 @@ Array* Array::create( DataType datatype, const ArrayShape& shape, const ArrayLay
     return 0;
 }
 
+// The gridtools storage manages its own memory, so spec.allocation() is not used
+Array* Array::create( DataType datatype, const ArraySpec& spec ) {
+    switch ( datatype.kind() ) {
+        case DataType::KIND_REAL64:
+            return new ArrayT<double>( spec );
+        case DataType::KIND_REAL32:
+            return new ArrayT<float>( spec );
+        case DataType::KIND_INT32:
+            return new ArrayT<int>( spec );
+        case DataType::KIND_INT64:
+            return new ArrayT<long>( spec );
+        case DataType::KIND_UINT64:
+            return new ArrayT<unsigned long>( spec );
+        default: {
+            std::stringstream err;
+            err << "data kind " << datatype.kind() << " not recognised.";
+            throw eckit::BadParameter( err.str(), Here() );
+        }
+    }
+    return 0;
+}
+
 //------------------------------------------------------------------------------
 
 Array::~Array() {}
@@ -0,0 +1,154 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "eckit/thread/AutoLock.h"
+#include "eckit/thread/Mutex.h"
+
+#include "atlas/array/native/NativeAllocator.h"
+#include "atlas/parallel/omp/omp.h"
+
+namespace atlas {
+namespace array {
+namespace native {
+
+namespace {
+
+static const size_t huge_page_size = 2 * 1024 * 1024;
+
+size_t page_size() {
+    static const size_t size = size_t( sysconf( _SC_PAGESIZE ) );
+    return size;
+}
+
+/// Effective alignment: at least a pointer, and a huge page when huge pages are requested
+size_t alignment( size_t bytes, const ArrayAllocation& allocation ) {
+    size_t a = std::max( allocation.alignment(), sizeof( void* ) );
+    if ( allocation.huge_pages() && bytes >= huge_page_size ) { a = std::max( a, huge_page_size ); }
+    return a;
+}
+
+/// Free buffers of released pooled arrays, by size and alignment.
+/// Never destroyed, so that arrays with static lifetime can still return their storage.
+class Pool {
+public:
+    static Pool& instance() {
+        static Pool* pool = new Pool();
+        return *pool;
+    }
+
+    void* pop( size_t bytes, size_t alignment ) {
+        eckit::AutoLock<eckit::Mutex> lock( mutex_ );
+        auto it = free_.find( std::make_pair( bytes, alignment ) );
+        if ( it == free_.end() || it->second.empty() ) { return nullptr; }
+        void* data = it->second.back();
+        it->second.pop_back();
+        footprint_ -= bytes;
+        return data;
+    }
+
+    void push( void* data, size_t bytes, size_t alignment ) {
+        eckit::AutoLock<eckit::Mutex> lock( mutex_ );
+        free_[std::make_pair( bytes, alignment )].push_back( data );
+        footprint_ += bytes;
+    }
+
+    void release() {
+        eckit::AutoLock<eckit::Mutex> lock( mutex_ );
+        for ( auto& buffers : free_ ) {
+            for ( void* data : buffers.second ) {
+                ::free( data );
+            }
+        }
+        free_.clear();
+        footprint_ = 0;
+    }
+
+    size_t footprint() {
+        eckit::AutoLock<eckit::Mutex> lock( mutex_ );
+        return footprint_;
+    }
+
+private:
+    Pool() = default;
+
+    eckit::Mutex mutex_;
+    std::map<std::pair<size_t, size_t>, std::vector<void*>> free_;
+    size_t footprint_{0};
+};
+
+void initialise( void* data, size_t bytes, const ArrayAllocation& allocation ) {
+    if ( allocation.first_touch() ) {
+        // One page per iteration: the static schedule gives each thread a contiguous range of
+        // pages, matching the placement of an equally scheduled loop over the array elements
+        char* begin       = static_cast<char*>( data );
+        const size_t page = page_size();
+        const long npages = long( ( bytes + page - 1 ) / page );
+        const bool zero   = allocation.initialise();
+        atlas_omp_parallel_for( long p = 0; p < npages; ++p ) {
+            const size_t offset = size_t( p ) * page;
+            const size_t size   = std::min( page, bytes - offset );
+            if ( zero ) { std::memset( begin + offset, 0, size ); }
+            else {
+                begin[offset] = 0;
+            }
+        }
+    }
+    else if ( allocation.initialise() ) {
+        std::memset( data, 0, bytes );
+    }
+}
+
+}  // namespace
+
+void* allocate( size_t bytes, const ArrayAllocation& allocation ) {
+    if ( bytes == 0 ) { return nullptr; }
+    const size_t align = alignment( bytes, allocation );
+
+    void* data = allocation.pool() ? Pool::instance().pop( bytes, align ) : nullptr;
+    if ( data == nullptr ) {
+        if ( ::posix_memalign( &data, align, bytes ) != 0 ) { throw std::bad_alloc(); }
+#ifdef MADV_HUGEPAGE
+        // Only advisory: the kernel falls back to normal pages when huge pages are unavailable
+        if ( allocation.huge_pages() && bytes >= huge_page_size ) { ::madvise( data, bytes, MADV_HUGEPAGE ); }
+#endif
+    }
+    initialise( data, bytes, allocation );
+    return data;
+}
+
+void deallocate( void* data, size_t bytes, const ArrayAllocation& allocation ) {
+    if ( data == nullptr ) { return; }
+    if ( allocation.pool() ) { Pool::instance().push( data, bytes, alignment( bytes, allocation ) ); }
+    else {
+        ::free( data );
+    }
+}
+
+void release_pool() {
+    Pool::instance().release();
+}
+
+size_t pool_footprint() {
+    return Pool::instance().footprint();
+}
+
+}  // namespace native
+}  // namespace array
+}  // namespace atlas
@@ -0,0 +1,38 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include "atlas/array/ArrayAllocation.h"
+
+//------------------------------------------------------------------------------
+
+namespace atlas {
+namespace array {
+namespace native {
+
+/// Allocate and initialise storage of given size in bytes as described by allocation.
+/// Returns nullptr for zero bytes.
+void* allocate( size_t bytes, const ArrayAllocation& allocation );
+
+/// Release storage obtained from allocate() with the same bytes and allocation
+void deallocate( void* data, size_t bytes, const ArrayAllocation& allocation );
+
+/// Free all storage kept by the pool for arrays created with ArrayAllocation::pool()
+void release_pool();
+
+/// Number of bytes currently kept by the pool
+size_t pool_footprint();
+
+}  // namespace native
+}  // namespace array
+}  // namespace atlas
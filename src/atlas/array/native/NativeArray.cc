@@ -72,6 +72,27 @@ Array* Array::create( DataType datatype, const ArrayShape& shape ) {
     return 0;
 }
 
+Array* Array::create( DataType datatype, const ArraySpec& spec ) {
+    switch ( datatype.kind() ) {
+        case DataType::KIND_REAL64:
+            return new ArrayT<double>( spec );
+        case DataType::KIND_REAL32:
+            return new ArrayT<float>( spec );
+        case DataType::KIND_INT32:
+            return new ArrayT<int>( spec );
+        case DataType::KIND_INT64:
+            return new ArrayT<long>( spec );
+        case DataType::KIND_UINT64:
+            return new ArrayT<unsigned long>( spec );
+        default: {
+            std::stringstream err;
+            err << "data kind " << datatype.kind() << " not recognised.";
+            throw eckit::BadParameter( err.str(), Here() );
+        }
+    }
+    return 0;
+}
+
 template <typename Value>
 ArrayT<Value>::ArrayT( ArrayDataStore* ds, const ArraySpec& spec ) {
     data_store_ = std::unique_ptr<ArrayDataStore>( ds );
@@ -126,7 +147,7 @@ template <typename Value>
 ArrayT<Value>::ArrayT( const ArraySpec& spec ) {
     if ( not spec.contiguous() ) NOTIMP;
     spec_       = spec;
-    data_store_ = std::unique_ptr<ArrayDataStore>( new native::DataStore<Value>( spec_.size() ) );
+    data_store_ = std::unique_ptr<ArrayDataStore>( new native::DataStore<Value>( spec_.size(), spec_.allocation() ) );
 }
 
 template <typename Value>
@@ -145,7 +166,8 @@ void ArrayT<Value>::resize( const ArrayShape& _shape ) {
         }
     }
 
-    Array* resized = Array::create<Value>( _shape );
+    // The resized array keeps the allocation of this array
+    Array* resized = new ArrayT<Value>( ArraySpec( _shape, spec_.allocation() ) );
 
     switch ( rank() ) {
         case 1:
@@ -191,7 +213,7 @@ void ArrayT<Value>::insert( size_t idx1, size_t size1 ) {
     }
     nshape[0] += size1;
 
-    Array* resized = Array::create<Value>( nshape );
+    Array* resized = new ArrayT<Value>( ArraySpec( nshape, spec_.allocation() ) );
 
     array_initializer_partitioned<0>::apply( *this, *resized, idx1, size1 );
     replace( *resized );
@@ -10,7 +10,9 @@
 
 #pragma once
 
+#include "atlas/array/ArrayAllocation.h"
 #include "atlas/array/ArrayUtil.h"
+#include "atlas/array/native/NativeAllocator.h"
 #include "atlas/library/config.h"
 
 //------------------------------------------------------------------------------
@@ -22,7 +24,16 @@ namespace native {
 template <typename Value>
 class DataStore : public ArrayDataStore {
 public:
-    DataStore( size_t size ) : data_store_( size ) {}
+    DataStore( size_t size ) : DataStore( size, ArrayAllocation() ) {}
+
+    DataStore( size_t size, const ArrayAllocation& allocation ) : size_( size ), allocation_( allocation ) {
+        data_store_ = static_cast<Value*>( allocate( size_ * sizeof( Value ), allocation_ ) );
+    }
+
+    DataStore( const DataStore& ) = delete;
+    DataStore& operator=( const DataStore& ) = delete;
+
+    ~DataStore() { deallocate( data_store_, size_ * sizeof( Value ), allocation_ ); }
 
     void cloneToDevice() const {}
 
@@ -40,14 +51,16 @@ public:
 
     void reactivateHostWriteViews() const {}
 
-    void* voidDataStore() { return static_cast<void*>( &data_store_.front() ); }
+    void* voidDataStore() { return static_cast<void*>( data_store_ ); }
 
-    void* voidHostData() { return static_cast<void*>( &data_store_.front() ); }
+    void* voidHostData() { return static_cast<void*>( data_store_ ); }
 
-    void* voidDeviceData() { return static_cast<void*>( &data_store_.front() ); }
+    void* voidDeviceData() { return static_cast<void*>( data_store_ ); }
 
 private:
-    std::vector<Value> data_store_;
+    size_t size_;
+    ArrayAllocation allocation_;
+    Value* data_store_;
 };
 
 //------------------------------------------------------------------------------
@@ -16,6 +16,8 @@
 #include "eckit/config/Parametrisation.h"
 #include "eckit/exception/Exceptions.h"
 
+#include "atlas/array/Array.h"
+#include "atlas/array/ArrayAllocation.h"
 #include "atlas/array/DataType.h"
 #include "atlas/field/detail/FieldImpl.h"
 
@@ -52,7 +54,8 @@ FieldImpl* FieldCreatorArraySpec::createField( const eckit::Parametrisation& par
 
     std::string name;
     params.get( "name", name );
-    return FieldImpl::create( name, datatype, array::ArrayShape( std::move( s ) ) );
+    array::ArraySpec spec( array::ArrayShape( std::move( s ) ), array::ArrayAllocation( params ) );
+    return FieldImpl::create( name, array::Array::create( datatype, spec ) );
 }
 
 namespace {
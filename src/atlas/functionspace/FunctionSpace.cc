@@ -23,6 +23,7 @@
 #include "atlas/field/detail/FieldImpl.h"
 #include "atlas/library/config.h"
 #include "atlas/mesh/actions/BuildParallelFields.h"
+#include "atlas/parallel/GatherScatter.h"
 #include "atlas/runtime/ErrorHandling.h"
 
 namespace atlas {
@@ -85,6 +86,103 @@ Field NoFunctionSpace::createField( const Field&, const eckit::Configuration& )
 
 // ------------------------------------------------------------------
 
+namespace {
+
+/// Field as ( points, levels, variables ), with dimensions of size 1 where absent
+template <typename T>
+parallel::Field<T> leveled_field( T* data, const Field& field ) {
+    size_t strides[3] = {field.stride( 0 ), 0, 0};
+    size_t shape[3]   = {1, 1, 1};
+    size_t dim        = 1;
+    if ( field.levels() ) {
+        strides[1] = field.stride( dim );
+        shape[1]   = field.shape( dim );
+        ++dim;
+    }
+    if ( field.variables() ) {
+        strides[2] = field.stride( dim );
+        shape[2]   = field.shape( dim );
+    }
+    return parallel::Field<T>( data, strides, shape, 3 );
+}
+
+/// Shape of the global field holding levels [begin,end) of given field
+array::ArrayShape chunk_shape( const Field& field, size_t nb_points, size_t begin, size_t end ) {
+    array::ArrayShape shape;
+    shape.push_back( nb_points );
+    if ( field.levels() ) { shape.push_back( end - begin ); }
+    if ( field.variables() ) { shape.push_back( field.variables() ); }
+    return shape;
+}
+
+template <typename T>
+void gather_chunks( const parallel::GatherScatter& gather, const Field& local, const FieldChunkCallback& callback,
+                    size_t levels_per_chunk, size_t root ) {
+    parallel::Field<T const> loc = leveled_field<T const>( local.data<T>(), local );
+    gather.gather<T>( loc, levels_per_chunk,
+                      [&]( const T chunk[], size_t begin, size_t end ) {
+                          Field glb( local.name(), const_cast<T*>( chunk ),
+                                     chunk_shape( local, gather.glb_dof(), begin, end ) );
+                          callback( glb, begin, end );
+                      },
+                      root );
+}
+
+template <typename T>
+void scatter_chunks( const parallel::GatherScatter& scatter, const FieldChunkCallback& callback, Field& local,
+                     size_t levels_per_chunk, size_t root ) {
+    parallel::Field<T> loc = leveled_field<T>( local.data<T>(), local );
+    scatter.scatter<T>( [&]( T chunk[], size_t begin, size_t end ) {
+                            Field glb( local.name(), chunk, chunk_shape( local, scatter.glb_dof(), begin, end ) );
+                            callback( glb, begin, end );
+                        },
+                        loc, levels_per_chunk, root );
+}
+
+}  // namespace
+
+namespace detail {
+
+void gather_chunked( const parallel::GatherScatter& gather, const Field& local, const FieldChunkCallback& callback,
+                     size_t levels_per_chunk, size_t root ) {
+    if ( local.datatype() == array::DataType::kind<int>() ) {
+        gather_chunks<int>( gather, local, callback, levels_per_chunk, root );
+    }
+    else if ( local.datatype() == array::DataType::kind<long>() ) {
+        gather_chunks<long>( gather, local, callback, levels_per_chunk, root );
+    }
+    else if ( local.datatype() == array::DataType::kind<float>() ) {
+        gather_chunks<float>( gather, local, callback, levels_per_chunk, root );
+    }
+    else if ( local.datatype() == array::DataType::kind<double>() ) {
+        gather_chunks<double>( gather, local, callback, levels_per_chunk, root );
+    }
+    else
+        throw eckit::Exception( "datatype not supported", Here() );
+}
+
+void scatter_chunked( const parallel::GatherScatter& scatter, const FieldChunkCallback& callback, Field& local,
+                      size_t levels_per_chunk, size_t root ) {
+    if ( local.datatype() == array::DataType::kind<int>() ) {
+        scatter_chunks<int>( scatter, callback, local, levels_per_chunk, root );
+    }
+    else if ( local.datatype() == array::DataType::kind<long>() ) {
+        scatter_chunks<long>( scatter, callback, local, levels_per_chunk, root );
+    }
+    else if ( local.datatype() == array::DataType::kind<float>() ) {
+        scatter_chunks<float>( scatter, callback, local, levels_per_chunk, root );
+    }
+    else if ( local.datatype() == array::DataType::kind<double>() ) {
+        scatter_chunks<double>( scatter, callback, local, levels_per_chunk, root );
+    }
+    else
+        throw eckit::Exception( "datatype not supported", Here() );
+}
+
+}  // namespace detail
+
+// ------------------------------------------------------------------
+
 }  // namespace functionspace
 
 // ------------------------------------------------------------------
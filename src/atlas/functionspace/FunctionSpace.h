@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 
 #include "eckit/memory/Owned.h"
@@ -19,9 +20,28 @@
 #include "atlas/option.h"
 #include "atlas/util/Config.h"
 
+namespace atlas {
+namespace parallel {
+class GatherScatter;
+}
+}  // namespace atlas
+
 namespace atlas {
 namespace functionspace {
 
+/// Called for every chunk of a chunked gather or scatter, with a global field holding
+/// the levels [level_begin,level_end) of all global points
+using FieldChunkCallback = std::function<void( Field& chunk, size_t level_begin, size_t level_end )>;
+
+namespace detail {
+/// Chunked gather and scatter of a field with ( points [, levels] [, variables] ) shape, shared
+/// by the function spaces
+void gather_chunked( const parallel::GatherScatter&, const Field& local, const FieldChunkCallback&,
+                     size_t levels_per_chunk, size_t root );
+void scatter_chunked( const parallel::GatherScatter&, const FieldChunkCallback&, Field& local,
+                      size_t levels_per_chunk, size_t root );
+}  // namespace detail
+
 #define FunctionspaceT_nonconst typename FunctionSpaceImpl::remove_const<FunctionSpaceT>::type
 #define FunctionspaceT_const typename FunctionSpaceImpl::add_const<FunctionSpaceT>::type
 
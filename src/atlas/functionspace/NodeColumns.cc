@@ -13,6 +13,7 @@
 #include <cstdarg>
 #include <functional>
 #include <limits>
+#include <type_traits>
 
 #include "eckit/utils/MD5.h"
 
@@ -32,6 +33,7 @@
 #include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/ErrorHandling.h"
 #include "atlas/runtime/Trace.h"
+#include "atlas/util/ExactSum.h"
 #include "atlas/util/detail/Cache.h"
 
 #undef atlas_omp_critical_ordered
@@ -411,6 +413,16 @@ void dispatch_haloExchange( Field& field, const parallel::HaloExchange& halo_exc
 }  // namespace
 
 void NodeColumns::haloExchange( FieldSet& fieldset, bool on_device ) const {
+    if ( fieldset.size() > 1 && not on_device ) {
+        // Aggregate all fields in a single message per neighbour
+        std::vector<array::Array*> arrays;
+        arrays.reserve( fieldset.size() );
+        for ( size_t f = 0; f < fieldset.size(); ++f ) {
+            arrays.push_back( &fieldset[f].array() );
+        }
+        halo_exchange().execute( arrays );
+        return;
+    }
     for ( size_t f = 0; f < fieldset.size(); ++f ) {
         Field& field = fieldset[f];
         switch ( field.rank() ) {
@@ -438,6 +450,25 @@ void NodeColumns::haloExchange( Field& field, bool on_device ) const {
     fieldset.add( field );
     haloExchange( fieldset, on_device );
 }
+parallel::HaloExchange::Handle NodeColumns::haloExchangeStart( FieldSet& fieldset ) const {
+    std::vector<array::Array*> arrays;
+    arrays.reserve( fieldset.size() );
+    for ( size_t f = 0; f < fieldset.size(); ++f ) {
+        arrays.push_back( &fieldset[f].array() );
+    }
+    return halo_exchange().start( arrays );
+}
+
+parallel::HaloExchange::Handle NodeColumns::haloExchangeStart( Field& field ) const {
+    FieldSet fieldset;
+    fieldset.add( field );
+    return haloExchangeStart( fieldset );
+}
+
+void NodeColumns::haloExchangeWait( parallel::HaloExchange::Handle& handle ) const {
+    halo_exchange().wait( handle );
+}
+
 const parallel::HaloExchange& NodeColumns::halo_exchange() const {
     if ( halo_exchange_ ) return *halo_exchange_;
     halo_exchange_ = NodeColumnsHaloExchangeCache::instance().get_or_create( mesh_, halo_.size() );
@@ -543,6 +574,16 @@ void NodeColumns::scatter( const Field& global, Field& local ) const {
     scatter( global_fields, local_fields );
 }
 
+void NodeColumns::gather( const Field& local, const FieldChunkCallback& callback, size_t levels_per_chunk,
+                          size_t root ) const {
+    gather_chunked( gather(), local, callback, levels_per_chunk, root );
+}
+
+void NodeColumns::scatter( const FieldChunkCallback& callback, Field& local, size_t levels_per_chunk,
+                           size_t root ) const {
+    scatter_chunked( scatter(), callback, local, levels_per_chunk, root );
+}
+
 namespace {
 template <typename T>
 std::string checksum_3d_field( const parallel::Checksum& checksum, const Field& field ) {
@@ -814,40 +855,91 @@ void sum_per_level( const NodeColumns& fs, const Field& field, Field& sum, size_
     }
 }
 
-template <typename DATATYPE>
-void dispatch_order_independent_sum_2d( const NodeColumns& fs, const Field& field, DATATYPE& result, size_t& N ) {
-    size_t root  = 0;
-    Field global = fs.createField( field, option::global() );
-    fs.gather( field, global );
-    result   = 0;
-    auto glb = array::make_view<DATATYPE, 1>( global );
-    for ( size_t jnode = 0; jnode < glb.size(); ++jnode ) {
-        result += glb( jnode );
+// Integer additions are exact, so integer sums do not depend on the order of summation.
+// Floating point values are accumulated exactly in fixed point with util::ExactSum, so that the
+// sums do not depend on the number of MPI tasks or threads either.
+template <typename T>
+using OrderIndependentAccumulator = typename std::conditional<std::is_integral<T>::value, long, util::ExactSum>::type;
+
+inline void accumulate( long& sum, long value ) {
+    sum += value;
+}
+
+inline void accumulate( util::ExactSum& sum, double value ) {
+    sum.add( value );
+}
+
+inline long accumulated( long sum ) {
+    return sum;
+}
+
+inline double accumulated( const util::ExactSum& sum ) {
+    return sum.value();
+}
+
+inline void allreduce( std::vector<long>& sums ) {
+    ATLAS_TRACE_MPI( ALLREDUCE ) { mpi::comm().allReduceInPlace( sums.data(), sums.size(), eckit::mpi::sum() ); }
+}
+
+inline void allreduce( std::vector<util::ExactSum>& sums ) {
+    const size_t nb_digits = util::ExactSum::size();
+    std::vector<long> digits( sums.size() * nb_digits );
+    std::vector<double> nonfinite( sums.size() );
+    for ( size_t s = 0; s < sums.size(); ++s ) {
+        sums[s].normalise();
+        std::copy( sums[s].data(), sums[s].data() + nb_digits, digits.data() + s * nb_digits );
+        nonfinite[s] = sums[s].nonfinite();
+    }
+    ATLAS_TRACE_MPI( ALLREDUCE ) {
+        mpi::comm().allReduceInPlace( digits.data(), digits.size(), eckit::mpi::sum() );
+        mpi::comm().allReduceInPlace( nonfinite.data(), nonfinite.size(), eckit::mpi::sum() );
+    }
+    for ( size_t s = 0; s < sums.size(); ++s ) {
+        sums[s].clear();
+        std::copy( digits.data() + s * nb_digits, digits.data() + ( s + 1 ) * nb_digits, sums[s].data() );
+        sums[s].normalise();
+        sums[s].add( nonfinite[s] );
     }
-    ATLAS_TRACE_MPI( BROADCAST ) { mpi::comm().broadcast( &result, 1, root ); }
-    N = fs.nb_nodes_global();
 }
 
-template <typename T>
-void dispatch_order_independent_sum( const NodeColumns& fs, const Field& field, T& result, size_t& N ) {
-    if ( field.levels() ) {
-        const array::LocalView<T, 2> arr = make_leveled_scalar_view<T>( field );
+/// Reproducible global sums over all owned nodes. Value (n,l,j) of the field contributes to
+/// the sum with index sum_index(l,j).
+template <typename T, typename SumIndex>
+std::vector<OrderIndependentAccumulator<T>> order_independent_sums( const NodeColumns& fs, const Field& field,
+                                                                    size_t nb_sums, const SumIndex& sum_index ) {
+    using Accumulator = OrderIndependentAccumulator<T>;
 
-        Field surface_field = fs.createField<T>( option::name( "surface" ) | option::levels( false ) );
-        auto surface        = array::make_view<T, 1>( surface_field );
+    const mesh::IsGhostNode is_ghost( fs.nodes() );
+    const array::LocalView<T, 3> arr = make_leveled_view<T>( field );
 
-        for ( size_t n = 0; n < arr.shape( 0 ); ++n ) {
-            surface( n ) = 0;
-            for ( size_t l = 0; l < arr.shape( 1 ); ++l ) {
-                surface( n ) += arr( n, l );
+    std::vector<Accumulator> sums( nb_sums, Accumulator() );
+    atlas_omp_parallel {
+        std::vector<Accumulator> sums_private( nb_sums, Accumulator() );
+        const size_t npts = arr.shape( 0 );
+        atlas_omp_for( size_t n = 0; n < npts; ++n ) {
+            if ( !is_ghost( n ) ) {
+                for ( size_t l = 0; l < arr.shape( 1 ); ++l ) {
+                    for ( size_t j = 0; j < arr.shape( 2 ); ++j ) {
+                        accumulate( sums_private[sum_index( l, j )], arr( n, l, j ) );
+                    }
+                }
+            }
+        }
+        atlas_omp_critical {
+            for ( size_t s = 0; s < nb_sums; ++s ) {
+                sums[s] += sums_private[s];
             }
         }
-        dispatch_order_independent_sum_2d( fs, surface_field, result, N );
-        N *= arr.shape( 1 );
-    }
-    else {
-        dispatch_order_independent_sum_2d( fs, field, result, N );
     }
+    allreduce( sums );
+    return sums;
+}
+
+template <typename T>
+void dispatch_order_independent_sum( const NodeColumns& fs, const Field& field, T& result, size_t& N ) {
+    auto sums = order_independent_sums<T>( fs, field, 1, []( size_t, size_t ) { return 0; } );
+    result    = T( accumulated( sums[0] ) );
+    N         = fs.nb_nodes_global() * std::max<size_t>( field.levels(), 1 );
 }
 
 template <typename T>
@@ -887,58 +979,15 @@ void order_independent_sum( const NodeColumns& fs, const Field& field, T& result
     }
 }
 
-template <typename DATATYPE>
-void dispatch_order_independent_sum_2d( const NodeColumns& fs, const Field& field, std::vector<DATATYPE>& result,
-                                        size_t& N ) {
-    size_t nvar = field.variables();
-    result.resize( nvar );
-    for ( size_t j = 0; j < nvar; ++j )
-        result[j] = 0.;
-    Field global = fs.createField( field, option::name( "global" ) | option::global() );
-    fs.gather( field, global );
-    if ( mpi::comm().rank() == 0 ) {
-        const auto glb = make_surface_view<DATATYPE>( global );
-        for ( size_t n = 0; n < fs.nb_nodes_global(); ++n ) {
-            for ( size_t j = 0; j < nvar; ++j ) {
-                result[j] += glb( n, j );
-            }
-        }
-    }
-    size_t root = global.metadata().get<size_t>( "owner" );
-    ATLAS_TRACE_MPI( BROADCAST ) { mpi::comm().broadcast( result, root ); }
-    N = fs.nb_nodes_global();
-}
-
 template <typename T>
 void dispatch_order_independent_sum( const NodeColumns& fs, const Field& field, std::vector<T>& result, size_t& N ) {
-    if ( field.levels() ) {
-        const size_t nvar = field.variables();
-        const auto arr    = make_leveled_view<T>( field );
-
-        Field surface_field =
-            fs.createField<T>( option::name( "surface" ) | option::variables( nvar ) | option::levels( false ) );
-        auto surface = make_surface_view<T>( surface_field );
-
-        atlas_omp_for( size_t n = 0; n < arr.shape( 0 ); ++n ) {
-            for ( size_t j = 0; j < arr.shape( 2 ); ++j ) {
-                surface( n, j ) = 0;
-            }
-        }
-
-        for ( size_t n = 0; n < arr.shape( 0 ); ++n ) {
-            for ( size_t l = 0; l < arr.shape( 1 ); ++l ) {
-                for ( size_t j = 0; j < arr.shape( 2 ); ++j ) {
-                    surface( n, j ) += arr( n, l, j );
-                }
-            }
-        }
-
-        dispatch_order_independent_sum_2d( fs, surface_field, result, N );
-        N *= arr.shape( 1 );
-    }
-    else {
-        dispatch_order_independent_sum_2d( fs, field, result, N );
+    const size_t nvar = std::max<size_t>( field.variables(), 1 );
+    auto sums         = order_independent_sums<T>( fs, field, nvar, []( size_t, size_t j ) { return j; } );
+    result.resize( nvar );
+    for ( size_t j = 0; j < nvar; ++j ) {
+        result[j] = T( accumulated( sums[j] ) );
     }
+    N = fs.nb_nodes_global() * std::max<size_t>( field.levels(), 1 );
 }
 
 template <typename T>
@@ -986,46 +1035,13 @@ void dispatch_order_independent_sum_per_level( const NodeColumns& fs, const Fiel
         shape.push_back( field.shape( j ) );
     sumfield.resize( shape );
 
-    auto sum = make_per_level_view<T>( sumfield );
+    auto sum          = make_per_level_view<T>( sumfield );
+    const size_t nvar = sum.shape( 1 );
+    auto sums         = order_independent_sums<T>( fs, field, sum.shape( 0 ) * nvar,
+                                           [nvar]( size_t l, size_t j ) { return l * nvar + j; } );
     for ( size_t l = 0; l < sum.shape( 0 ); ++l ) {
-        for ( size_t j = 0; j < sum.shape( 1 ); ++j ) {
-            sum( l, j ) = 0.;
-        }
-    }
-
-    size_t root  = 0;
-    Field global = fs.createField( field, option::name( "global" ) | option::global() );
-
-    fs.gather( field, global );
-    if ( mpi::comm().rank() == 0 ) {
-        const array::LocalView<T, 3> glb = make_leveled_view<T>( global );
-
-        for ( size_t n = 0; n < glb.shape( 0 ); ++n ) {
-            for ( size_t l = 0; l < glb.shape( 1 ); ++l ) {
-                for ( size_t j = 0; j < glb.shape( 2 ); ++j ) {
-                    sum( l, j ) += glb( n, l, j );
-                }
-            }
-        }
-    }
-    ATLAS_TRACE_MPI( BROADCAST ) {
-        std::vector<T> sum_array( sumfield.size() );
-        if ( mpi::comm().rank() == root ) {
-            size_t c( 0 );
-            for ( size_t l = 0; l < sum.shape( 0 ); ++l ) {
-                for ( size_t j = 0; j < sum.shape( 1 ); ++j ) {
-                    sum_array[c++] = sum( l, j );
-                }
-            }
-        }
-        mpi::comm().broadcast( sum_array, root );
-        if ( mpi::comm().rank() != root ) {
-            size_t c( 0 );
-            for ( size_t l = 0; l < sum.shape( 0 ); ++l ) {
-                for ( size_t j = 0; j < sum.shape( 1 ); ++j ) {
-                    sum( l, j ) = sum_array[c++];
-                }
-            }
+        for ( size_t j = 0; j < nvar; ++j ) {
+            sum( l, j ) = T( accumulated( sums[l * nvar + j] ) );
         }
     }
     N = fs.nb_nodes_global();
@@ -2122,6 +2138,18 @@ const parallel::HaloExchange& NodeColumns::halo_exchange() const {
     return functionspace_->halo_exchange();
 }
 
+parallel::HaloExchange::Handle NodeColumns::haloExchangeStart( FieldSet& fieldset ) const {
+    return functionspace_->haloExchangeStart( fieldset );
+}
+
+parallel::HaloExchange::Handle NodeColumns::haloExchangeStart( Field& field ) const {
+    return functionspace_->haloExchangeStart( field );
+}
+
+void NodeColumns::haloExchangeWait( parallel::HaloExchange::Handle& handle ) const {
+    functionspace_->haloExchangeWait( handle );
+}
+
 void NodeColumns::gather( const FieldSet& local, FieldSet& global ) const {
     functionspace_->gather( local, global );
 }
@@ -2142,6 +2170,16 @@ void NodeColumns::scatter( const Field& global, Field& local ) const {
     functionspace_->scatter( global, local );
 }
 
+void NodeColumns::gather( const Field& local, const FieldChunkCallback& callback, size_t levels_per_chunk,
+                          size_t root ) const {
+    functionspace_->gather( local, callback, levels_per_chunk, root );
+}
+
+void NodeColumns::scatter( const FieldChunkCallback& callback, Field& local, size_t levels_per_chunk,
+                           size_t root ) const {
+    functionspace_->scatter( callback, local, levels_per_chunk, root );
+}
+
 const parallel::GatherScatter& NodeColumns::scatter() const {
     return functionspace_->scatter();
 }
@@ -18,6 +18,7 @@
 #include "atlas/mesh/Halo.h"
 #include "atlas/mesh/Mesh.h"
 #include "atlas/option.h"
+#include "atlas/parallel/HaloExchange.h"
 
 // ----------------------------------------------------------------------------
 // Forward declarations
@@ -34,7 +35,6 @@ class FieldSet;
 
 namespace atlas {
 namespace parallel {
-class HaloExchange;
 class GatherScatter;
 class Checksum;
 }  // namespace parallel
@@ -84,6 +84,12 @@ public:
     void haloExchange( Field&, bool on_device = false ) const;
     const parallel::HaloExchange& halo_exchange() const;
 
+    /// @brief Start the halo exchange of fields in host memory, to be completed by haloExchangeWait().
+    ///        In between, owned values may be computed, but halo values must not be accessed.
+    parallel::HaloExchange::Handle haloExchangeStart( FieldSet& ) const;
+    parallel::HaloExchange::Handle haloExchangeStart( Field& ) const;
+    void haloExchangeWait( parallel::HaloExchange::Handle& ) const;
+
     void gather( const FieldSet&, FieldSet& ) const;
     void gather( const Field&, Field& ) const;
     const parallel::GatherScatter& gather() const;
@@ -92,6 +98,15 @@ public:
     void scatter( const Field&, Field& ) const;
     const parallel::GatherScatter& scatter() const;
 
+    /// @brief Gather a field to root in chunks of levels, overlapping the communication of the next
+    ///        chunk with the processing of the current one. On root, callback( chunk, begin, end ) is
+    ///        called for every chunk with a global field of levels [begin,end).
+    void gather( const Field& local, const FieldChunkCallback&, size_t levels_per_chunk, size_t root = 0 ) const;
+
+    /// @brief Scatter a field from root in chunks of levels. On root, callback( chunk, begin, end ) fills
+    ///        a global field of levels [begin,end) for every chunk.
+    void scatter( const FieldChunkCallback&, Field& local, size_t levels_per_chunk, size_t root = 0 ) const;
+
     std::string checksum( const FieldSet& ) const;
     std::string checksum( const Field& ) const;
     const parallel::Checksum& checksum() const;
@@ -472,6 +487,10 @@ public:
     void haloExchange( Field&, bool on_device = false ) const;
     const parallel::HaloExchange& halo_exchange() const;
 
+    parallel::HaloExchange::Handle haloExchangeStart( FieldSet& ) const;
+    parallel::HaloExchange::Handle haloExchangeStart( Field& ) const;
+    void haloExchangeWait( parallel::HaloExchange::Handle& ) const;
+
     void gather( const FieldSet&, FieldSet& ) const;
     void gather( const Field&, Field& ) const;
     const parallel::GatherScatter& gather() const;
@@ -479,6 +498,8 @@ public:
     void scatter( const FieldSet&, FieldSet& ) const;
     void scatter( const Field&, Field& ) const;
     const parallel::GatherScatter& scatter() const;
+    void gather( const Field& local, const FieldChunkCallback&, size_t levels_per_chunk, size_t root = 0 ) const;
+    void scatter( const FieldChunkCallback&, Field& local, size_t levels_per_chunk, size_t root = 0 ) const;
 
     std::string checksum( const FieldSet& ) const;
     std::string checksum( const Field& ) const;
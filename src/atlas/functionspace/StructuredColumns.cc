@@ -236,26 +236,38 @@ StructuredColumns::StructuredColumns( const Grid& grid, const grid::Partitioner&
     }
 
     grid::Distribution distribution;
-    ATLAS_TRACE_SCOPE( "Partitioning grid ..." ) { distribution = grid::Distribution( grid, partitioner ); }
+    ATLAS_TRACE_SCOPE( "Partitioning grid ..." ) {
+        distribution = grid::Distribution( grid, partitioner, util::Config( "compact", true ) );
+    }
     distribution_ = distribution.type();
 
     int mpi_rank = mpi::comm().rank();
 
+    std::vector<gidx_t> global_offsets( grid_.ny() + 1 );
+    global_offsets[0] = 0;
+    for ( size_t j = 0; j < grid_.ny(); ++j ) {
+        global_offsets[j + 1] = global_offsets[j] + grid_.nx( j );
+    }
+
+    // Visit only the runs of global indices owned by this task, split per latitude
     j_begin_ = std::numeric_limits<idx_t>::max();
     j_end_   = std::numeric_limits<idx_t>::min();
     i_begin_.resize( grid_.ny(), std::numeric_limits<idx_t>::max() );
     i_end_.resize( grid_.ny(), std::numeric_limits<idx_t>::min() );
-    size_t c( 0 );
     size_t owned( 0 );
-    for ( size_t j = 0; j < grid_.ny(); ++j ) {
-        for ( size_t i = 0; i < grid_.nx( j ); ++i, ++c ) {
-            if ( distribution.partition( c ) == mpi_rank ) {
-                j_begin_    = std::min<idx_t>( j_begin_, j );
-                j_end_      = std::max<idx_t>( j_end_, j + 1 );
-                i_begin_[j] = std::min<idx_t>( i_begin_[j], i );
-                i_end_[j]   = std::max<idx_t>( i_end_[j], i + 1 );
-                ++owned;
+    size_t jlat( 0 );
+    for ( const auto& run : distribution.runs( mpi_rank ) ) {
+        for ( gidx_t begin = run.first; begin < run.second; ) {
+            while ( global_offsets[jlat + 1] <= begin ) {
+                ++jlat;
             }
+            const gidx_t end = std::min( run.second, global_offsets[jlat + 1] );
+            j_begin_         = std::min<idx_t>( j_begin_, jlat );
+            j_end_           = std::max<idx_t>( j_end_, jlat + 1 );
+            i_begin_[jlat]   = std::min<idx_t>( i_begin_[jlat], begin - global_offsets[jlat] );
+            i_end_[jlat]     = std::max<idx_t>( i_end_[jlat], end - global_offsets[jlat] );
+            owned += end - begin;
+            begin = end;
         }
     }
 
@@ -320,12 +332,6 @@ StructuredColumns::StructuredColumns( const Grid& grid, const grid::Partitioner&
         return y;
     };
 
-    std::vector<gidx_t> global_offsets( grid_.ny() );
-    size_t grid_idx = 0;
-    for ( size_t j = 0; j < grid_.ny(); ++j ) {
-        global_offsets[j] = grid_idx;
-        grid_idx += grid_.nx( j );
-    }
 
     auto compute_g = [this, &global_offsets, &compute_i, &compute_j]( idx_t i, idx_t j ) -> gidx_t {
         idx_t ii, jj;
@@ -713,6 +719,20 @@ void StructuredColumns::scatter( const Field& global, Field& local ) const {
 }
 // ----------------------------------------------------------------------------
 
+// ----------------------------------------------------------------------------
+// Gather / Scatter Field in chunks of levels
+// ----------------------------------------------------------------------------
+void StructuredColumns::gather( const Field& local, const FieldChunkCallback& callback, size_t levels_per_chunk,
+                                size_t root ) const {
+    gather_chunked( *gather_scatter_, local, callback, levels_per_chunk, root );
+}
+
+void StructuredColumns::scatter( const FieldChunkCallback& callback, Field& local, size_t levels_per_chunk,
+                                 size_t root ) const {
+    scatter_chunked( *gather_scatter_, callback, local, levels_per_chunk, root );
+}
+// ----------------------------------------------------------------------------
+
 std::string StructuredColumns::checksum( const FieldSet& fieldset ) const {
     eckit::MD5 md5;
     for ( size_t f = 0; f < fieldset.size(); ++f ) {
@@ -820,6 +840,16 @@ void StructuredColumns::scatter( const Field& global, Field& local ) const {
     functionspace_->scatter( global, local );
 }
 
+void StructuredColumns::gather( const Field& local, const FieldChunkCallback& callback, size_t levels_per_chunk,
+                                size_t root ) const {
+    functionspace_->gather( local, callback, levels_per_chunk, root );
+}
+
+void StructuredColumns::scatter( const FieldChunkCallback& callback, Field& local, size_t levels_per_chunk,
+                                 size_t root ) const {
+    functionspace_->scatter( callback, local, levels_per_chunk, root );
+}
+
 void StructuredColumns::haloExchange( FieldSet& fields ) const {
     functionspace_->haloExchange( fields );
 }
@@ -65,6 +65,15 @@ public:
     void scatter( const FieldSet&, FieldSet& ) const;
     void scatter( const Field&, Field& ) const;
 
+    /// @brief Gather a field to root in chunks of levels, overlapping the communication of the next
+    ///        chunk with the processing of the current one. On root, callback( chunk, begin, end ) is
+    ///        called for every chunk with a global field of levels [begin,end).
+    void gather( const Field& local, const FieldChunkCallback&, size_t levels_per_chunk, size_t root = 0 ) const;
+
+    /// @brief Scatter a field from root in chunks of levels. On root, callback( chunk, begin, end ) fills
+    ///        a global field of levels [begin,end) for every chunk.
+    void scatter( const FieldChunkCallback&, Field& local, size_t levels_per_chunk, size_t root = 0 ) const;
+
     void haloExchange( FieldSet& ) const;
     void haloExchange( Field& ) const;
 
@@ -238,6 +247,8 @@ public:
 
     void scatter( const FieldSet&, FieldSet& ) const;
     void scatter( const Field&, Field& ) const;
+    void gather( const Field& local, const FieldChunkCallback&, size_t levels_per_chunk, size_t root = 0 ) const;
+    void scatter( const FieldChunkCallback&, Field& local, size_t levels_per_chunk, size_t root = 0 ) const;
 
     void haloExchange( FieldSet& ) const;
     void haloExchange( Field& ) const;
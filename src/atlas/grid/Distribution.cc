@@ -9,6 +9,10 @@
  */
 
 #include <algorithm>
+#include <set>
+
+#include "eckit/config/Parametrisation.h"
+#include "eckit/exception/Exceptions.h"
 
 #include "atlas/grid/Distribution.h"
 #include "atlas/grid/Grid.h"
@@ -29,6 +33,7 @@ std::string distribution_type( int N, const Partitioner& p = Partitioner() ) {
 
 Distribution::impl_t::impl_t( const Grid& grid ) :
     nb_partitions_( 1 ),
+    size_( grid.size() ),
     part_( grid.size(), 0 ),
     nb_pts_( nb_partitions_, grid.size() ),
     max_pts_( grid.size() ),
@@ -36,18 +41,29 @@ Distribution::impl_t::impl_t( const Grid& grid ) :
     type_( distribution_type( nb_partitions_ ) ) {}
 
 Distribution::impl_t::impl_t( const Grid& grid, const Partitioner& partitioner ) {
-    part_.resize( grid.size() );
+    size_ = grid.size();
+    part_.resize( size_ );
     partitioner.partition( grid, part_.data() );
     nb_partitions_ = partitioner.nb_partitions();
-    nb_pts_.resize( nb_partitions_, 0 );
-    for ( size_t j = 0; j < part_.size(); ++j )
-        ++nb_pts_[part_[j]];
-    max_pts_ = *std::max_element( nb_pts_.begin(), nb_pts_.end() );
-    min_pts_ = *std::min_element( nb_pts_.begin(), nb_pts_.end() );
-    type_    = distribution_type( nb_partitions_, partitioner );
+    setup_nb_pts();
+    type_ = distribution_type( nb_partitions_, partitioner );
+}
+
+Distribution::impl_t::impl_t( const Grid& grid, const Partitioner& partitioner, const eckit::Parametrisation& config ) {
+    size_ = grid.size();
+    config.get( "compact", compact_ );
+    if ( compact_ ) { partitioner.partition_runs( grid, run_begin_, run_part_ ); }
+    else {
+        part_.resize( size_ );
+        partitioner.partition( grid, part_.data() );
+    }
+    nb_partitions_ = partitioner.nb_partitions();
+    setup_nb_pts();
+    type_ = distribution_type( nb_partitions_, partitioner );
 }
 
 Distribution::impl_t::impl_t( size_t npts, int part[], int part0 ) {
+    size_ = npts;
     part_.assign( part, part + npts );
     std::set<int> partset( part_.begin(), part_.end() );
     nb_partitions_ = partset.size();
@@ -61,12 +77,70 @@ Distribution::impl_t::impl_t( size_t npts, int part[], int part0 ) {
     type_    = distribution_type( nb_partitions_ );
 }
 
+void Distribution::impl_t::setup_nb_pts() {
+    nb_pts_.assign( nb_partitions_, 0 );
+    if ( compact_ ) {
+        for ( size_t r = 0; r < run_begin_.size(); ++r ) {
+            nb_pts_[run_part_[r]] += run_end( r ) - run_begin_[r];
+        }
+    }
+    else {
+        for ( size_t j = 0; j < part_.size(); ++j )
+            ++nb_pts_[part_[j]];
+    }
+    max_pts_ = *std::max_element( nb_pts_.begin(), nb_pts_.end() );
+    min_pts_ = *std::min_element( nb_pts_.begin(), nb_pts_.end() );
+}
+
+const std::vector<int>& Distribution::impl_t::partition() const {
+    if ( compact_ && part_.size() != size_ ) {
+        part_.resize( size_ );
+        for ( size_t r = 0; r < run_begin_.size(); ++r ) {
+            std::fill( part_.begin() + run_begin_[r], part_.begin() + run_end( r ), run_part_[r] );
+        }
+    }
+    return part_;
+}
+
+void Distribution::impl_t::partition( gidx_t begin, gidx_t end, int part[] ) const {
+    ASSERT( 0 <= begin && begin <= end && size_t( end ) <= size_ );
+    if ( not compact_ ) {
+        std::copy( part_.begin() + begin, part_.begin() + end, part );
+        return;
+    }
+    size_t r = std::upper_bound( run_begin_.begin(), run_begin_.end(), begin ) - run_begin_.begin() - 1;
+    for ( gidx_t n = begin; n < end; ++r ) {
+        const gidx_t next = std::min( run_end( r ), end );
+        std::fill( part + ( n - begin ), part + ( next - begin ), run_part_[r] );
+        n = next;
+    }
+}
+
+std::vector<std::pair<gidx_t, gidx_t>> Distribution::impl_t::runs( int partition ) const {
+    std::vector<std::pair<gidx_t, gidx_t>> ranges;
+    if ( compact_ ) {
+        for ( size_t r = 0; r < run_begin_.size(); ++r ) {
+            if ( run_part_[r] == partition ) { ranges.emplace_back( run_begin_[r], run_end( r ) ); }
+        }
+    }
+    else {
+        for ( size_t j = 0; j < part_.size(); ++j ) {
+            if ( part_[j] != partition ) { continue; }
+            if ( ranges.empty() || ranges.back().second != gidx_t( j ) ) { ranges.emplace_back( j, j + 1 ); }
+            else {
+                ++ranges.back().second;
+            }
+        }
+    }
+    return ranges;
+}
+
 void Distribution::impl_t::print( std::ostream& s ) const {
     s << "Distribution( "
-      << "type: " << type_ << ", nbPoints: " << part_.size() << ", nbPartitions: " << nb_pts_.size() << ", parts : [";
-    for ( size_t i = 0; i < part_.size(); i++ ) {
+      << "type: " << type_ << ", nbPoints: " << size_ << ", nbPartitions: " << nb_pts_.size() << ", parts : [";
+    for ( size_t i = 0; i < size_; i++ ) {
         if ( i != 0 ) s << ',';
-        s << part_[i];
+        s << partition( i );
     }
     s << ']';
 }
@@ -82,6 +156,9 @@ Distribution::Distribution( const Grid& grid ) : impl_( new impl_t( grid ) ) {}
 Distribution::Distribution( const Grid& grid, const Partitioner& partitioner ) :
     impl_( new impl_t( grid, partitioner ) ) {}
 
+Distribution::Distribution( const Grid& grid, const Partitioner& partitioner, const eckit::Parametrisation& config ) :
+    impl_( new impl_t( grid, partitioner, config ) ) {}
+
 Distribution::Distribution( size_t npts, int part[], int part0 ) : impl_( new impl_t( npts, part, part0 ) ) {}
 
 Distribution::impl_t* atlas__GridDistribution__new( int npts, int part[], int part0 ) {
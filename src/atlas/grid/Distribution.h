@@ -10,6 +10,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "eckit/memory/Owned.h"
@@ -17,6 +20,9 @@
 
 #include "atlas/library/config.h"
 
+namespace eckit {
+class Parametrisation;
+}
 namespace atlas {
 class Grid;
 namespace grid {
@@ -37,19 +43,43 @@ public:
 
         impl_t( const Grid&, const Partitioner& );
 
+        /// With config "compact" = true, partitions are stored as runs of consecutive
+        /// global indices instead of one int per grid point.
+        impl_t( const Grid&, const Partitioner&, const eckit::Parametrisation& );
+
         impl_t( size_t npts, int partition[], int part0 = 0 );
 
         virtual ~impl_t() {}
 
-        int partition( const gidx_t gidx ) const { return part_[gidx]; }
+        int partition( const gidx_t gidx ) const {
+            if ( not compact_ ) return part_[gidx];
+            return run_part_[std::upper_bound( run_begin_.begin(), run_begin_.end(), gidx ) - run_begin_.begin() - 1];
+        }
+
+        /// Partition of every grid point. For a compact distribution this expands
+        /// the runs on first use, which defeats its purpose and is not thread-safe.
+        const std::vector<int>& partition() const;
+
+        /// Partitions of the grid points with global indices [begin,end)
+        void partition( gidx_t begin, gidx_t end, int part[] ) const;
 
-        const std::vector<int>& partition() const { return part_; }
+        /// Ranges [first,second) of consecutive global indices of given partition, in increasing order.
+        /// For a compact distribution this is O( nb_runs ), without visiting every grid point.
+        std::vector<std::pair<gidx_t, gidx_t>> runs( int partition ) const;
 
         size_t nb_partitions() const { return nb_partitions_; }
 
-        operator const std::vector<int>&() const { return part_; }
+        operator const std::vector<int>&() const { return partition(); }
 
-        const int* data() const { return part_.data(); }
+        const int* data() const { return partition().data(); }
+
+        /// Number of grid points
+        size_t size() const { return size_; }
+
+        bool compact() const { return compact_; }
+
+        /// Number of runs of consecutive global indices with same partition (compact only)
+        size_t nb_runs() const { return run_begin_.size(); }
 
         const std::vector<int>& nb_pts() const { return nb_pts_; }
 
@@ -60,9 +90,18 @@ public:
 
         void print( std::ostream& ) const;
 
+    private:
+        void setup_nb_pts();
+
+        gidx_t run_end( size_t r ) const { return r + 1 < run_begin_.size() ? run_begin_[r + 1] : gidx_t( size_ ); }
+
     private:
         size_t nb_partitions_;
-        std::vector<int> part_;
+        size_t size_;
+        bool compact_{false};
+        mutable std::vector<int> part_;
+        std::vector<gidx_t> run_begin_;
+        std::vector<int> run_part_;
         std::vector<int> nb_pts_;
         size_t max_pts_;
         size_t min_pts_;
@@ -78,6 +117,8 @@ public:
 
     Distribution( const Grid&, const Partitioner& );
 
+    Distribution( const Grid&, const Partitioner&, const eckit::Parametrisation& );
+
     Distribution( size_t npts, int partition[], int part0 = 0 );
 
     ~Distribution() {}
@@ -86,12 +127,20 @@ public:
 
     const std::vector<int>& partition() const { return impl_->partition(); }
 
+    void partition( gidx_t begin, gidx_t end, int part[] ) const { impl_->partition( begin, end, part ); }
+
+    std::vector<std::pair<gidx_t, gidx_t>> runs( int partition ) const { return impl_->runs( partition ); }
+
     size_t nb_partitions() const { return impl_->nb_partitions(); }
 
     operator const std::vector<int>&() const { return *impl_; }
 
     const int* data() const { return impl_->data(); }
 
+    size_t size() const { return impl_->size(); }
+
+    bool compact() const { return impl_->compact(); }
+
     const std::vector<int>& nb_pts() const { return impl_->nb_pts(); }
 
     size_t max_pts() const { return impl_->max_pts(); }
@@ -99,6 +99,18 @@ public:
 
     Spec spec() const { return grid_->spec(); }
 
+    /// Fill xy[2*size()] with the coordinates of all grid points
+    void fill_xy( double xy[] ) const { grid_->fill_xy( 0, size(), xy ); }
+
+    /// Fill xy[2*(end-begin)] with the coordinates of grid points with global index in [begin,end)
+    void fill_xy( gidx_t begin, gidx_t end, double xy[] ) const { grid_->fill_xy( begin, end, xy ); }
+
+    /// Fill lonlat[2*size()] with the geographic coordinates of all grid points
+    void fill_lonlat( double lonlat[] ) const { grid_->fill_lonlat( 0, size(), lonlat ); }
+
+    /// Fill lonlat[2*(end-begin)] with the geographic coordinates of grid points with global index in [begin,end)
+    void fill_lonlat( gidx_t begin, gidx_t end, double lonlat[] ) const { grid_->fill_lonlat( begin, end, lonlat ); }
+
     const Implementation* get() const { return grid_.get(); }
 
 private:
@@ -214,6 +226,14 @@ public:
 
     PointLonLat lonlat( size_t i, size_t j ) const { return grid_->lonlat( i, j ); }
 
+    /// Fill xy[] with the coordinates of all points on rows [j_begin,j_end)
+    void fill_xy_rows( size_t j_begin, size_t j_end, double xy[] ) const { grid_->fill_xy_rows( j_begin, j_end, xy ); }
+
+    /// Fill lonlat[] with the geographic coordinates of all points on rows [j_begin,j_end)
+    void fill_lonlat_rows( size_t j_begin, size_t j_end, double lonlat[] ) const {
+        grid_->fill_lonlat_rows( j_begin, j_end, lonlat );
+    }
+
     inline bool reduced() const { return grid_->reduced(); }
 
     inline bool regular() const { return not reduced(); }
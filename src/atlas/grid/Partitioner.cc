@@ -47,6 +47,11 @@ void Partitioner::partition( const Grid& grid, int part[] ) const {
     partitioner_->partition( grid, part );
 }
 
+void Partitioner::partition_runs( const Grid& grid, std::vector<gidx_t>& run_begin, std::vector<int>& run_part ) const {
+    ATLAS_TRACE();
+    partitioner_->partition_runs( grid, run_begin, run_part );
+}
+
 MatchingMeshPartitioner::MatchingMeshPartitioner() : Partitioner() {}
 
 grid::detail::partitioner::Partitioner* matching_mesh_partititioner( const Mesh& mesh,
@@ -40,6 +40,9 @@ public:
 
     void partition( const Grid& grid, int part[] ) const;
 
+    /// Partition of consecutive global indices [run_begin[r],run_begin[r+1]) is run_part[r]
+    void partition_runs( const Grid& grid, std::vector<gidx_t>& run_begin, std::vector<int>& run_part ) const;
+
     Distribution partition( const Grid& grid ) const { return Distribution( grid, *this ); }
 
     size_t nb_partitions() const { return partitioner_->nb_partitions(); }
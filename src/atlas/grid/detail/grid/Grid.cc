@@ -10,6 +10,8 @@
 
 #include "Grid.h"
 
+#include <algorithm>
+#include <memory>
 #include <vector>
 
 #include "eckit/memory/Factory.h"
@@ -18,6 +20,7 @@
 #include "atlas/grid.h"
 #include "atlas/grid/detail/grid/GridBuilder.h"
 #include "atlas/mesh/Mesh.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Log.h"
 
 namespace atlas {
@@ -96,6 +99,33 @@ std::string Grid::hash() const {
     return hash_;
 }
 
+void Grid::fill_xy( gidx_t begin, gidx_t end, double xy[] ) const {
+    ASSERT( 0 <= begin && begin <= end && end <= gidx_t( size() ) );
+    std::unique_ptr<IteratorXY> it( xy_begin() );
+    PointXY point;
+    for ( gidx_t n = 0; n < end && it->next( point ); ++n ) {
+        if ( n >= begin ) {
+            xy[2 * ( n - begin ) + 0] = point.x();
+            xy[2 * ( n - begin ) + 1] = point.y();
+        }
+    }
+}
+
+void Grid::fill_lonlat( gidx_t begin, gidx_t end, double lonlat[] ) const {
+    fill_xy( begin, end, lonlat );
+    if ( projection_ ) {
+        // Convert in place, in batches of points so that the projection is dispatched once per batch
+        const gidx_t chunk     = 4096;
+        const gidx_t nb_chunks = ( end - begin + chunk - 1 ) / chunk;
+        atlas_omp_parallel_for( gidx_t c = 0; c < nb_chunks; ++c ) {
+            const gidx_t n_begin = c * chunk;
+            const gidx_t n_end   = std::min( n_begin + chunk, end - begin );
+            double* crd          = lonlat + 2 * n_begin;
+            projection_.xy2lonlat( n_end - n_begin, crd, crd );
+        }
+    }
+}
+
 }  // namespace grid
 }  // namespace detail
 }  // namespace grid
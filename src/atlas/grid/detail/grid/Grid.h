@@ -17,6 +17,7 @@
 #include "eckit/memory/Owned.h"
 
 #include "atlas/domain/Domain.h"
+#include "atlas/library/config.h"
 #include "atlas/projection/Projection.h"
 #include "atlas/util/Config.h"
 #include "atlas/util/Point.h"
@@ -107,6 +108,15 @@ public:  // methods
     virtual IteratorLonLat* lonlat_begin() const                  = 0;
     virtual IteratorLonLat* lonlat_end() const                    = 0;
 
+    /// @brief Fill xy[] with the coordinates of the points with global index in [begin,end)
+    /// xy must hold 2*(end-begin) values, ordered (x,y) per point.
+    /// The default implementation walks the xy iterator; derived classes provide direct access.
+    virtual void fill_xy( gidx_t begin, gidx_t end, double xy[] ) const;
+
+    /// @brief Fill lonlat[] with the geographic coordinates of the points with global index in [begin,end)
+    /// lonlat must hold 2*(end-begin) values, ordered (lon,lat) per point.
+    void fill_lonlat( gidx_t begin, gidx_t end, double lonlat[] ) const;
+
 protected:  // methods
     /// Fill provided me
     virtual void print( std::ostream& ) const = 0;
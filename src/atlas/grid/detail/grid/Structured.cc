@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <numeric>
 
 #include "eckit/types/FloatCompare.h"
 
@@ -20,6 +21,7 @@
 #include "atlas/grid/detail/grid/GridBuilder.h"
 #include "atlas/grid/detail/spacing/CustomSpacing.h"
 #include "atlas/grid/detail/spacing/LinearSpacing.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/ErrorHandling.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/util/Earth.h"
@@ -446,6 +448,53 @@ void Structured::computeTruePeriodicity() {
     }
 }
 
+void Structured::fill_xy( gidx_t begin, gidx_t end, double xy[] ) const {
+    ASSERT( 0 <= begin && begin <= end && end <= gidx_t( npts_ ) );
+
+    // Global index of first point of each row, so that any chunk can find its starting row
+    std::vector<gidx_t> offset( ny() + 1 );
+    offset[0] = 0;
+    for ( size_t j = 0; j < ny(); ++j ) {
+        offset[j + 1] = offset[j] + nx_[j];
+    }
+
+    // Fixed-size chunks rather than rows, to balance threads for few long rows as well as many short ones
+    const gidx_t chunk     = 16384;
+    const gidx_t nb_chunks = ( end - begin + chunk - 1 ) / chunk;
+    atlas_omp_parallel_for( gidx_t c = 0; c < nb_chunks; ++c ) {
+        const gidx_t n_begin = begin + c * chunk;
+        const gidx_t n_end   = std::min( n_begin + chunk, end );
+        size_t j             = std::upper_bound( offset.begin(), offset.end(), n_begin ) - offset.begin() - 1;
+        double* crd          = xy + 2 * ( n_begin - begin );
+        for ( gidx_t n = n_begin; n < n_end; ++j ) {
+            const gidx_t i_begin = n - offset[j];
+            const gidx_t i_end   = std::min( offset[j + 1], n_end ) - offset[j];
+            const double xmin    = xmin_[j];
+            const double dx      = dx_[j];
+            const double y       = y_[j];
+            for ( gidx_t i = i_begin; i < i_end; ++i ) {
+                *crd++ = xmin + static_cast<double>( i ) * dx;
+                *crd++ = y;
+            }
+            n += i_end - i_begin;
+        }
+    }
+}
+
+void Structured::fill_xy_rows( size_t j_begin, size_t j_end, double xy[] ) const {
+    ASSERT( j_begin <= j_end && j_end <= ny() );
+    const gidx_t begin = std::accumulate( nx_.begin(), nx_.begin() + j_begin, gidx_t( 0 ) );
+    const gidx_t end   = std::accumulate( nx_.begin() + j_begin, nx_.begin() + j_end, begin );
+    fill_xy( begin, end, xy );
+}
+
+void Structured::fill_lonlat_rows( size_t j_begin, size_t j_end, double lonlat[] ) const {
+    ASSERT( j_begin <= j_end && j_end <= ny() );
+    const gidx_t begin = std::accumulate( nx_.begin(), nx_.begin() + j_begin, gidx_t( 0 ) );
+    const gidx_t end   = std::accumulate( nx_.begin() + j_begin, nx_.begin() + j_end, begin );
+    fill_lonlat( begin, end, lonlat );
+}
+
 void Structured::print( std::ostream& os ) const {
     os << "Structured(Name:" << name() << ")";
 }
@@ -335,6 +335,15 @@ public:
         projection_.xy2lonlat( crd );
     }
 
+    /// Fill xy[] with coordinates of points in [begin,end), computed row by row without iterators
+    virtual void fill_xy( gidx_t begin, gidx_t end, double xy[] ) const;
+
+    /// Fill xy[] with coordinates of all points on rows [j_begin,j_end)
+    void fill_xy_rows( size_t j_begin, size_t j_end, double xy[] ) const;
+
+    /// Fill lonlat[] with geographic coordinates of all points on rows [j_begin,j_end)
+    void fill_lonlat_rows( size_t j_begin, size_t j_end, double lonlat[] ) const;
+
     inline bool reduced() const { return nxmax() != nxmin(); }
 
     bool periodic() const { return periodic_x_; }
@@ -10,6 +10,7 @@
 
 #include "atlas/grid/detail/grid/Unstructured.h"
 
+#include <algorithm>
 #include <limits>
 
 #include "eckit/memory/Builder.h"
@@ -101,6 +102,14 @@ size_t Unstructured::size() const {
     return points_->size();
 }
 
+void Unstructured::fill_xy( gidx_t begin, gidx_t end, double xy[] ) const {
+    ASSERT( points_ );
+    ASSERT( 0 <= begin && begin <= end && end <= gidx_t( points_->size() ) );
+    // PointXY is laid out as 2 doubles, see Grid::checkSizeOfPoint()
+    const double* data = points_->data()->data();
+    std::copy( data + 2 * begin, data + 2 * end, xy );
+}
+
 Grid::Spec Unstructured::spec() const {
     if ( cached_spec_ ) return *cached_spec_;
 
@@ -182,6 +182,8 @@ public:  // methods
 
     PointLonLat lonlat( size_t n ) const { return projection_.lonlat( ( *points_ )[n] ); }
 
+    virtual void fill_xy( gidx_t begin, gidx_t end, double xy[] ) const;
+
     virtual IteratorXY* xy_begin() const { return new IteratorXY( *this ); }
     virtual IteratorXY* xy_end() const { return new IteratorXY( *this, false ); }
     virtual IteratorLonLat* lonlat_begin() const { return new IteratorLonLat( *this ); }
@@ -15,6 +15,7 @@
 #include <ctime>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <vector>
 
 #include "atlas/grid/Grid.h"
@@ -526,6 +527,290 @@ void EqualRegionsPartitioner::partition( int nb_nodes, NodeInt nodes[], int part
     // ((double)CLOCKS_PER_SEC) << "s)" << std::endl;
 }
 
+namespace {
+
+// Rows of a StructuredGrid overlapping the range [begin,end) of global indices
+// covered by a band. Within a band the points are ordered as by compare_WE_NS,
+// i.e. west to east, and north to south for equal x. As every row is sorted
+// west to east, the first k points of the band form a prefix of each row, which
+// is found by bisection on x (in microdegrees, as in NodeInt).
+class StructuredBand {
+public:
+    StructuredBand( const StructuredGrid& grid, gidx_t begin, gidx_t end ) : grid_( grid ) {
+        gidx_t offset = 0;
+        for ( idx_t j = 0; j < idx_t( grid.ny() ) && offset < end; ++j ) {
+            gidx_t nx = grid.nx( j );
+            if ( nx > 0 && offset + nx > begin ) {
+                j_.push_back( j );
+                offset_.push_back( offset );
+                begin_.push_back( std::max<gidx_t>( begin - offset, 0 ) );
+                end_.push_back( std::min<gidx_t>( end - offset, nx ) );
+            }
+            offset += nx;
+        }
+    }
+
+    size_t nb_rows() const { return j_.size(); }
+
+    idx_t j( size_t r ) const { return j_[r]; }
+
+    idx_t begin( size_t r ) const { return begin_[r]; }
+
+    // Global index of point ( 0, j(r) )
+    gidx_t offset( size_t r ) const { return offset_[r]; }
+
+    // n[r] = number of points of row r among the first k points of the band
+    void first( gidx_t k, std::vector<idx_t>& n ) const {
+        n.assign( nb_rows(), 0 );
+        if ( k == 0 ) return;
+
+        // Smallest X such that at least k points have x <= X
+        long lo = std::numeric_limits<int>::max();
+        long hi = std::numeric_limits<int>::min();
+        for ( size_t r = 0; r < nb_rows(); ++r ) {
+            lo = std::min<long>( lo, x( r, begin_[r] ) );
+            hi = std::max<long>( hi, x( r, end_[r] - 1 ) );
+        }
+        while ( lo < hi ) {
+            long mid = lo + ( hi - lo ) / 2;
+            if ( count_less( mid + 1 ) >= k )
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+        const long X = lo;
+
+        // All points with x < X come first, then the ones with x == X from north to south
+        gidx_t c = 0;
+        for ( size_t r = 0; r < nb_rows(); ++r ) {
+            n[r] = count_less( r, X );
+            c += n[r];
+        }
+        for ( size_t r = 0; r < nb_rows() && c < k; ++r ) {
+            if ( contains( r, X ) ) {
+                ++n[r];
+                ++c;
+            }
+        }
+        ASSERT( c == k );
+    }
+
+    // Position of point ( i, j ) within the band
+    gidx_t rank( idx_t i, idx_t j ) const {
+        const long X = microdeg( grid_.x( i, j ) );
+        gidx_t rank  = 0;
+        for ( size_t r = 0; r < nb_rows(); ++r ) {
+            rank += count_less( r, X );
+            if ( j_[r] < j && contains( r, X ) ) ++rank;
+        }
+        return rank;
+    }
+
+private:
+    long x( size_t r, idx_t i ) const { return microdeg( grid_.x( i, j_[r] ) ); }
+
+    // Number of points of row r with x < X
+    idx_t count_less( size_t r, long X ) const {
+        idx_t lo = begin_[r];
+        idx_t hi = end_[r];
+        while ( lo < hi ) {
+            idx_t mid = lo + ( hi - lo ) / 2;
+            if ( x( r, mid ) < X )
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo - begin_[r];
+    }
+
+    // Number of points of the band with x < X
+    gidx_t count_less( long X ) const {
+        gidx_t c = 0;
+        for ( size_t r = 0; r < nb_rows(); ++r ) {
+            c += count_less( r, X );
+        }
+        return c;
+    }
+
+    bool contains( size_t r, long X ) const {
+        idx_t i = begin_[r] + count_less( r, X );
+        return i < end_[r] && x( r, i ) == X;
+    }
+
+private:
+    const StructuredGrid& grid_;
+    std::vector<idx_t> j_;
+    std::vector<gidx_t> offset_;
+    std::vector<idx_t> begin_;
+    std::vector<idx_t> end_;
+};
+
+// Calls f( begin, end, p ) for every latitude interval [begin,end) of global
+// indices that belongs to partition p, band by band
+template <typename Function>
+void for_each_interval( const StructuredGrid& grid, const std::vector<int>& sectors, const std::vector<gidx_t>& count,
+                        const std::vector<gidx_t>& displs, const Function& f ) {
+    std::vector<idx_t> n_begin, n_end;
+    int p0 = 0;
+    for ( size_t b = 0; b < sectors.size(); ++b ) {
+        const int p1 = p0 + sectors[b];
+
+        const gidx_t band_begin = displs[p0];
+        StructuredBand band( grid, band_begin, displs[p1 - 1] + count[p1 - 1] );
+
+        band.first( 0, n_begin );
+        for ( int p = p0; p < p1; ++p ) {
+            band.first( displs[p] + count[p] - band_begin, n_end );
+            for ( size_t r = 0; r < band.nb_rows(); ++r ) {
+                if ( n_end[r] > n_begin[r] ) {
+                    const gidx_t offset = band.offset( r ) + band.begin( r );
+                    f( offset + n_begin[r], offset + n_end[r], p );
+                }
+            }
+            std::swap( n_begin, n_end );
+        }
+        p0 = p1;
+    }
+}
+
+}  // namespace
+
+void EqualRegionsPartitioner::chunks( gidx_t nb_nodes, std::vector<gidx_t>& count, std::vector<gidx_t>& displs ) const {
+    gidx_t chunk_size      = nb_nodes / N_;
+    gidx_t chunk_remainder = nb_nodes - chunk_size * N_;
+    count.resize( N_ );
+    displs.resize( N_ );
+    gidx_t end = 0;
+    for ( int p = 0; p < N_; ++p ) {
+        displs[p] = end;
+        count[p]  = chunk_size + ( p < chunk_remainder ? 1 : 0 );
+        end += count[p];
+    }
+}
+
+void EqualRegionsPartitioner::intervals( const StructuredGrid& grid, int partition,
+                                         std::vector<Interval>& intervals ) const {
+    ASSERT( partition >= 0 && partition < N_ );
+
+    std::vector<gidx_t> count, displs;
+    chunks( grid.size(), count, displs );
+
+    int b, s;
+    where( partition, b, s );
+    const int p0 = partition - s;
+    const int p1 = p0 + sectors_[b];
+
+    const gidx_t band_begin = displs[p0];
+    StructuredBand band( grid, band_begin, displs[p1 - 1] + count[p1 - 1] );
+
+    std::vector<idx_t> n_begin, n_end;
+    band.first( displs[partition] - band_begin, n_begin );
+    band.first( displs[partition] + count[partition] - band_begin, n_end );
+
+    intervals.clear();
+    for ( size_t r = 0; r < band.nb_rows(); ++r ) {
+        if ( n_end[r] > n_begin[r] ) {
+            intervals.push_back( Interval{band.j( r ), band.begin( r ) + n_begin[r], band.begin( r ) + n_end[r]} );
+        }
+    }
+}
+
+void EqualRegionsPartitioner::points( const StructuredGrid& grid, int partition, std::vector<gidx_t>& points ) const {
+    std::vector<Interval> list;
+    intervals( grid, partition, list );
+
+    points.clear();
+    gidx_t offset = 0;
+    idx_t j       = 0;
+    for ( const Interval& interval : list ) {
+        for ( ; j < interval.j; ++j ) {
+            offset += grid.nx( j );
+        }
+        for ( idx_t i = interval.begin; i < interval.end; ++i ) {
+            points.push_back( offset + i );
+        }
+    }
+}
+
+int EqualRegionsPartitioner::partition( const StructuredGrid& grid, gidx_t gidx ) const {
+    ASSERT( gidx >= 0 && size_t( gidx ) < grid.size() );
+    if ( N_ == 1 ) return 0;
+
+    std::vector<gidx_t> count, displs;
+    chunks( grid.size(), count, displs );
+
+    // Band is determined by the north to south order alone
+    int b, s;
+    where( std::upper_bound( displs.begin(), displs.end(), gidx ) - displs.begin() - 1, b, s );
+    int p0 = 0;
+    for ( int n = 0; n < b; ++n )
+        p0 += sectors_[n];
+    const int p1 = p0 + sectors_[b];
+
+    const gidx_t band_begin = displs[p0];
+    StructuredBand band( grid, band_begin, displs[p1 - 1] + count[p1 - 1] );
+
+    idx_t i = gidx;
+    idx_t j = 0;
+    for ( ; i >= idx_t( grid.nx( j ) ); ++j ) {
+        i -= grid.nx( j );
+    }
+
+    const gidx_t position = band_begin + band.rank( i, j );
+    return std::upper_bound( displs.begin() + p0, displs.begin() + p1, position ) - displs.begin() - 1;
+}
+
+void EqualRegionsPartitioner::partition_structured( const StructuredGrid& grid, int part[] ) const {
+    ATLAS_TRACE( "EqualRegionsPartitioner::partition (structured)" );
+
+    std::vector<gidx_t> count, displs;
+    chunks( grid.size(), count, displs );
+
+    for_each_interval( grid, sectors_, count, displs, [part]( gidx_t begin, gidx_t end, int p ) {
+        for ( gidx_t n = begin; n < end; ++n ) {
+            part[n] = p;
+        }
+    } );
+}
+
+void EqualRegionsPartitioner::partition_runs( const Grid& grid, std::vector<gidx_t>& run_begin,
+                                              std::vector<int>& run_part ) const {
+    if ( N_ == 1 ) {  // trivial solution, one run
+        run_begin.assign( 1, 0 );
+        run_part.assign( 1, 0 );
+        return;
+    }
+    StructuredGrid structured_grid( grid );
+    if ( not structured_grid ) {
+        // Unstructured grids are partitioned by sorting all points
+        Partitioner::partition_runs( grid, run_begin, run_part );
+        return;
+    }
+
+    ATLAS_TRACE( "EqualRegionsPartitioner::partition_runs (structured)" );
+
+    ASSERT( grid.projection().units() == "degrees" );
+    ASSERT( structured_grid.y( 1 ) < structured_grid.y( 0 ) );
+    ASSERT( structured_grid.x( 1, 0 ) > structured_grid.x( 0, 0 ) );
+
+    std::vector<gidx_t> count, displs;
+    chunks( grid.size(), count, displs );
+
+    std::vector<std::pair<gidx_t, int>> runs;
+    for_each_interval( structured_grid, sectors_, count, displs,
+                       [&runs]( gidx_t begin, gidx_t, int p ) { runs.push_back( std::make_pair( begin, p ) ); } );
+    std::sort( runs.begin(), runs.end() );
+
+    run_begin.clear();
+    run_part.clear();
+    for ( const auto& run : runs ) {
+        if ( run_part.empty() || run.second != run_part.back() ) {
+            run_begin.push_back( run.first );
+            run_part.push_back( run.second );
+        }
+    }
+}
+
 void EqualRegionsPartitioner::partition( const Grid& grid, int part[] ) const {
     if ( N_ == 1 ) {  // trivial solution, so much faster
         for ( size_t j = 0; j < grid.size(); ++j )
@@ -536,6 +821,19 @@ void EqualRegionsPartitioner::partition( const Grid& grid, int part[] ) const {
 
         ASSERT( grid.projection().units() == "degrees" );
 
+        if ( StructuredGrid( grid ) ) {
+            // The grid comes sorted from north to south and west to east by
+            // construction, so that band and sector boundaries can be computed
+            // per latitude, without sorting nor communication.
+            // Assert to make sure.
+            StructuredGrid structured_grid( grid );
+            ASSERT( structured_grid.y( 1 ) < structured_grid.y( 0 ) );
+            ASSERT( structured_grid.x( 1, 0 ) > structured_grid.x( 0, 0 ) );
+
+            partition_structured( structured_grid, part );
+            return;
+        }
+
         const auto& comm = mpi::comm();
         int mpi_rank     = comm.rank();
         int mpi_size     = comm.size();
@@ -551,26 +849,7 @@ void EqualRegionsPartitioner::partition( const Grid& grid, int part[] ) const {
     already by construction in this order, but then sorting is really fast
     */
 
-        if ( StructuredGrid( grid ) ) {
-            // The grid comes sorted from north to south and west to east by
-            // construction
-            // Assert to make sure.
-            StructuredGrid structured_grid( grid );
-            ASSERT( structured_grid.y( 1 ) < structured_grid.y( 0 ) );
-            ASSERT( structured_grid.x( 1, 0 ) > structured_grid.x( 0, 0 ) );
-
-            ATLAS_TRACE( "Take shortcut" );
-            int n( 0 );
-            for ( size_t j = 0; j < structured_grid.ny(); ++j ) {
-                double y = microdeg( structured_grid.y( j ) );
-                for ( size_t i = 0; i < structured_grid.nx( j ); ++i, ++n ) {
-                    nodes[n].x = microdeg( structured_grid.x( i, j ) );
-                    nodes[n].y = y;
-                    nodes[n].n = n;
-                }
-            }
-        }
-        else {
+        {
             ATLAS_TRACE( "sort all" );
             std::vector<eckit::mpi::Request> requests;
 
@@ -592,31 +871,12 @@ void EqualRegionsPartitioner::partition( const Grid& grid, int part[] ) const {
                     int* w_nodes_buffer = reinterpret_cast<int*>( w_nodes.data() );
 
                     ATLAS_TRACE_SCOPE( "create one bit" ) {
-                        if ( true )  // optimized experimental when true (still need to
-                                     // benchmark)
-                        {
-                            auto filter = [w_begin, w_end]( long n ) { return ( n >= w_begin && n < w_end ); };
-                            int i       = w_begin;
-                            int j( 0 );
-                            for ( PointXY point : grid.xy( filter ) ) {
-                                w_nodes[j].x = microdeg( point.x() );
-                                w_nodes[j].y = microdeg( point.y() );
-                                w_nodes[j].n = i++;
-                                ++j;
-                            }
-                        }
-                        else {
-                            int i( 0 );
-                            int j( 0 );
-                            for ( PointXY point : grid.xy() ) {
-                                if ( i >= w_begin && i < w_end ) {
-                                    w_nodes[j].x = microdeg( point.x() );
-                                    w_nodes[j].y = microdeg( point.y() );
-                                    w_nodes[j].n = i;
-                                    ++j;
-                                }
-                                ++i;
-                            }
+                        std::vector<double> w_xy( 2 * w_size );
+                        grid.fill_xy( w_begin, w_end, w_xy.data() );
+                        for ( size_t j = 0; j < w_size; ++j ) {
+                            w_nodes[j].x = microdeg( w_xy[2 * j + 0] );
+                            w_nodes[j].y = microdeg( w_xy[2 * j + 1] );
+                            w_nodes[j].n = w_begin + int( j );
                         }
                     }
                     ATLAS_TRACE_SCOPE( "sort one bit" ) { std::sort( w_nodes.begin(), w_nodes.end(), compare_NS_WE ); }
@@ -87,8 +87,31 @@ public:
 
     virtual void partition( const Grid&, int part[] ) const;
 
+    virtual void partition_runs( const Grid&, std::vector<gidx_t>& run_begin, std::vector<int>& run_part ) const;
+
     virtual std::string type() const { return "equal_regions"; }
 
+    // Analytic partitioning of a StructuredGrid, giving the same result as
+    // partition( const Grid&, int[] ) but without sorting nor communicating the
+    // global grid. Band and sector boundaries are computed per latitude.
+
+    /// Points [begin,end) of latitude j
+    struct Interval {
+        idx_t j;
+        idx_t begin;
+        idx_t end;
+    };
+
+    /// Latitude intervals of given partition, in order of increasing global index.
+    /// Complexity is O( ny log(nx) ) per band boundary.
+    void intervals( const StructuredGrid&, int partition, std::vector<Interval>& ) const;
+
+    /// 0-based global indices of the points of given partition, in increasing order
+    void points( const StructuredGrid&, int partition, std::vector<gidx_t>& ) const;
+
+    /// Partition of the point with 0-based global index gidx, in O( ny log(nx) )
+    int partition( const StructuredGrid&, gidx_t gidx ) const;
+
 public:
     // Node struct that holds the longitude and latitude in millidegrees
     // (integers)
@@ -113,6 +136,11 @@ private:
     // x in radians
     int sector( int band, const double& x ) const;
 
+    // Number of points and offsets of each partition in the global grid, sorted north to south
+    void chunks( gidx_t nb_nodes, std::vector<gidx_t>& count, std::vector<gidx_t>& displs ) const;
+
+    void partition_structured( const StructuredGrid&, int part[] ) const;
+
 private:
     int N_;
     std::vector<double> bands_;
@@ -62,6 +62,24 @@ Distribution Partitioner::partition( const Grid& grid ) const {
     return Distribution( grid, atlas::grid::Partitioner( this ) );
 }
 
+void Partitioner::partition_runs( const Grid& grid, std::vector<gidx_t>& run_begin, std::vector<int>& run_part ) const {
+    if ( nb_partitions() == 1 ) {
+        run_begin.assign( 1, 0 );
+        run_part.assign( 1, 0 );
+        return;
+    }
+    std::vector<int> part( grid.size() );
+    partition( grid, part.data() );
+    run_begin.clear();
+    run_part.clear();
+    for ( size_t j = 0; j < part.size(); ++j ) {
+        if ( run_part.empty() || part[j] != run_part.back() ) {
+            run_begin.push_back( j );
+            run_part.push_back( part[j] );
+        }
+    }
+}
+
 namespace {
 
 template <typename T>
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "eckit/memory/Owned.h"
 
 #include "atlas/grid/Distribution.h"
@@ -32,6 +34,13 @@ public:
 
     virtual void partition( const Grid& grid, int part[] ) const = 0;
 
+    /// Partition of consecutive global indices [run_begin[r],run_begin[r+1]) is run_part[r],
+    /// the last run ending at grid.size().
+    /// With a single partition the default implementation returns one run. Otherwise it compresses the
+    /// result of partition( grid, part[] ), which for partitioners that sort all grid points is of the same
+    /// size as their work arrays. Partitioners that can compute runs directly avoid storing one int per grid point.
+    virtual void partition_runs( const Grid& grid, std::vector<gidx_t>& run_begin, std::vector<int>& run_part ) const;
+
     Distribution partition( const Grid& grid ) const;
 
     size_t nb_partitions() const;
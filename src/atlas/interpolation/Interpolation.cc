@@ -22,7 +22,7 @@ Interpolation::Interpolation( const Config& config, const FunctionSpace& source,
         std::string type;
         config.get( "type", type );
         Implementation* impl = interpolation::MethodFactory::build( type, config );
-        impl->setup( source, target );
+        impl->setup( type, source, target );
         return impl;
     }() ) {}
 
@@ -8,13 +8,14 @@
  * nor does it submit to any jurisdiction. and Interpolation
  */
 
+#include <algorithm>
 #include <cmath>
 
 #include "atlas/interpolation/method/FiniteElement.h"
 
 #include "eckit/geometry/Point3.h"
+#include "eckit/log/BigNum.h"
 #include "eckit/log/Plural.h"
-#include "eckit/log/ProgressTimer.h"
 #include "eckit/log/Seconds.h"
 #include "eckit/mpi/Comm.h"
 
@@ -27,6 +28,7 @@
 #include "atlas/mesh/Nodes.h"
 #include "atlas/mesh/actions/BuildCellCentres.h"
 #include "atlas/mesh/actions/BuildXYZField.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
 #include "atlas/util/CoordinateEnums.h"
@@ -90,7 +92,8 @@ void FiniteElement::setup( const FunctionSpace& source ) {
     // generate barycenters of each triangle & insert them on a kd-tree
     Field cell_centres = mesh::actions::BuildCellCentres( "centre" )( meshSource );
 
-    eckit::ScopedPtr<ElemIndex3> eTree( create_element_kdtree( cell_centres ) );
+    ThreadKdTrees<ElemIndex3> eTrees;
+    create_element_kdtrees( cell_centres, eTrees );
 
     const mesh::Nodes& i_nodes = meshSource.nodes();
 
@@ -109,50 +112,68 @@ void FiniteElement::setup( const FunctionSpace& source ) {
 
     // weights -- one per vertex of element, triangles (3) or quads (4)
 
-    std::vector<eckit::linalg::Triplet> weights_triplets;  // structure to fill-in sparse matrix
-    weights_triplets.reserve( out_npts * 4 );              // preallocate space as if all elements where quads
-
     // search nearest k cell centres
 
     const size_t maxNbElemsToTry = std::max<size_t>( 64, size_t( Nelements * maxFractionElemsToTry ) );
-    size_t max_neighbours        = 0;
 
-    std::vector<size_t> failures;
+    const size_t nb_threads = atlas_omp_get_max_threads();
+    std::vector<std::vector<size_t>> thread_failures( nb_threads );
+    std::vector<size_t> thread_max_neighbours( nb_threads, 0 );
 
+    std::vector<eckit::linalg::Triplet> weights_triplets;  // structure to fill-in sparse matrix
     {
-        eckit::ProgressTimer progress( "Computing interpolation weights", out_npts, "point", double( 5 ),
-                                       Log::debug() );
-        for ( size_t ip = 0; ip < out_npts; ++ip, ++progress ) {
-            if ( out_ghosts( ip ) ) { continue; }
+        Trace timer( Here(), "Computing interpolation weights" );
+        compute_triplets( out_npts, weights_triplets, [&]( size_t thread, size_t begin, size_t end,
+                                                           Triplets& thread_triplets ) {
+            thread_triplets.reserve( ( end - begin ) * 4 );  // preallocate space as if all elements where quads
+
+            size_t& max_neighbours = thread_max_neighbours[thread];
+            ElemIndex3& eTree      = eTrees[thread];
+
+            for ( size_t ip = begin; ip < end; ++ip ) {
+                if ( out_ghosts( ip ) ) { continue; }
 
-            PointXYZ p{( *ocoords_ )( ip, 0 ), ( *ocoords_ )( ip, 1 ), ( *ocoords_ )( ip, 2 )};  // lookup point
+                PointXYZ p{( *ocoords_ )( ip, 0 ), ( *ocoords_ )( ip, 1 ), ( *ocoords_ )( ip, 2 )};  // lookup point
 
-            size_t kpts  = 1;
-            bool success = false;
-            std::ostringstream failures_log;
+                size_t kpts  = 1;
+                bool success = false;
+                std::ostringstream failures_log;
 
-            while ( !success && kpts <= maxNbElemsToTry ) {
-                max_neighbours = std::max( kpts, max_neighbours );
+                while ( !success && kpts <= maxNbElemsToTry ) {
+                    max_neighbours = std::max( kpts, max_neighbours );
 
-                ElemIndex3::NodeList cs = eTree->kNearestNeighbours( p, kpts );
-                Triplets triplets       = projectPointToElements( ip, cs, failures_log );
+                    ElemIndex3::NodeList cs = eTree.kNearestNeighbours( p, kpts );
+                    Triplets triplets       = projectPointToElements( ip, cs, failures_log );
 
-                if ( triplets.size() ) {
-                    std::copy( triplets.begin(), triplets.end(), std::back_inserter( weights_triplets ) );
-                    success = true;
+                    if ( triplets.size() ) {
+                        std::copy( triplets.begin(), triplets.end(), std::back_inserter( thread_triplets ) );
+                        success = true;
+                    }
+                    kpts *= 2;
                 }
-                kpts *= 2;
-            }
 
-            if ( !success ) {
-                failures.push_back( ip );
-                Log::debug() << "------------------------------------------------------"
-                                "---------------------\n";
-                const PointLonLat pll = util::Earth::convertGeocentricToGeodetic( p );
-                Log::debug() << "Failed to project point (lon,lat)=" << pll << '\n';
-                Log::debug() << failures_log.str();
+                if ( !success ) {
+                    thread_failures[thread].push_back( ip );
+                    const PointLonLat pll = util::Earth::convertGeocentricToGeodetic( p );
+                    atlas_omp_critical {
+                        Log::debug() << "------------------------------------------------------"
+                                        "---------------------\n";
+                        Log::debug() << "Failed to project point (lon,lat)=" << pll << '\n';
+                        Log::debug() << failures_log.str();
+                    }
+                }
             }
-        }
+        } );
+        timer.stop();
+        Log::debug() << eckit::BigNum( out_npts ) << " points (at " << out_npts / std::max( timer.elapsed(), 1.e-9 )
+                     << " points/s)" << std::endl;
+    }
+
+    std::vector<size_t> failures;
+    size_t max_neighbours = 0;
+    for ( size_t thread = 0; thread < nb_threads; ++thread ) {
+        failures.insert( failures.end(), thread_failures[thread].begin(), thread_failures[thread].end() );
+        max_neighbours = std::max( max_neighbours, thread_max_neighbours[thread] );
     }
     Log::debug() << "Maximum neighbours searched was " << eckit::Plural( max_neighbours, "element" ) << std::endl;
 
@@ -8,14 +8,18 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
+
 #include "atlas/interpolation/method/KNearestNeighbours.h"
 
+#include "eckit/log/BigNum.h"
 #include "eckit/log/Plural.h"
 #include "eckit/log/Timer.h"
 
 #include "atlas/functionspace/NodeColumns.h"
 #include "atlas/mesh/Nodes.h"
 #include "atlas/mesh/actions/BuildXYZField.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
 
@@ -46,7 +50,7 @@ void KNearestNeighbours::setup( const FunctionSpace& source, const FunctionSpace
 
     // build point-search tree
     buildPointSearchTree( meshSource );
-    ASSERT( pTree_ );
+    ASSERT( not pTrees_.empty() );
 
     // generate 3D point coordinates
     mesh::actions::BuildXYZField( "xyz" )( meshTarget );
@@ -57,45 +61,47 @@ void KNearestNeighbours::setup( const FunctionSpace& source, const FunctionSpace
 
     // fill the sparse matrix
     std::vector<Triplet> weights_triplets;
-    weights_triplets.reserve( out_npts * k_ );
     {
-        Trace timer( Here(), "atlas::interpolation::method::NearestNeighbour::setup()" );
-
-        std::vector<double> weights;
-
-        for ( size_t ip = 0; ip < out_npts; ++ip ) {
-            if ( ip && ( ip % 1000 == 0 ) ) {
-                double rate = ip / timer.elapsed();
-                Log::debug() << eckit::BigNum( ip ) << " (at " << rate << " points/s)..." << std::endl;
-            }
-
-            // find the closest input points to the output point
-            PointIndex3::Point p{coords( ip, 0 ), coords( ip, 1 ), coords( ip, 2 )};
-            PointIndex3::NodeList nn = pTree_->kNearestNeighbours( p, k_ );
-
-            // calculate weights (individual and total, to normalise) using distance
-            // squared
-            const size_t npts = nn.size();
-            ASSERT( npts );
-            weights.resize( npts, 0 );
-
-            double sum = 0;
-            for ( size_t j = 0; j < npts; ++j ) {
-                PointIndex3::Point np = nn[j].point();
-                const double d2       = eckit::geometry::Point3::distance2( p, np );
-
-                weights[j] = 1. / ( 1. + d2 );
-                sum += weights[j];
-            }
-            ASSERT( sum > 0 );
-
-            // insert weights into the matrix
-            for ( size_t j = 0; j < npts; ++j ) {
-                size_t jp = nn[j].payload();
-                ASSERT( jp < inp_npts );
-                weights_triplets.push_back( Triplet( ip, jp, weights[j] / sum ) );
+        Trace timer( Here(), "atlas::interpolation::method::KNearestNeighbours::setup()" );
+        compute_triplets( out_npts, weights_triplets, [&]( size_t thread, size_t begin, size_t end,
+                                                           Triplets& triplets ) {
+            triplets.reserve( ( end - begin ) * k_ );
+            PointIndex3& tree = pTrees_[thread];
+
+            std::vector<double> weights;
+
+            for ( size_t ip = begin; ip < end; ++ip ) {
+                // find the closest input points to the output point
+                PointIndex3::Point p{coords( ip, 0 ), coords( ip, 1 ), coords( ip, 2 )};
+                PointIndex3::NodeList nn = tree.kNearestNeighbours( p, k_ );
+
+                // calculate weights (individual and total, to normalise) using distance
+                // squared
+                const size_t npts = nn.size();
+                ASSERT( npts );
+                weights.resize( npts, 0 );
+
+                double sum = 0;
+                for ( size_t j = 0; j < npts; ++j ) {
+                    PointIndex3::Point np = nn[j].point();
+                    const double d2       = eckit::geometry::Point3::distance2( p, np );
+
+                    weights[j] = 1. / ( 1. + d2 );
+                    sum += weights[j];
+                }
+                ASSERT( sum > 0 );
+
+                // insert weights into the matrix
+                for ( size_t j = 0; j < npts; ++j ) {
+                    size_t jp = nn[j].payload();
+                    ASSERT( jp < inp_npts );
+                    triplets.push_back( Triplet( ip, jp, weights[j] / sum ) );
+                }
             }
-        }
+        } );
+        timer.stop();
+        Log::debug() << eckit::BigNum( out_npts ) << " points (at " << out_npts / std::max( timer.elapsed(), 1.e-9 )
+                     << " points/s)" << std::endl;
     }
 
     // fill sparse matrix and return
@@ -8,8 +8,6 @@
  * nor does it submit to any jurisdiction. and Interpolation
  */
 
-#include "eckit/config/Resource.h"
-
 #include "atlas/interpolation/method/KNearestNeighboursBase.h"
 #include "atlas/library/Library.h"
 #include "atlas/mesh/Nodes.h"
@@ -28,26 +26,14 @@ void KNearestNeighboursBase::buildPointSearchTree( Mesh& meshSource ) {
     mesh::actions::BuildXYZField( "xyz" )( meshSource );
     array::ArrayView<double, 2> coords = array::make_view<double, 2>( meshSource.nodes().field( "xyz" ) );
 
-    // build point-search tree
-    pTree_.reset( new PointIndex3 );
-
-    static bool fastBuildKDTrees = eckit::Resource<bool>( "$ATLAS_FAST_BUILD_KDTREES", true );
-
-    if ( fastBuildKDTrees ) {
-        std::vector<PointIndex3::Value> pidx;
-        pidx.reserve( meshSource.nodes().size() );
-        for ( size_t ip = 0; ip < meshSource.nodes().size(); ++ip ) {
-            PointIndex3::Point p{coords( ip, 0 ), coords( ip, 1 ), coords( ip, 2 )};
-            pidx.push_back( PointIndex3::Value( p, ip ) );
-        }
-        pTree_->build( pidx.begin(), pidx.end() );
-    }
-    else {
-        for ( size_t ip = 0; ip < meshSource.nodes().size(); ++ip ) {
-            PointIndex3::Point p{coords( ip, 0 ), coords( ip, 1 ), coords( ip, 2 )};
-            pTree_->insert( PointIndex3::Value( p, ip ) );
-        }
+    // build point-search trees
+    std::vector<PointIndex3::Value> pidx;
+    pidx.reserve( meshSource.nodes().size() );
+    for ( size_t ip = 0; ip < meshSource.nodes().size(); ++ip ) {
+        PointIndex3::Point p{coords( ip, 0 ), coords( ip, 1 ), coords( ip, 2 )};
+        pidx.push_back( PointIndex3::Value( p, ip ) );
     }
+    pTrees_.build( pidx );
 }
 
 }  // namespace method
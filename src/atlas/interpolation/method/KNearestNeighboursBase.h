@@ -10,8 +10,6 @@
 
 #pragma once
 
-#include "eckit/memory/ScopedPtr.h"
-
 #include "atlas/interpolation/method/Method.h"
 #include "atlas/interpolation/method/PointIndex3.h"
 
@@ -25,9 +23,10 @@ public:
     virtual ~KNearestNeighboursBase() {}
 
 protected:
+    /// Build a point-search tree for each thread
     void buildPointSearchTree( Mesh& meshSource );
 
-    eckit::ScopedPtr<PointIndex3> pTree_;
+    ThreadKdTrees<PointIndex3> pTrees_;
 };
 
 }  // namespace method
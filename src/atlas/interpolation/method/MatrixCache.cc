@@ -0,0 +1,421 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <list>
+#include <map>
+#include <sstream>
+
+#include "eckit/config/Configuration.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/thread/AutoLock.h"
+#include "eckit/thread/Mutex.h"
+#include "eckit/utils/MD5.h"
+
+#include "atlas/array/DataType.h"
+#include "atlas/field/Field.h"
+#include "atlas/functionspace/NodeColumns.h"
+#include "atlas/functionspace/PointCloud.h"
+#include "atlas/functionspace/StructuredColumns.h"
+#include "atlas/grid/Grid.h"
+#include "atlas/interpolation/method/MatrixCache.h"
+#include "atlas/library/Library.h"
+#include "atlas/mesh/HybridElements.h"
+#include "atlas/mesh/Mesh.h"
+#include "atlas/mesh/Nodes.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/Checksum.h"
+#include "atlas/util/Config.h"
+
+namespace atlas {
+namespace interpolation {
+
+namespace {
+
+using Matrix = MatrixCache::Matrix;
+using Index  = eckit::linalg::Index;
+using Scalar = eckit::linalg::Scalar;
+
+//-----------------------------------------------------------------------------
+// Key
+
+void hash_field( eckit::Hash& h, const Field& field ) {
+    h.add( field.datatype().str() );
+    h.add( long( field.size() ) );
+    util::checksum_t checksum;
+    switch ( field.datatype().kind() ) {
+        case array::DataType::KIND_INT32:
+            checksum = util::checksum( field.data<int>(), field.size(), 0 );
+            break;
+        case array::DataType::KIND_INT64:
+            checksum = util::checksum( field.data<long>(), field.size(), 0 );
+            break;
+        case array::DataType::KIND_REAL32:
+            checksum = util::checksum( field.data<float>(), field.size(), 0 );
+            break;
+        case array::DataType::KIND_REAL64:
+            checksum = util::checksum( field.data<double>(), field.size(), 0 );
+            break;
+        default:
+            throw eckit::NotImplemented( "Checksum of field " + field.name(), Here() );
+    }
+    h.add( checksum );
+}
+
+/// Adds to the hash the configuration, except the options that only control caching
+void hash_config( eckit::Hash& h, const eckit::Configuration& config ) {
+    eckit::ValueMap map = util::Config( config ).get();
+    for ( eckit::ValueMap::const_iterator vit = map.begin(); vit != map.end(); ++vit ) {
+        const std::string key = vit->first.as<std::string>();
+        if ( key == "matrix_cache" || key == "matrix_cache_directory" ) { continue; }
+        std::ostringstream value;  // values can be of any type, not only strings
+        value << vit->second;
+        h.add( key );
+        h.add( value.str() );
+    }
+}
+
+/// Adds to the hash the cells of the mesh, by their node connectivity
+void hash_cells( eckit::Hash& h, const Mesh& mesh ) {
+    const mesh::HybridElements::Connectivity& connectivity = mesh.cells().node_connectivity();
+    h.add( long( connectivity.blocks() ) );
+    for ( size_t b = 0; b < connectivity.blocks(); ++b ) {
+        h.add( long( connectivity.block( b ).rows() ) );
+        h.add( long( connectivity.block( b ).cols() ) );
+    }
+    const size_t size = connectivity.rows() ? connectivity.displs( connectivity.rows() ) : 0;
+    h.add( util::checksum( connectivity.data(), size, 0 ) );
+}
+
+/// Adds to the hash what identifies the points of this MPI task in the functionspace.
+/// @return false if the functionspace cannot be identified
+bool hash_functionspace( eckit::Hash& h, const FunctionSpace& fs ) {
+    h.add( fs.type() );
+    if ( functionspace::StructuredColumns structured = fs ) {
+        structured.grid().hash( h );
+        hash_field( h, structured.xy() );
+        hash_field( h, structured.global_index() );
+        return true;
+    }
+    if ( functionspace::NodeColumns nodecolumns = fs ) {
+        const Mesh& mesh = nodecolumns.mesh();
+        if ( mesh.metadata().has( "mesh_generator" ) ) {
+            mesh.grid().hash( h );
+            h.add( mesh.metadata().getString( "mesh_generator" ) );
+        }
+        else {
+            // Without a generator to identify it, the mesh is identified by its cells
+            hash_cells( h, mesh );
+        }
+        h.add( long( nodecolumns.halo().size() ) );
+        hash_field( h, mesh.nodes().lonlat() );
+        hash_field( h, mesh.nodes().global_index() );
+        hash_field( h, mesh.nodes().ghost() );
+        return true;
+    }
+    if ( functionspace::PointCloud pointcloud = fs ) {
+        hash_field( h, pointcloud.lonlat() );
+        return true;
+    }
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+// File
+
+static const char magic[16] = "atlas-matrix";
+
+struct Header {
+    char magic[16];
+    std::uint32_t version;
+    std::uint32_t header_size;
+    std::uint64_t rows;
+    std::uint64_t cols;
+    std::uint64_t nonzeros;
+    std::uint32_t sizeof_index;
+    std::uint32_t sizeof_scalar;
+    char key[64];
+};
+static_assert( sizeof( Header ) % sizeof( Scalar ) == 0, "Matrix data following header must be aligned" );
+
+// The file contains the header, followed by the nonzeros (Scalar), row starts (Index) and column indices (Index)
+size_t file_size( size_t rows, size_t nonzeros ) {
+    return sizeof( Header ) + nonzeros * sizeof( Scalar ) + ( rows + 1 + nonzeros ) * sizeof( Index );
+}
+
+Header make_header( const std::string& key, size_t rows, size_t cols, size_t nonzeros ) {
+    Header header;
+    std::memset( &header, 0, sizeof( Header ) );
+    std::memcpy( header.magic, magic, sizeof( magic ) );
+    header.version       = MatrixCache::version;
+    header.header_size   = sizeof( Header );
+    header.rows          = rows;
+    header.cols          = cols;
+    header.nonzeros      = nonzeros;
+    header.sizeof_index  = sizeof( Index );
+    header.sizeof_scalar = sizeof( Scalar );
+    std::strncpy( header.key, key.c_str(), sizeof( header.key ) - 1 );
+    return header;
+}
+
+void write_file( const eckit::PathName& path, const std::string& key, const Matrix& matrix ) {
+    Header header = make_header( key, matrix.rows(), matrix.cols(), matrix.nonZeros() );
+
+    std::stringstream tmp;
+    tmp << path.asString() << ".tmp." << ::getpid();
+    {
+        std::ofstream out( tmp.str().c_str(), std::ios::binary );
+        if ( not out ) { throw eckit::CantOpenFile( tmp.str() ); }
+        out.write( reinterpret_cast<const char*>( &header ), sizeof( Header ) );
+        out.write( reinterpret_cast<const char*>( matrix.data() ), matrix.nonZeros() * sizeof( Scalar ) );
+        out.write( reinterpret_cast<const char*>( matrix.outer() ), ( matrix.rows() + 1 ) * sizeof( Index ) );
+        out.write( reinterpret_cast<const char*>( matrix.inner() ), matrix.nonZeros() * sizeof( Index ) );
+        if ( not out ) {
+            std::remove( tmp.str().c_str() );
+            throw eckit::WriteError( tmp.str() );
+        }
+    }
+    if ( std::rename( tmp.str().c_str(), path.localPath() ) != 0 ) {
+        std::remove( tmp.str().c_str() );
+        throw eckit::FailedSystemCall( "rename " + tmp.str() + " to " + path.asString() );
+    }
+}
+
+/// Matrix storage in a memory mapped cache file. The pages are only read when used,
+/// and are shared by all processes on a node that map the same file.
+class MappedMatrixFile : public Matrix::Allocator {
+public:
+    MappedMatrixFile( const eckit::PathName& path ) : path_( path ) {
+        int fd = ::open( path.localPath(), O_RDONLY );
+        if ( fd < 0 ) { throw eckit::CantOpenFile( path ); }
+        size_ = size_t( path.size() );
+        if ( size_ ) {
+            data_ = ::mmap( nullptr, size_, PROT_READ, MAP_SHARED, fd, 0 );
+            if ( data_ == MAP_FAILED ) {
+                data_ = nullptr;
+                ::close( fd );
+                throw eckit::FailedSystemCall( "mmap " + path.asString() );
+            }
+        }
+        ::close( fd );
+    }
+
+    virtual ~MappedMatrixFile() override {
+        if ( data_ ) { ::munmap( data_, size_ ); }
+    }
+
+    /// @return true if the file holds a complete matrix of this version with given key
+    bool valid( const std::string& key ) const {
+        if ( size_ < sizeof( Header ) ) { return false; }
+        const Header& h = header();
+        Header expected = make_header( key, h.rows, h.cols, h.nonzeros );
+        return std::memcmp( &h, &expected, sizeof( Header ) ) == 0 && size_ == file_size( h.rows, h.nonzeros );
+    }
+
+    virtual Matrix::Layout allocate( Matrix::Shape& shape ) override {
+        const Header& h = header();
+        shape.size_     = h.nonzeros;
+        shape.rows_     = h.rows;
+        shape.cols_     = h.cols;
+
+        char* begin = static_cast<char*>( data_ ) + sizeof( Header );
+        Matrix::Layout layout;
+        layout.data_  = reinterpret_cast<Scalar*>( begin );
+        layout.outer_ = reinterpret_cast<Index*>( begin + h.nonzeros * sizeof( Scalar ) );
+        layout.inner_ = layout.outer_ + h.rows + 1;
+        return layout;
+    }
+
+    virtual void deallocate( Matrix::Layout, Matrix::Shape ) override {}
+
+    virtual bool inSharedMemory() const override { return true; }
+
+    virtual void print( std::ostream& out ) const override { out << "MappedMatrixFile[path=" << path_ << "]"; }
+
+private:
+    const Header& header() const { return *reinterpret_cast<const Header*>( data_ ); }
+
+    eckit::PathName path_;
+    size_t size_{0};
+    void* data_{nullptr};
+};
+
+//-----------------------------------------------------------------------------
+// Memory
+
+/// Most recently used matrices of this process. Never destroyed, as it may be used during static destruction.
+class MatrixRegistry {
+public:
+    static MatrixRegistry& instance() {
+        static MatrixRegistry* registry = new MatrixRegistry();
+        return *registry;
+    }
+
+    std::shared_ptr<const Matrix> get( const std::string& key ) {
+        eckit::AutoLock<eckit::Mutex> lock( mutex_ );
+        auto it = index_.find( key );
+        if ( it == index_.end() ) { return nullptr; }
+        entries_.splice( entries_.begin(), entries_, it->second );
+        return it->second->second;
+    }
+
+    void insert( const std::string& key, const std::shared_ptr<const Matrix>& matrix ) {
+        eckit::AutoLock<eckit::Mutex> lock( mutex_ );
+        const size_t capacity = size_t( std::max( atlas::Library::instance().interpolationMatrixCacheSize(), 0 ) );
+        auto it               = index_.find( key );
+        if ( it != index_.end() ) {
+            entries_.erase( it->second );
+            index_.erase( it );
+        }
+        if ( capacity == 0 ) { return; }
+        entries_.emplace_front( key, matrix );
+        index_[key] = entries_.begin();
+        while ( entries_.size() > capacity ) {
+            index_.erase( entries_.back().first );
+            entries_.pop_back();
+        }
+    }
+
+    size_t size() {
+        eckit::AutoLock<eckit::Mutex> lock( mutex_ );
+        return entries_.size();
+    }
+
+    void clear() {
+        eckit::AutoLock<eckit::Mutex> lock( mutex_ );
+        index_.clear();
+        entries_.clear();
+    }
+
+private:
+    using Entries = std::list<std::pair<std::string, std::shared_ptr<const Matrix>>>;
+    eckit::Mutex mutex_;
+    Entries entries_;  // most recently used first
+    std::map<std::string, Entries::iterator> index_;
+};
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+
+const int MatrixCache::version = 1;
+
+MatrixCache::MatrixCache( const std::string& type, const eckit::Parametrisation& config, const FunctionSpace& source,
+                          const FunctionSpace& target ) :
+    type_( type ) {
+    bool enabled = false;
+    config.get( "matrix_cache", enabled );
+    config.get( "matrix_cache_directory", directory_ );
+    if ( not enabled && directory_.empty() ) { return; }
+
+    ATLAS_TRACE( "atlas::interpolation::MatrixCache key" );
+
+    const eckit::Configuration* configuration = dynamic_cast<const eckit::Configuration*>( &config );
+    if ( not configuration ) {
+        Log::debug() << "Interpolation matrix not cached: configuration cannot be hashed" << std::endl;
+        return;
+    }
+
+    eckit::MD5 md5;
+    md5.add( "atlas-interpolation-matrix" );
+    md5.add( version );
+    md5.add( type );
+    hash_config( md5, *configuration );
+    md5.add( long( mpi::comm().size() ) );
+    md5.add( long( mpi::comm().rank() ) );
+    if ( not hash_functionspace( md5, source ) || not hash_functionspace( md5, target ) ) {
+        Log::debug() << "Interpolation matrix not cached: functionspaces " << source.type() << " and "
+                     << target.type() << " cannot be hashed" << std::endl;
+        return;
+    }
+    key_ = md5.digest();
+}
+
+std::shared_ptr<const MatrixCache::Matrix> MatrixCache::get() const {
+    if ( key_.empty() ) { return nullptr; }
+
+    std::shared_ptr<const Matrix> matrix = MatrixRegistry::instance().get( key_ );
+    if ( matrix ) {
+        Log::debug() << "Interpolation matrix " << key_ << " found in memory" << std::endl;
+        return matrix;
+    }
+
+    if ( directory_.empty() ) { return nullptr; }
+    eckit::PathName file = path( directory_, type_, key_ );
+    if ( not file.exists() ) { return nullptr; }
+
+    ATLAS_TRACE( "atlas::interpolation::MatrixCache map file" );
+    try {
+        std::unique_ptr<MappedMatrixFile> mapped( new MappedMatrixFile( file ) );
+        if ( not mapped->valid( key_ ) ) {
+            Log::warning() << "Interpolation matrix cache file " << file << " is not a valid version " << version
+                           << " cache with key " << key_ << std::endl;
+            return nullptr;
+        }
+        matrix = std::make_shared<const Matrix>( mapped.release() );
+    }
+    catch ( const eckit::Exception& e ) {
+        Log::warning() << "Could not map interpolation matrix cache file " << file << ": " << e.what() << std::endl;
+        return nullptr;
+    }
+    Log::debug() << "Interpolation matrix " << key_ << " mapped from " << file << std::endl;
+    MatrixRegistry::instance().insert( key_, matrix );
+    return matrix;
+}
+
+std::shared_ptr<const MatrixCache::Matrix> MatrixCache::insert( Matrix& m ) const {
+    std::shared_ptr<Matrix> matrix = std::make_shared<Matrix>();
+    matrix->swap( m );
+    if ( key_.empty() ) { return matrix; }
+
+    MatrixRegistry::instance().insert( key_, matrix );
+
+    if ( not directory_.empty() ) {
+        ATLAS_TRACE( "atlas::interpolation::MatrixCache write file" );
+        eckit::PathName file = path( directory_, type_, key_ );
+        try {
+            eckit::PathName( directory_ ).mkdir();
+            write_file( file, key_, *matrix );
+        }
+        catch ( const eckit::Exception& e ) {
+            Log::warning() << "Could not write interpolation matrix cache file " << file << ": " << e.what()
+                           << std::endl;
+        }
+    }
+    return matrix;
+}
+
+eckit::PathName MatrixCache::path( const std::string& directory, const std::string& type, const std::string& key ) {
+    std::stringstream name;
+    name << directory << "/interpolation-" << type << "-" << key << "-v" << version << ".bin";
+    return name.str();
+}
+
+size_t MatrixCache::size() {
+    return MatrixRegistry::instance().size();
+}
+
+void MatrixCache::clear() {
+    MatrixRegistry::instance().clear();
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace interpolation
+}  // namespace atlas
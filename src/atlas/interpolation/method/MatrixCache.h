@@ -0,0 +1,83 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "eckit/config/Parametrisation.h"
+#include "eckit/filesystem/PathName.h"
+#include "eckit/linalg/SparseMatrix.h"
+
+namespace atlas {
+class FunctionSpace;
+}  // namespace atlas
+
+namespace atlas {
+namespace interpolation {
+
+//-----------------------------------------------------------------------------
+
+/// @class MatrixCache
+///
+/// Cache of interpolation matrices, so that the search trees and weights of a recurring
+/// interpolation are computed only once.
+///
+/// Matrices are keyed by a hash of the interpolation method, its configuration without the cache
+/// options, and the local part of the source and target functionspaces: the hash() of grids and
+/// mesh generators (or the cell connectivity of meshes not made by a generator), and checksums of
+/// the coordinates and global indices of the points of this MPI task.
+///
+/// Caching is enabled per interpolation with the configuration options
+///   - "matrix_cache" (bool) : reuse matrices within this process. The most recently used
+///     matrices are kept, up to ATLAS_INTERPOLATION_MATRIX_CACHE_SIZE (default 8).
+///   - "matrix_cache_directory" (string) : in addition, store matrices in binary files in this
+///     directory, one per MPI task, which are memory mapped when reused by a later run.
+class MatrixCache {
+public:
+    using Matrix = eckit::linalg::SparseMatrix;
+
+    static const int version;
+
+    /// Cache for given interpolation method, with key left empty when caching is not enabled or
+    /// when the configuration or functionspaces cannot be hashed.
+    MatrixCache( const std::string& type, const eckit::Parametrisation&, const FunctionSpace& source,
+                 const FunctionSpace& target );
+
+    operator bool() const { return not key_.empty(); }
+
+    const std::string& key() const { return key_; }
+
+    /// @return cached matrix, from memory or else from file, or nullptr if not found
+    std::shared_ptr<const Matrix> get() const;
+
+    /// Store matrix in the cache. Its contents are moved into the returned shared matrix.
+    std::shared_ptr<const Matrix> insert( Matrix& ) const;
+
+    /// Path of the cache file for given directory, interpolation method and key
+    static eckit::PathName path( const std::string& directory, const std::string& type, const std::string& key );
+
+    /// Number of matrices kept in memory by this process
+    static size_t size();
+
+    /// Forget all matrices kept in memory by this process
+    static void clear();
+
+private:
+    std::string type_;
+    std::string key_;
+    std::string directory_;
+};
+
+//-----------------------------------------------------------------------------
+
+}  // namespace interpolation
+}  // namespace atlas
@@ -10,7 +10,9 @@
 
 #include "atlas/interpolation/method/Method.h"
 
+#include <algorithm>
 #include <map>
+#include <vector>
 
 #include "eckit/exception/Exceptions.h"
 #include "eckit/linalg/LinearAlgebra.h"
@@ -20,8 +22,11 @@
 #include "eckit/thread/Mutex.h"
 #include "eckit/thread/Once.h"
 
+#include "atlas/array/DataType.h"
 #include "atlas/field/Field.h"
 #include "atlas/field/FieldSet.h"
+#include "atlas/interpolation/method/MatrixCache.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
 
@@ -29,6 +34,7 @@
 #include "FiniteElement.h"
 #include "KNearestNeighbours.h"
 #include "NearestNeighbour.h"
+#include "StructuredInterpolation.h"
 
 namespace atlas {
 namespace interpolation {
@@ -55,6 +61,8 @@ struct force_link {
         load_builder<method::FiniteElement>();
         load_builder<method::KNearestNeighbours>();
         load_builder<method::NearestNeighbour>();
+        load_builder<method::StructuredBilinear>();
+        load_builder<method::StructuredBicubic>();
     }
 };
 
@@ -94,32 +102,143 @@ Method* MethodFactory::build( const std::string& name, const Method::Config& con
     return ( *j ).second->make( config );
 }
 
+namespace {
+
+/// Columns of a field, i.e. the number of values per point: all levels and variables
+size_t nb_columns( const Field& field ) {
+    size_t n = 1;
+    for ( size_t j = 1; j < field.rank(); ++j ) {
+        n *= field.shape( j );
+    }
+    return n;
+}
+
+/// Number of columns of a field processed at once, so that the target values of a row stay in L1 cache
+static const size_t column_block_size = 64;
+
+/// Apply the weights W to the dense right-hand side formed by the columns of all fields:
+///     tgt[f]( i, : ) = sum_k W( i, k ) * src[f]( k, : )
+/// The columns are processed in blocks. The weights of a row are reused for every block of every field
+/// while they are in cache, and each target block is accumulated in cache over all weights of the row.
+template <typename Value>
+void spmm( const eckit::linalg::SparseMatrix& W, const std::vector<const Value*>& src, const std::vector<Value*>& tgt,
+           const std::vector<size_t>& ncols ) {
+    using Index = eckit::linalg::Index;
+
+    const Index* outer  = W.outer();
+    const Index* inner  = W.inner();
+    const auto* weights = W.data();
+    const size_t rows   = W.rows();
+    const size_t nf     = src.size();
+
+    atlas_omp_parallel_for( size_t r = 0; r < rows; ++r ) {
+        for ( size_t f = 0; f < nf; ++f ) {
+            const size_t n = ncols[f];
+            Value* t       = tgt[f] + r * n;
+            for ( size_t cbegin = 0; cbegin < n; cbegin += column_block_size ) {
+                const size_t cend = std::min( cbegin + column_block_size, n );
+                for ( size_t c = cbegin; c < cend; ++c ) {
+                    t[c] = 0;
+                }
+                for ( Index k = outer[r]; k < outer[r + 1]; ++k ) {
+                    const Value w  = Value( weights[k] );
+                    const Value* s = src[f] + size_t( inner[k] ) * n;
+                    for ( size_t c = cbegin; c < cend; ++c ) {
+                        t[c] += w * s[c];
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename Value>
+void interpolate( const eckit::linalg::SparseMatrix& W, const std::vector<const Field*>& src,
+              const std::vector<Field*>& tgt ) {
+    if ( src.empty() ) return;
+
+    std::vector<const Value*> src_data;
+    std::vector<Value*> tgt_data;
+    std::vector<size_t> ncols;
+    for ( size_t i = 0; i < src.size(); ++i ) {
+        src_data.push_back( src[i]->data<Value>() );
+        tgt_data.push_back( tgt[i]->data<Value>() );
+        ncols.push_back( nb_columns( *src[i] ) );
+    }
+    spmm( W, src_data, tgt_data, ncols );
+}
+
+}  // namespace
+
+void Method::setup( const std::string& type, const FunctionSpace& source, const FunctionSpace& target ) {
+    MatrixCache cache( type, config_, source, target );
+    if ( cache ) {
+        shared_matrix_ = cache.get();
+        if ( shared_matrix_ ) { return; }
+    }
+    setup( source, target );
+    if ( cache ) { shared_matrix_ = cache.insert( matrix_ ); }
+}
+
 void Method::execute( const FieldSet& fieldsSource, FieldSet& fieldsTarget ) const {
     ATLAS_TRACE( "atlas::interpolation::method::Method::execute()" );
 
     const size_t N = fieldsSource.size();
     ASSERT( N == fieldsTarget.size() );
 
-    for ( size_t i = 0; i < fieldsSource.size(); ++i ) {
-        Log::debug() << "Method::execute() on field " << ( i + 1 ) << '/' << N << "..." << std::endl;
+    // Fields are grouped per datatype, so that each group needs a single pass over the matrix.
+    // Fields of double with a single column are applied with the configured eckit linear algebra backend.
+    std::vector<const Field*> src_double, src_float, src_spmv;
+    std::vector<Field*> tgt_double, tgt_float, tgt_spmv;
 
+    for ( size_t i = 0; i < N; ++i ) {
         const Field& src = fieldsSource[i];
         Field& tgt       = fieldsTarget[i];
 
-        eckit::linalg::Vector v_src( const_cast<double*>( src.data<double>() ), src.shape( 0 ) );
-        eckit::linalg::Vector v_tgt( tgt.data<double>(), tgt.shape( 0 ) );
+        ASSERT( src.datatype() == tgt.datatype() );
+        ASSERT( src.array().contiguous() && tgt.array().contiguous() );
+        ASSERT( src.shape( 0 ) == matrix().cols() );
+        ASSERT( tgt.shape( 0 ) == matrix().rows() );
+        ASSERT( nb_columns( src ) == nb_columns( tgt ) );
+
+        switch ( src.datatype().kind() ) {
+            case array::DataType::KIND_REAL64:
+                if ( nb_columns( src ) == 1 ) {
+                    src_spmv.push_back( &src );
+                    tgt_spmv.push_back( &tgt );
+                }
+                else {
+                    src_double.push_back( &src );
+                    tgt_double.push_back( &tgt );
+                }
+                break;
+            case array::DataType::KIND_REAL32:
+                src_float.push_back( &src );
+                tgt_float.push_back( &tgt );
+                break;
+            default:
+                throw eckit::NotImplemented(
+                    "Interpolation of field " + src.name() + " with datatype " + src.datatype().str(), Here() );
+        }
+    }
+
+    Log::debug() << "Method::execute() on " << N << " fields" << std::endl;
 
-        eckit::linalg::LinearAlgebra::backend().spmv( matrix_, v_src, v_tgt );
+    for ( size_t i = 0; i < src_spmv.size(); ++i ) {
+        eckit::linalg::Vector v_src( const_cast<double*>( src_spmv[i]->data<double>() ), src_spmv[i]->shape( 0 ) );
+        eckit::linalg::Vector v_tgt( tgt_spmv[i]->data<double>(), tgt_spmv[i]->shape( 0 ) );
+        eckit::linalg::LinearAlgebra::backend().spmv( matrix(), v_src, v_tgt );
     }
+    interpolate<double>( matrix(), src_double, tgt_double );
+    interpolate<float>( matrix(), src_float, tgt_float );
 }
 
 void Method::execute( const Field& fieldSource, Field& fieldTarget ) const {
-    ATLAS_TRACE( "atlas::interpolation::method::Method::execute()" );
-
-    eckit::linalg::Vector v_src( const_cast<Field&>( fieldSource ).data<double>(), fieldSource.shape( 0 ) ),
-        v_tgt( fieldTarget.data<double>(), fieldTarget.shape( 0 ) );
-
-    eckit::linalg::LinearAlgebra::backend().spmv( matrix_, v_src, v_tgt );
+    FieldSet fieldsSource;
+    FieldSet fieldsTarget;
+    fieldsSource.add( fieldSource );
+    fieldsTarget.add( fieldTarget );
+    execute( fieldsSource, fieldsTarget );
 }
 
 void Method::normalise( Triplets& triplets ) {
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include <exception>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -18,6 +20,8 @@
 #include "eckit/memory/Owned.h"
 #include "eckit/memory/SharedPtr.h"
 
+#include "atlas/parallel/omp/omp.h"
+
 namespace atlas {
 class Field;
 class FieldSet;
@@ -41,6 +45,13 @@ public:
    */
     virtual void setup( const FunctionSpace& source, const FunctionSpace& target ) = 0;
 
+    /**
+   * @brief Setup the interpolator, or reuse the matrix of an identical setup from the
+   * MatrixCache when it is enabled in the configuration
+   * @param type name of this method in the MethodFactory
+   */
+    void setup( const std::string& type, const FunctionSpace& source, const FunctionSpace& target );
+
     virtual void execute( const FieldSet& source, FieldSet& target ) const;
     virtual void execute( const Field& source, Field& target ) const;
 
@@ -51,6 +62,17 @@ protected:
 
     static void normalise( Triplets& triplets );
 
+    /// @brief Compute the triplets of target points [0,size) in an OpenMP parallel region
+    ///
+    /// compute( thread, begin, end, triplets ) is called by every thread for a contiguous range of target points,
+    /// with its own triplets. These are concatenated in thread order, so that the matrix is the same as with a
+    /// serial loop. An exception thrown by compute is rethrown after the parallel region.
+    /// Per-thread results indexed by thread can be sized with atlas_omp_get_max_threads().
+    template <typename Compute>
+    static void compute_triplets( size_t size, Triplets& triplets, const Compute& compute );
+
+    const Matrix& matrix() const { return shared_matrix_ ? *shared_matrix_ : matrix_; }
+
     const Config& config_;
 
     // NOTE : Matrix-free or non-linear interpolation operators do not have
@@ -58,8 +80,43 @@ protected:
     //        so do not expose here, even though only linear operators are now
     //        implemented.
     Matrix matrix_;
+
+    // Matrix shared with the MatrixCache, used instead of matrix_ when set
+    std::shared_ptr<const Matrix> shared_matrix_;
 };
 
+template <typename Compute>
+void Method::compute_triplets( size_t size, Triplets& triplets, const Compute& compute ) {
+    const size_t nb_threads = atlas_omp_get_max_threads();
+    std::vector<Triplets> thread_triplets( nb_threads );
+    std::vector<std::exception_ptr> thread_errors( nb_threads );
+    atlas_omp_parallel {
+        const size_t nthreads = atlas_omp_get_num_threads();
+        const size_t thread   = atlas_omp_get_thread_num();
+        const size_t begin    = ( size * thread ) / nthreads;
+        const size_t end      = ( size * ( thread + 1 ) ) / nthreads;
+        try {
+            compute( thread, begin, end, thread_triplets[thread] );
+        }
+        catch ( ... ) {
+            thread_errors[thread] = std::current_exception();
+        }
+    }
+    for ( const std::exception_ptr& error : thread_errors ) {
+        if ( error ) { std::rethrow_exception( error ); }
+    }
+
+    size_t nb_triplets = 0;
+    for ( const Triplets& t : thread_triplets ) {
+        nb_triplets += t.size();
+    }
+    triplets.clear();
+    triplets.reserve( nb_triplets );
+    for ( const Triplets& t : thread_triplets ) {
+        triplets.insert( triplets.end(), t.begin(), t.end() );
+    }
+}
+
 struct MethodFactory {
     static Method* build( const std::string& name, const Method::Config& );
 
@@ -8,12 +8,16 @@
  * nor does it submit to any jurisdiction. and Interpolation
  */
 
+#include <algorithm>
+
+#include "eckit/log/BigNum.h"
 #include "eckit/log/Plural.h"
 
 #include "atlas/functionspace/NodeColumns.h"
 #include "atlas/interpolation/method/NearestNeighbour.h"
 #include "atlas/mesh/Nodes.h"
 #include "atlas/mesh/actions/BuildXYZField.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
 
@@ -38,7 +42,7 @@ void NearestNeighbour::setup( const FunctionSpace& source, const FunctionSpace&
 
     // build point-search tree
     buildPointSearchTree( meshSource );
-    ASSERT( pTree_ );
+    ASSERT( not pTrees_.empty() );
 
     // generate 3D point coordinates
     mesh::actions::BuildXYZField( "xyz" )( meshTarget );
@@ -49,24 +53,26 @@ void NearestNeighbour::setup( const FunctionSpace& source, const FunctionSpace&
 
     // fill the sparse matrix
     std::vector<Triplet> weights_triplets;
-    weights_triplets.reserve( out_npts );
     {
         Trace timer( Here(), "atlas::interpolation::method::NearestNeighbour::setup()" );
-        for ( size_t ip = 0; ip < out_npts; ++ip ) {
-            if ( ip && ( ip % 1000 == 0 ) ) {
-                double rate = ip / timer.elapsed();
-                Log::debug() << eckit::BigNum( ip ) << " (at " << rate << " points/s)..." << std::endl;
+        compute_triplets( out_npts, weights_triplets, [&]( size_t thread, size_t begin, size_t end,
+                                                           Triplets& triplets ) {
+            triplets.reserve( end - begin );
+            PointIndex3& tree = pTrees_[thread];
+
+            for ( size_t ip = begin; ip < end; ++ip ) {
+                // find the closest input point to the output point
+                PointIndex3::Point p{coords( ip, 0 ), coords( ip, 1 ), coords( ip, 2 )};
+                size_t jp = tree.nearestNeighbour( p ).payload();
+
+                // insert the weights into the interpolant matrix
+                ASSERT( jp < inp_npts );
+                triplets.push_back( Triplet( ip, jp, 1 ) );
             }
-
-            // find the closest input point to the output point
-            PointIndex3::Point p{coords( ip, 0 ), coords( ip, 1 ), coords( ip, 2 )};
-            PointIndex3::NodeInfo nn = pTree_->nearestNeighbour( p );
-            size_t jp                = nn.payload();
-
-            // insert the weights into the interpolant matrix
-            ASSERT( jp < inp_npts );
-            weights_triplets.push_back( Triplet( ip, jp, 1 ) );
-        }
+        } );
+        timer.stop();
+        Log::debug() << eckit::BigNum( out_npts ) << " points (at " << out_npts / std::max( timer.elapsed(), 1.e-9 )
+                     << " points/s)" << std::endl;
     }
 
     // fill sparse matrix and return
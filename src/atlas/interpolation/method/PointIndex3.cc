@@ -48,6 +48,19 @@ ElemIndex3* create_element_kdtree( const Field& field_centres ) {
     return tree;
 }
 
+void create_element_kdtrees( const Field& field_centres, ThreadKdTrees<ElemIndex3>& trees ) {
+    const array::ArrayView<double, 2> centres = array::make_view<double, 2>( field_centres );
+    const size_t nb_cells                     = centres.shape( 0 );
+
+    std::vector<ElemIndex3::Value> p;
+    p.reserve( nb_cells );
+    for ( size_t j = 0; j < nb_cells; ++j ) {
+        p.push_back( ElemIndex3::Value( ElemIndex3::Point( centres( j, XX ), centres( j, YY ), centres( j, ZZ ) ),
+                                        ElemIndex3::Payload( j ) ) );
+    }
+    trees.build( p );
+}
+
 ElemIndex3* create_element_centre_index( const Mesh& mesh ) {
     return create_element_kdtree( mesh.cells().field( "centre" ) );
 }
@@ -10,6 +10,10 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
+#include "eckit/config/Resource.h"
 #include "eckit/container/KDMapped.h"
 #include "eckit/container/KDMemory.h"
 #include "eckit/container/KDTree.h"
@@ -17,6 +21,7 @@
 
 #include "atlas/field/Field.h"
 #include "atlas/mesh/Mesh.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/util/CoordinateEnums.h"
 
 namespace atlas {
@@ -51,6 +56,49 @@ public:
 
 //----------------------------------------------------------------------------------------------------------------------
 
+/// Kd-trees of the same values, one for each OpenMP thread
+///
+/// Searching an eckit kd-tree updates state shared by all searches of the tree, so threads cannot search one
+/// tree concurrently. The trees are built in parallel, from the same values in the same order, so they are
+/// identical and a thread finds the same neighbours as a single thread would. Memory grows with the number
+/// of threads, building them takes about as long as building one tree.
+template <typename Tree>
+class ThreadKdTrees {
+public:
+    typedef typename Tree::Value Value;
+
+    /// Build a tree for each of atlas_omp_get_max_threads() threads
+    void build( const std::vector<Value>& values ) {
+        static bool fastBuildKDTrees = eckit::Resource<bool>( "$ATLAS_FAST_BUILD_KDTREES", true );
+
+        const size_t nb_threads = size_t( atlas_omp_get_max_threads() );
+        trees_.clear();
+        trees_.resize( nb_threads );
+        atlas_omp_parallel_for( size_t t = 0; t < nb_threads; ++t ) {
+            trees_[t].reset( new Tree() );
+            if ( fastBuildKDTrees ) {
+                std::vector<Value> v( values );  // building reorders the values
+                trees_[t]->build( v.begin(), v.end() );
+            }
+            else {
+                for ( const Value& value : values ) {
+                    trees_[t]->insert( value );
+                }
+            }
+        }
+    }
+
+    bool empty() const { return trees_.empty(); }
+
+    /// Tree to be searched by thread
+    Tree& operator[]( size_t thread ) { return *trees_.at( thread ); }
+
+private:
+    std::vector<std::unique_ptr<Tree>> trees_;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
 struct PointIndex3TreeTrait {
     typedef eckit::geometry::Point3 Point;
     typedef size_t Payload;
@@ -69,6 +117,9 @@ typedef PointKdTree<ElemIndex3TreeTrait> ElemIndex3;
 
 ElemIndex3* create_element_kdtree( const Field& field_centres );
 
+/// Build a tree of element centres for each thread
+void create_element_kdtrees( const Field& field_centres, ThreadKdTrees<ElemIndex3>& trees );
+
 // TODO: remove this function, and use "create_element_kdtree(const Field&)"
 // instead.
 ElemIndex3* create_element_centre_index( const Mesh& mesh );
@@ -0,0 +1,289 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+#include "atlas/interpolation/method/StructuredInterpolation.h"
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/log/BigNum.h"
+#include "eckit/mpi/Comm.h"
+
+#include "atlas/array/ArrayView.h"
+#include "atlas/functionspace/NodeColumns.h"
+#include "atlas/functionspace/PointCloud.h"
+#include "atlas/functionspace/StructuredColumns.h"
+#include "atlas/mesh/Nodes.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/CoordinateEnums.h"
+
+namespace atlas {
+namespace interpolation {
+namespace method {
+
+namespace {
+
+MethodBuilder<StructuredBilinear> __builder_bilinear( "structured-bilinear" );
+MethodBuilder<StructuredBicubic> __builder_bicubic( "structured-bicubic" );
+
+static const idx_t max_stencil_width = 4;
+
+/// Lagrange weights at position s of the polynomial through nodes s_[0..n)
+void lagrange_weights( idx_t n, const double s_[], double s, double w[] ) {
+    for ( idx_t k = 0; k < n; ++k ) {
+        double wk = 1.;
+        for ( idx_t m = 0; m < n; ++m ) {
+            if ( m != k ) { wk *= ( s - s_[m] ) / ( s_[k] - s_[m] ); }
+        }
+        w[k] = wk;
+    }
+}
+
+/// Computes the tensor-product stencil of a point in the (halo-extended) rows of a StructuredColumns.
+/// Rows j < 0 and j >= ny are the rows reflected across the poles, with latitude 180-y resp. -180-y
+/// and with the longitudes of the row they reflect, as in the StructuredColumns halo.
+class Stencil {
+public:
+    Stencil( const functionspace::StructuredColumns& fs, idx_t width ) :
+        fs_( fs ),
+        width_( width ),
+        size_( fs.size() ),
+        ny_( fs.grid().ny() ),
+        j_begin_halo_( fs.j_begin_halo() ),
+        j_end_halo_( fs.j_end_halo() ),
+        periodic_( fs.grid().periodic() ) {
+        ASSERT( width_ >= 2 && width_ <= max_stencil_width && width_ % 2 == 0 );
+
+        const grid::StructuredGrid& grid = fs.grid();
+        grid_y_.resize( ny_ );
+        for ( idx_t j = 0; j < ny_; ++j ) {
+            grid_y_[j] = grid.y( j );
+        }
+
+        const idx_t nrows = j_end_halo_ - j_begin_halo_;
+        y_.resize( nrows );
+        xmin_.resize( nrows );
+        dx_.resize( nrows );
+        nx_.resize( nrows );
+        for ( idx_t j = j_begin_halo_; j < j_end_halo_; ++j ) {
+            const idx_t jj = reflect( j );
+            const idx_t r  = j - j_begin_halo_;
+            y_[r]          = ( j < 0 ) ? 180. - grid_y_[jj] : ( j >= ny_ ) ? -180. - grid_y_[jj] : grid_y_[jj];
+            nx_[r]         = grid.nx( jj );
+            xmin_[r]       = grid.x( 0, jj );
+            dx_[r]         = ( nx_[r] > 1 ) ? grid.x( 1, jj ) - grid.x( 0, jj ) : 360.;
+        }
+    }
+
+    /// Append the width x width weights of point ip to triplets.
+    /// @return false, leaving triplets untouched, if the stencil is not contained in the halo
+    bool compute( size_t ip, double lon, double lat, std::vector<eckit::linalg::Triplet>& triplets ) const {
+        const idx_t h  = width_ / 2 - 1;  // stencil points before the containing cell
+        const idx_t j0 = row( lat );
+        if ( j0 - h < j_begin_halo_ || j0 - h + width_ > j_end_halo_ ) { return false; }
+
+        double nodes[max_stencil_width];
+        double wy[max_stencil_width];
+        double wx[max_stencil_width];
+        idx_t index[max_stencil_width * max_stencil_width];
+        double weight[max_stencil_width * max_stencil_width];
+
+        for ( idx_t k = 0; k < width_; ++k ) {
+            nodes[k] = y_[j0 - h + k - j_begin_halo_];
+        }
+        lagrange_weights( width_, nodes, lat, wy );
+
+        for ( idx_t m = 0; m < width_; ++m ) {
+            nodes[m] = m;
+        }
+        for ( idx_t k = 0; k < width_; ++k ) {
+            const idx_t j = j0 - h + k;
+            const idx_t r = j - j_begin_halo_;
+            double xi     = ( lon - xmin_[r] ) / dx_[r];
+            if ( periodic_ ) { xi -= nx_[r] * std::floor( xi / nx_[r] ); }
+            idx_t i0 = static_cast<idx_t>( std::floor( xi ) );
+
+            const idx_t i_begin = fs_.i_begin_halo( j );
+            const idx_t i_end   = fs_.i_end_halo( j );
+            if ( periodic_ ) {
+                if ( i0 - h < i_begin ) { i0 += nx_[r]; }
+                else if ( i0 - h + width_ > i_end ) {
+                    i0 -= nx_[r];
+                }
+            }
+            if ( i0 - h < i_begin || i0 - h + width_ > i_end ) { return false; }
+
+            lagrange_weights( width_, nodes, xi - i0 + h, wx );
+            for ( idx_t m = 0; m < width_; ++m ) {
+                const idx_t n = fs_.index( i0 - h + m, j );
+                if ( n < 0 || size_t( n ) >= size_ ) { return false; }
+                index[k * width_ + m]  = n;
+                weight[k * width_ + m] = wy[k] * wx[m];
+            }
+        }
+        for ( idx_t n = 0; n < width_ * width_; ++n ) {
+            triplets.emplace_back( ip, index[n], weight[n] );
+        }
+        return true;
+    }
+
+private:
+    /// Row jj of the grid that row j reflects across the poles
+    idx_t reflect( idx_t j ) const {
+        while ( j < 0 || j >= ny_ ) {
+            if ( j < 0 ) { j = ( grid_y_[0] == 90. ) ? -j : -j - 1; }
+            else {
+                const idx_t jlast = ny_ - 1;
+                j = ( grid_y_[jlast] == -90. ) ? jlast - 1 - ( j - ny_ ) : jlast - ( j - ny_ );
+            }
+        }
+        return j;
+    }
+
+    /// Row j0 such that y(j0) >= lat > y(j0+1), possibly in the extended rows.
+    /// The first guess assumes equally spaced rows, which is close for gaussian latitudes too.
+    idx_t row( double lat ) const {
+        if ( lat > grid_y_[0] ) { return -1; }
+        if ( lat < grid_y_[ny_ - 1] || ny_ == 1 ) { return ny_ - 1; }
+        const double y0 = grid_y_[0];
+        const double y1 = grid_y_[ny_ - 1];
+        idx_t j         = ( y0 != y1 ) ? static_cast<idx_t>( ( y0 - lat ) / ( y0 - y1 ) * ( ny_ - 1 ) ) : 0;
+        j               = std::max<idx_t>( 0, std::min<idx_t>( j, ny_ - 2 ) );
+        while ( j > 0 && grid_y_[j] < lat ) {
+            --j;
+        }
+        while ( j < ny_ - 2 && grid_y_[j + 1] >= lat ) {
+            ++j;
+        }
+        return j;
+    }
+
+    const functionspace::StructuredColumns& fs_;
+    idx_t width_;
+    size_t size_;
+    idx_t ny_;
+    idx_t j_begin_halo_;
+    idx_t j_end_halo_;
+    bool periodic_;
+    std::vector<double> grid_y_;
+    std::vector<double> y_;
+    std::vector<double> xmin_;
+    std::vector<double> dx_;
+    std::vector<idx_t> nx_;
+};
+
+}  // namespace
+
+void StructuredInterpolation::setup( const FunctionSpace& source, const FunctionSpace& target ) {
+    ATLAS_TRACE( "atlas::interpolation::method::StructuredInterpolation::setup()" );
+
+    const functionspace::StructuredColumns src = source;
+    if ( not src ) { throw eckit::NotImplemented( "Source functionspace must be StructuredColumns", Here() ); }
+    if ( src.grid().projection() ) {
+        throw eckit::NotImplemented( "StructuredInterpolation from a projected grid", Here() );
+    }
+
+    // Target points as (lon,lat), with points that need no weights flagged as ghost
+    std::vector<double> lonlat;
+    std::vector<int> ghost;
+    if ( functionspace::NodeColumns tgt = target ) {
+        auto ll = array::make_view<double, 2>( tgt.nodes().lonlat() );
+        auto g  = array::make_view<int, 1>( tgt.nodes().ghost() );
+        lonlat.resize( 2 * ll.shape( 0 ) );
+        ghost.resize( ll.shape( 0 ) );
+        for ( size_t n = 0; n < ghost.size(); ++n ) {
+            lonlat[2 * n + LON] = ll( n, LON );
+            lonlat[2 * n + LAT] = ll( n, LAT );
+            ghost[n]            = g( n );
+        }
+    }
+    else if ( functionspace::PointCloud tgt = target ) {
+        auto ll = array::make_view<double, 2>( tgt.lonlat() );
+        auto g  = array::make_view<int, 1>( tgt.ghost() );
+        lonlat.resize( 2 * tgt.size() );
+        ghost.resize( tgt.size() );
+        for ( size_t n = 0; n < ghost.size(); ++n ) {
+            lonlat[2 * n + LON] = ll( n, LON );
+            lonlat[2 * n + LAT] = ll( n, LAT );
+            ghost[n]            = g( n );
+        }
+    }
+    else if ( functionspace::StructuredColumns tgt = target ) {
+        // Owned points come first; halo points are filled by a halo exchange of the target
+        auto xy = array::make_view<double, 2>( tgt.xy() );
+        lonlat.resize( 2 * tgt.size() );
+        ghost.assign( tgt.size(), 1 );
+        for ( size_t n = 0; n < tgt.sizeOwned(); ++n ) {
+            lonlat[2 * n + LON] = xy( n, XX );
+            lonlat[2 * n + LAT] = xy( n, YY );
+            ghost[n]            = 0;
+        }
+        if ( tgt.grid().projection() ) {
+            tgt.grid().projection().xy2lonlat( tgt.sizeOwned(), lonlat.data(), lonlat.data() );
+        }
+    }
+    else {
+        NOTIMP;
+    }
+
+    const Stencil stencil( src, stencil_width_ );
+
+    const size_t inp_npts = src.size();
+    const size_t out_npts = ghost.size();
+
+    const size_t nb_threads = atlas_omp_get_max_threads();
+    std::vector<std::vector<size_t>> thread_failures( nb_threads );
+    Triplets triplets;
+    {
+        Trace timer( Here(), "Computing interpolation weights" );
+        compute_triplets( out_npts, triplets, [&]( size_t thread, size_t begin, size_t end,
+                                                   Triplets& thread_triplets ) {
+            thread_triplets.reserve( ( end - begin ) * stencil_width_ * stencil_width_ );
+
+            for ( size_t ip = begin; ip < end; ++ip ) {
+                if ( ghost[ip] ) { continue; }
+                if ( not stencil.compute( ip, lonlat[2 * ip + LON], lonlat[2 * ip + LAT], thread_triplets ) ) {
+                    thread_failures[thread].push_back( ip );
+                }
+            }
+        } );
+        timer.stop();
+        Log::debug() << eckit::BigNum( out_npts ) << " points (at " << out_npts / std::max( timer.elapsed(), 1.e-9 )
+                     << " points/s)" << std::endl;
+    }
+
+    std::vector<size_t> failures;
+    for ( size_t thread = 0; thread < nb_threads; ++thread ) {
+        failures.insert( failures.end(), thread_failures[thread].begin(), thread_failures[thread].end() );
+    }
+
+    if ( failures.size() ) {
+        std::ostringstream msg;
+        msg << "Rank " << eckit::mpi::comm().rank() << " has target points outside the source halo:\n";
+        for ( size_t ip : failures ) {
+            msg << "\t(lon,lat) = (" << lonlat[2 * ip + LON] << "," << lonlat[2 * ip + LAT] << ")\n";
+        }
+        Log::error() << msg.str() << std::endl;
+        throw eckit::SeriousBug( msg.str(), Here() );
+    }
+
+    // fill sparse matrix and return
+    Matrix A( out_npts, inp_npts, triplets );
+    matrix_.swap( A );
+}
+
+}  // namespace method
+}  // namespace interpolation
+}  // namespace atlas
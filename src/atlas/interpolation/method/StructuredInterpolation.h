@@ -0,0 +1,68 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include "atlas/interpolation/method/Method.h"
+
+#include "atlas/library/config.h"
+
+namespace atlas {
+namespace interpolation {
+namespace method {
+
+/**
+ * @brief Tensor-product interpolation from a functionspace::StructuredColumns
+ *
+ * The stencil of each target point is located directly from the row latitudes and the
+ * longitude spacing of each row, without any search tree. Rows beyond the poles are
+ * addressed as in the StructuredColumns halo, so that points near the poles or near a
+ * partition boundary are interpolated from halo values. The halo of the source
+ * functionspace must be at least as wide as half the stencil, and source fields must be
+ * halo-exchanged before execute().
+ *
+ * The weights are stored as a sparse matrix, so that execute() applies them to all levels
+ * and variables of the given fields.
+ */
+class StructuredInterpolation : public Method {
+public:
+    StructuredInterpolation( const Config& config, idx_t stencil_width ) :
+        Method( config ),
+        stencil_width_( stencil_width ) {}
+
+    virtual ~StructuredInterpolation() {}
+
+    /**
+     * @brief Create the interpolant sparse matrix
+     * @param source functionspace::StructuredColumns of an unprojected grid
+     * @param target functionspace::NodeColumns, functionspace::PointCloud or
+     *        functionspace::StructuredColumns containing target points
+     */
+    virtual void setup( const FunctionSpace& source, const FunctionSpace& target ) override;
+
+private:
+    idx_t stencil_width_;
+};
+
+/// @brief Bilinear interpolation on a 2x2 stencil
+class StructuredBilinear : public StructuredInterpolation {
+public:
+    StructuredBilinear( const Config& config ) : StructuredInterpolation( config, 2 ) {}
+};
+
+/// @brief Bicubic (Lagrange) interpolation on a 4x4 stencil
+class StructuredBicubic : public StructuredInterpolation {
+public:
+    StructuredBicubic( const Config& config ) : StructuredInterpolation( config, 4 ) {}
+};
+
+}  // namespace method
+}  // namespace interpolation
+}  // namespace atlas
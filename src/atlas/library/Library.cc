@@ -10,6 +10,7 @@
 
 
 #include "eckit/eckit_config.h"
+#include "eckit/exception/Exceptions.h"
 #include "eckit/filesystem/LocalPathName.h"
 #include "eckit/filesystem/PathName.h"
 #include "eckit/log/Log.h"
@@ -25,6 +26,7 @@
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
+#include "atlas/runtime/trace/Timeline.h"
 #include "atlas/util/Config.h"
 
 #if ATLAS_HAVE_TRANS
@@ -62,6 +64,11 @@ int getEnv( const std::string& env, int default_value ) {
     return default_value;
 }
 
+std::string getEnv( const std::string& env, const std::string& default_value ) {
+    if (::getenv( env.c_str() ) ) { return ::getenv( env.c_str() ); }
+    return default_value;
+}
+
 }  // namespace
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -74,7 +81,11 @@ Library::Library() :
     info_( getEnv( "ATLAS_INFO", true ) ),
     trace_( getEnv( "ATLAS_TRACE", false ) ),
     trace_report_( getEnv( "ATLAS_TRACE_REPORT", false ) ),
-    trace_barriers_( getEnv( "ATLAS_TRACE_BARRIERS", false ) ) {}
+    trace_barriers_( getEnv( "ATLAS_TRACE_BARRIERS", false ) ),
+    trace_timeline_( getEnv( "ATLAS_TRACE_TIMELINE", false ) ),
+    trace_timeline_size_( getEnv( "ATLAS_TRACE_TIMELINE_SIZE", 100000 ) ),
+    trace_timeline_file_( getEnv( "ATLAS_TRACE_TIMELINE_FILE", std::string( "atlas_trace" ) ) ),
+    interpolation_matrix_cache_size_( getEnv( "ATLAS_INTERPOLATION_MATRIX_CACHE_SIZE", 8 ) ) {}
 
 Library& Library::instance() {
     return libatlas;
@@ -119,6 +130,12 @@ void Library::initialise( const eckit::Parametrisation& config ) {
     if ( config.has( "trace" ) ) {
         config.get( "trace.barriers", trace_barriers_ );
         config.get( "trace.report", trace_report_ );
+        config.get( "trace.timeline", trace_timeline_ );
+        config.get( "trace.timeline_size", trace_timeline_size_ );
+        config.get( "trace.timeline_file", trace_timeline_file_ );
+    }
+    if ( config.has( "interpolation" ) ) {
+        config.get( "interpolation.matrix_cache_size", interpolation_matrix_cache_size_ );
     }
 
     if ( not debug_ ) debug_channel_.reset();
@@ -142,6 +159,7 @@ void Library::initialise( const eckit::Parametrisation& config ) {
         out << "  log.debug       [" << str( debug() ) << "] \n";
         out << "  trace.barriers  [" << str( traceBarriers() ) << "] \n";
         out << "  trace.report    [" << str( trace_report_ ) << "] \n";
+        out << "  trace.timeline  [" << str( trace_timeline_ ) << "] \n";
         out << " \n";
         out << atlas::Library::instance().information();
         out << std::flush;
@@ -154,6 +172,15 @@ void Library::initialise() {
 
 void Library::finalise() {
     if ( ATLAS_HAVE_TRACE && trace_report_ ) { Log::info() << atlas::Trace::report() << std::endl; }
+    if ( ATLAS_HAVE_TRACE && trace_timeline_ ) {
+        // Failing to write the timeline should not make finalisation fail
+        try {
+            runtime::trace::Timeline::write( trace_timeline_file_ );
+        }
+        catch ( const eckit::CantOpenFile& e ) {
+            Log::warning() << "Trace timeline could not be written: " << e.what() << std::endl;
+        }
+    }
 
     // Make sure that these specialised channels that wrap Log::info() are
     // destroyed before eckit::Log::info gets destroyed.
@@ -57,6 +57,12 @@ public:
 
     bool traceBarriers() const { return trace_barriers_; }
 
+    bool traceTimeline() const { return trace_timeline_; }
+    int traceTimelineSize() const { return trace_timeline_size_; }
+    const std::string& traceTimelineFile() const { return trace_timeline_file_; }
+
+    int interpolationMatrixCacheSize() const { return interpolation_matrix_cache_size_; }
+
 protected:
     virtual const void* addr() const override;
 
@@ -65,6 +71,10 @@ protected:
     bool debug_{false};
     bool trace_barriers_{false};
     bool trace_report_{false};
+    bool trace_timeline_{false};
+    int trace_timeline_size_{100000};
+    std::string trace_timeline_file_{"atlas_trace"};
+    int interpolation_matrix_cache_size_{8};
     mutable std::unique_ptr<eckit::Channel> info_channel_;
     mutable std::unique_ptr<eckit::Channel> trace_channel_;
     mutable std::unique_ptr<eckit::Channel> debug_channel_;
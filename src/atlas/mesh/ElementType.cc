@@ -8,6 +8,8 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include "eckit/exception/Exceptions.h"
+
 #include "atlas/mesh/ElementType.h"
 #include "atlas/runtime/ErrorHandling.h"
 #include "atlas/util/CoordinateEnums.h"
@@ -17,9 +19,11 @@ namespace mesh {
 
 //------------------------------------------------------------------------------
 
-ElementType* ElementType::create( const std::string& ) {
-    NOTIMP;
-    return 0;
+ElementType* ElementType::create( const std::string& name ) {
+    if ( name == "Quadrilateral" ) { return new temporary::Quadrilateral(); }
+    if ( name == "Triangle" ) { return new temporary::Triangle(); }
+    if ( name == "Line" ) { return new temporary::Line(); }
+    throw eckit::BadParameter( "ElementType '" + name + "' not recognised", Here() );
 }
 
 ElementType::ElementType() {}
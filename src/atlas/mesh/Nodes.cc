@@ -9,6 +9,9 @@
  */
 
 #include "atlas/mesh/Nodes.h"
+
+#include <iterator>
+
 #include "atlas/array/MakeView.h"
 #include "atlas/field/Field.h"
 #include "atlas/parallel/mpi/mpi.h"
@@ -131,6 +134,17 @@ Field& Nodes::field( size_t idx ) {
     return const_cast<Field&>( static_cast<const Nodes*>( this )->field( idx ) );
 }
 
+const IrregularConnectivity& Nodes::connectivity( size_t idx ) const {
+    ASSERT( idx < nb_connectivities() );
+    ConnectivityMap::const_iterator it = connectivities_.begin();
+    std::advance( it, idx );
+    return *it->second;
+}
+
+IrregularConnectivity& Nodes::connectivity( size_t idx ) {
+    return const_cast<IrregularConnectivity&>( static_cast<const Nodes*>( this )->connectivity( idx ) );
+}
+
 void Nodes::print( std::ostream& os ) const {
     os << "Nodes[\n";
     os << "\t size=" << size() << ",\n";
@@ -101,6 +101,10 @@ public:  // methods
 
     bool has_connectivity( std::string name ) const { return connectivities_.count( name ); }
 
+    const Connectivity& connectivity( size_t ) const;
+    Connectivity& connectivity( size_t );
+    size_t nb_connectivities() const { return connectivities_.size(); }
+
     size_t size() const { return size_; }
 
     // -- Modifiers
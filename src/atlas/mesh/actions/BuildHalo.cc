@@ -8,8 +8,10 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <stdexcept>
 
@@ -25,6 +27,8 @@
 #include "atlas/mesh/actions/BuildParallelFields.h"
 #include "atlas/mesh/detail/AccumulateFacets.h"
 #include "atlas/mesh/detail/PeriodicTransform.h"
+#include "atlas/mesh/detail/RenumberGlobalIndex.h"
+#include "atlas/mesh/detail/Uid2Node.h"
 #include "atlas/parallel/mpi/Buffer.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/runtime/ErrorHandling.h"
@@ -34,6 +38,7 @@
 #include "atlas/util/LonLatMicroDeg.h"
 #include "atlas/util/MicroDeg.h"
 #include "atlas/util/Unique.h"
+#include "atlas/util/detail/FlatHashMap.h"
 
 //#define DEBUG_OUTPUT
 #ifdef DEBUG_OUTPUT
@@ -56,16 +61,6 @@ namespace atlas {
 namespace mesh {
 namespace actions {
 
-struct Entity {
-    Entity( gidx_t gid, int idx ) {
-        g = gid;
-        i = idx;
-    }
-    gidx_t g;
-    gidx_t i;
-    bool operator<( const Entity& other ) const { return ( g < other.g ); }
-};
-
 void make_nodes_global_index_human_readable( const mesh::actions::BuildHalo& build_halo, mesh::Nodes& nodes,
                                              bool do_all ) {
     ATLAS_TRACE();
@@ -74,10 +69,6 @@ void make_nodes_global_index_human_readable( const mesh::actions::BuildHalo& bui
     // uid,
     //     and could receive different gidx for different tasks
 
-    // unused // int mypart = mpi::comm().rank();
-    int nparts  = mpi::comm().size();
-    size_t root = 0;
-
     array::ArrayView<gidx_t, 1> nodes_glb_idx = array::make_view<gidx_t, 1>( nodes.global_index() );
     // nodes_glb_idx.dump( Log::info() );
     //  ATLAS_DEBUG( "min = " << nodes.global_index().metadata().getLong("min") );
@@ -124,46 +115,8 @@ void make_nodes_global_index_human_readable( const mesh::actions::BuildHalo& bui
     //    }
     //  }
 
-    // 1) Gather all global indices, together with location
-
-    std::vector<int> recvcounts( mpi::comm().size() );
-    std::vector<int> recvdispls( mpi::comm().size() );
-
-    ATLAS_TRACE_MPI( GATHER ) { mpi::comm().gather( nb_nodes, recvcounts, root ); }
-    int glb_nb_nodes = std::accumulate( recvcounts.begin(), recvcounts.end(), 0 );
-
-    recvdispls[0] = 0;
-    for ( int jpart = 1; jpart < nparts; ++jpart ) {  // start at 1
-        recvdispls[jpart] = recvcounts[jpart - 1] + recvdispls[jpart - 1];
-    }
-
-    std::vector<gidx_t> glb_idx_gathered( glb_nb_nodes );
-    ATLAS_TRACE_MPI( GATHER ) {
-        mpi::comm().gatherv( glb_idx.data(), glb_idx.size(), glb_idx_gathered.data(), recvcounts.data(),
-                             recvdispls.data(), root );
-    }
-
-    // 2) Sort all global indices, and renumber from 1 to glb_nb_edges
-    std::vector<Entity> node_sort;
-    node_sort.reserve( glb_nb_nodes );
-    for ( size_t jnode = 0; jnode < glb_idx_gathered.size(); ++jnode ) {
-        node_sort.push_back( Entity( glb_idx_gathered[jnode], jnode ) );
-    }
-
-    ATLAS_TRACE_SCOPE( "sort on rank 0" ) { std::sort( node_sort.begin(), node_sort.end() ); }
-
-    gidx_t gid = glb_idx_max + 1;
-    for ( size_t jnode = 0; jnode < node_sort.size(); ++jnode ) {
-        if ( jnode > 0 && node_sort[jnode].g != node_sort[jnode - 1].g ) { ++gid; }
-        int inode               = node_sort[jnode].i;
-        glb_idx_gathered[inode] = gid;
-    }
-
-    // 3) Scatter renumbered back
-    ATLAS_TRACE_MPI( SCATTER ) {
-        mpi::comm().scatterv( glb_idx_gathered.data(), recvcounts.data(), recvdispls.data(), glb_idx.data(),
-                              glb_idx.size(), root );
-    }
+    // Renumber from glb_idx_max+1, following the order of the global indices
+    mesh::detail::renumber_global_index( glb_idx, glb_idx_max + 1 );
 
     for ( int jnode = 0; jnode < nb_nodes; ++jnode ) {
         nodes_glb_idx( points_to_edit[jnode] ) = glb_idx[jnode];
@@ -180,9 +133,6 @@ void make_cells_global_index_human_readable( const mesh::actions::BuildHalo& bui
                                              bool do_all ) {
     ATLAS_TRACE();
 
-    int nparts  = mpi::comm().size();
-    size_t root = 0;
-
     array::ArrayView<gidx_t, 1> cells_glb_idx = array::make_view<gidx_t, 1>( cells.global_index() );
     //  ATLAS_DEBUG( "min = " << cells.global_index().metadata().getLong("min") );
     //  ATLAS_DEBUG( "max = " << cells.global_index().metadata().getLong("max") );
@@ -209,46 +159,8 @@ void make_cells_global_index_human_readable( const mesh::actions::BuildHalo& bui
     for ( size_t i = 0; i < nb_cells; ++i )
         glb_idx[i] = cells_glb_idx( cells_to_edit[i] );
 
-    // 1) Gather all global indices, together with location
-
-    std::vector<int> recvcounts( mpi::comm().size() );
-    std::vector<int> recvdispls( mpi::comm().size() );
-
-    ATLAS_TRACE_MPI( GATHER ) { mpi::comm().gather( nb_cells, recvcounts, root ); }
-    int glb_nb_cells = std::accumulate( recvcounts.begin(), recvcounts.end(), 0 );
-
-    recvdispls[0] = 0;
-    for ( int jpart = 1; jpart < nparts; ++jpart ) {  // start at 1
-        recvdispls[jpart] = recvcounts[jpart - 1] + recvdispls[jpart - 1];
-    }
-
-    std::vector<gidx_t> glb_idx_gathered( glb_nb_cells );
-    ATLAS_TRACE_MPI( GATHER ) {
-        mpi::comm().gatherv( glb_idx.data(), glb_idx.size(), glb_idx_gathered.data(), recvcounts.data(),
-                             recvdispls.data(), root );
-    }
-
-    // 2) Sort all global indices, and renumber from 1 to glb_nb_edges
-    std::vector<Entity> cell_sort;
-    cell_sort.reserve( glb_nb_cells );
-    for ( size_t jnode = 0; jnode < glb_idx_gathered.size(); ++jnode ) {
-        cell_sort.push_back( Entity( glb_idx_gathered[jnode], jnode ) );
-    }
-
-    ATLAS_TRACE_SCOPE( "sort on rank 0" ) { std::sort( cell_sort.begin(), cell_sort.end() ); }
-
-    gidx_t gid = glb_idx_max + 1;
-    for ( size_t jcell = 0; jcell < cell_sort.size(); ++jcell ) {
-        if ( jcell > 0 && cell_sort[jcell].g != cell_sort[jcell - 1].g ) { ++gid; }
-        int icell               = cell_sort[jcell].i;
-        glb_idx_gathered[icell] = gid;
-    }
-
-    // 3) Scatter renumbered back
-    ATLAS_TRACE_MPI( SCATTER ) {
-        mpi::comm().scatterv( glb_idx_gathered.data(), recvcounts.data(), recvdispls.data(), glb_idx.data(),
-                              glb_idx.size(), root );
-    }
+    // Renumber from glb_idx_max+1, following the order of the global indices
+    mesh::detail::renumber_global_index( glb_idx, glb_idx_max + 1 );
 
     for ( int jcell = 0; jcell < nb_cells; ++jcell ) {
         cells_glb_idx( cells_to_edit[jcell] ) = glb_idx[jcell];
@@ -369,67 +281,11 @@ std::vector<int> filter_nodes( std::vector<int> nodes, const Predicate& predicat
     return filtered;
 }
 
-class Notification {
-public:
-    void add_error( const std::string& note, const eckit::CodeLocation& loc ) {
-        notes.push_back( note + " @ " + std::string( loc ) );
-    }
-    void add_error( const std::string& note ) { notes.push_back( note ); }
-
-    bool error() const { return notes.size() > 0; }
-    void reset() { notes.clear(); }
-
-    std::string str() const {
-        std::stringstream stream;
-        for ( size_t jnote = 0; jnote < notes.size(); ++jnote ) {
-            if ( jnote > 0 ) stream << "\n";
-            stream << notes[jnote];
-        }
-        return stream.str();
-    }
-
-    operator std::string() const { return str(); }
-
-private:
-    friend std::ostream& operator<<( std::ostream& s, const Notification& notes ) {
-        s << notes.str();
-        return s;
-    }
-
-private:
-    std::vector<std::string> notes;
-};
-
-typedef std::map<uid_t, int> Uid2Node;
-void build_lookup_uid2node( Mesh& mesh, Uid2Node& uid2node ) {
-    ATLAS_TRACE();
-    Notification notes;
-    mesh::Nodes& nodes                  = mesh.nodes();
-    array::ArrayView<double, 2> xy      = array::make_view<double, 2>( nodes.xy() );
-    array::ArrayView<gidx_t, 1> glb_idx = array::make_view<gidx_t, 1>( nodes.global_index() );
-    size_t nb_nodes                     = nodes.size();
-
-    UniqueLonLat compute_uid( mesh );
-
-    uid2node.clear();
-    for ( size_t jnode = 0; jnode < nb_nodes; ++jnode ) {
-        uid_t uid     = compute_uid( jnode );
-        bool inserted = uid2node.insert( std::make_pair( uid, jnode ) ).second;
-        if ( not inserted ) {
-            int other = uid2node[uid];
-            std::stringstream msg;
-            msg << "Node uid: " << uid << "   " << glb_idx( jnode ) << " (" << xy( jnode, XX ) << "," << xy( jnode, YY )
-                << ")  has already been added as node " << glb_idx( other ) << " (" << xy( other, XX ) << ","
-                << xy( other, YY ) << ")";
-            notes.add_error( msg.str() );
-        }
-    }
-    if ( notes.error() ) throw eckit::SeriousBug( notes.str(), Here() );
-}
+using mesh::detail::Uid2Node;
 
 void accumulate_elements( const Mesh& mesh, const mpi::BufferView<uid_t>& request_node_uid, const Uid2Node& uid2node,
                           const Node2Elem& node2elem, std::vector<idx_t>& found_elements,
-                          std::set<uid_t>& new_nodes_uid ) {
+                          std::vector<uid_t>& new_nodes_uid ) {
     // ATLAS_TRACE();
     const mesh::HybridElements::Connectivity& elem_nodes = mesh.cells().node_connectivity();
     const auto elem_part                                 = array::make_view<int, 1>( mesh.cells().partition() );
@@ -437,43 +293,50 @@ void accumulate_elements( const Mesh& mesh, const mpi::BufferView<uid_t>& reques
     size_t nb_nodes       = request_node_uid.size();
     const size_t mpi_rank = mpi::comm().rank();
 
-    std::set<idx_t> found_elements_set;
-
+    // Sorted, unique vectors replace std::set here: same (ordered) result, but
+    // one allocation per container instead of one per element.
+    found_elements.clear();
     for ( size_t jnode = 0; jnode < nb_nodes; ++jnode ) {
         uid_t uid = request_node_uid( jnode );
 
-        int inode = -1;
         // search and get node index for uid
-        Uid2Node::const_iterator found = uid2node.find( uid );
-        if ( found != uid2node.end() ) { inode = found->second; }
-        if ( inode != -1 && size_t( inode ) < node2elem.size() ) {
+        const int* found = uid2node.find( uid );
+        if ( found && size_t( *found ) < node2elem.size() ) {
+            const int inode = *found;
             for ( size_t jelem = 0; jelem < node2elem[inode].size(); ++jelem ) {
                 idx_t e = node2elem[inode][jelem];
-                if ( size_t( elem_part( e ) ) == mpi_rank ) { found_elements_set.insert( e ); }
+                if ( size_t( elem_part( e ) ) == mpi_rank ) { found_elements.push_back( e ); }
             }
         }
     }
-
-    // found_bdry_elements_set now contains elements for the nodes
-    found_elements = std::vector<idx_t>( found_elements_set.begin(), found_elements_set.end() );
+    std::sort( found_elements.begin(), found_elements.end() );
+    found_elements.erase( std::unique( found_elements.begin(), found_elements.end() ), found_elements.end() );
 
     UniqueLonLat compute_uid( mesh );
 
     // Collect all nodes
-    new_nodes_uid.clear();
+    std::vector<uid_t> elements_nodes_uid;
     for ( size_t jelem = 0; jelem < found_elements.size(); ++jelem ) {
         idx_t e = found_elements[jelem];
 
         size_t nb_elem_nodes = elem_nodes.cols( e );
         for ( size_t n = 0; n < nb_elem_nodes; ++n ) {
-            new_nodes_uid.insert( compute_uid( elem_nodes( e, n ) ) );
+            elements_nodes_uid.push_back( compute_uid( elem_nodes( e, n ) ) );
         }
     }
+    std::sort( elements_nodes_uid.begin(), elements_nodes_uid.end() );
+    elements_nodes_uid.erase( std::unique( elements_nodes_uid.begin(), elements_nodes_uid.end() ),
+                              elements_nodes_uid.end() );
 
     // Remove nodes we already have in the request-buffer
+    std::vector<uid_t> requested_uid( nb_nodes );
     for ( size_t jnode = 0; jnode < nb_nodes; ++jnode ) {
-        new_nodes_uid.erase( request_node_uid( jnode ) );
+        requested_uid[jnode] = request_node_uid( jnode );
     }
+    std::sort( requested_uid.begin(), requested_uid.end() );
+    new_nodes_uid.clear();
+    std::set_difference( elements_nodes_uid.begin(), elements_nodes_uid.end(), requested_uid.begin(),
+                         requested_uid.end(), std::back_inserter( new_nodes_uid ) );
 }
 
 class BuildHaloHelper {
@@ -581,12 +444,12 @@ public:
 
     std::vector<int> bdry_nodes;
     Node2Elem node_to_elem;
-    Uid2Node uid2node;
+    Uid2Node& uid2node;
     UniqueLonLat compute_uid;
     size_t halo;
 
 public:
-    BuildHaloHelper( BuildHalo& builder, Mesh& _mesh ) :
+    BuildHaloHelper( BuildHalo& builder, Mesh& _mesh, Uid2Node& _uid2node ) :
         builder_( builder ),
         mesh( _mesh ),
         xy( array::make_view<double, 2>( mesh.nodes().xy() ) ),
@@ -599,7 +462,10 @@ public:
         elem_nodes( &mesh.cells().node_connectivity() ),
         elem_part( array::make_view<int, 1>( mesh.cells().partition() ) ),
         elem_glb_idx( array::make_view<gidx_t, 1>( mesh.cells().global_index() ) ),
+        uid2node( _uid2node ),
         compute_uid( mesh ) {
+        // Storage of uid2node is shared between halo levels; its content is rebuilt for every level
+        uid2node.clear();
         halo = 0;
         mesh.metadata().get( "halo", halo );
         // update();
@@ -633,14 +499,14 @@ public:
         buf.node_xy[p].resize( 2 * nb_nodes );
 
         int jnode = 0;
-        typename NodeContainer::iterator it;
+        typename NodeContainer::const_iterator it;
         for ( it = nodes_uid.begin(); it != nodes_uid.end(); ++it, ++jnode ) {
             uid_t uid = *it;
 
-            Uid2Node::iterator found = uid2node.find( uid );
-            if ( found != uid2node.end() )  // Point exists inside domain
+            const int* found = uid2node.find( uid );
+            if ( found )  // Point exists inside domain
             {
-                int node                       = found->second;
+                int node                       = *found;
                 buf.node_glb_idx[p][jnode]     = glb_idx( node );
                 buf.node_part[p][jnode]        = part( node );
                 buf.node_ridx[p][jnode]        = ridx( node );
@@ -694,14 +560,14 @@ public:
         buf.node_xy[p].resize( 2 * nb_nodes );
 
         int jnode = 0;
-        typename NodeContainer::iterator it;
+        typename NodeContainer::const_iterator it;
         for ( it = nodes_uid.begin(); it != nodes_uid.end(); ++it, ++jnode ) {
             uid_t uid = *it;
 
-            Uid2Node::iterator found = uid2node.find( uid );
-            if ( found != uid2node.end() )  // Point exists inside domain
+            const int* found = uid2node.find( uid );
+            if ( found )  // Point exists inside domain
             {
-                int node                       = found->second;
+                int node                       = *found;
                 buf.node_part[p][jnode]        = part( node );
                 buf.node_ridx[p][jnode]        = ridx( node );
                 buf.node_xy[p][jnode * 2 + XX] = xy( node, XX );
@@ -762,7 +628,7 @@ public:
         // Nodes might be duplicated from different Tasks. We need to identify
         // unique entries
         std::vector<uid_t> node_uid( nb_nodes );
-        std::set<uid_t> new_node_uid;
+        util::FlatHashSet<uid_t> new_node_uid;
         {
             ATLAS_TRACE( "compute node_uid" );
             for ( int jnode = 0; jnode < nb_nodes; ++jnode ) {
@@ -774,7 +640,7 @@ public:
             std::vector<uid_t>::iterator it = std::lower_bound( node_uid.begin(), node_uid.end(), uid );
             bool not_found                  = ( it == node_uid.end() || uid < *it );
             if ( not_found ) {
-                bool inserted = new_node_uid.insert( uid ).second;
+                bool inserted = new_node_uid.insert( uid );
                 return not inserted;
             }
             else {
@@ -831,10 +697,10 @@ public:
 
                 // make sure new node was not already there
                 {
-                    uid_t uid                = compute_uid( loc_idx );
-                    Uid2Node::iterator found = uid2node.find( uid );
-                    if ( found != uid2node.end() ) {
-                        int other = found->second;
+                    uid_t uid        = compute_uid( loc_idx );
+                    const int* found = uid2node.find( uid );
+                    if ( found ) {
+                        int other = *found;
                         std::stringstream msg;
                         msg << "New node with uid " << uid << ":\n"
                             << glb_idx( loc_idx ) << "(" << xy( loc_idx, XX ) << "," << xy( loc_idx, YY ) << ")\n";
@@ -859,7 +725,7 @@ public:
         int nb_elems = mesh.cells().size();
         //    std::set<uid_t> elem_uid;
         std::vector<uid_t> elem_uid( 2 * nb_elems );
-        std::set<uid_t> new_elem_uid;
+        util::FlatHashSet<uid_t> new_elem_uid;
         {
             ATLAS_TRACE( "compute elem_uid" );
             for ( int jelem = 0; jelem < nb_elems; ++jelem ) {
@@ -872,7 +738,7 @@ public:
             std::vector<uid_t>::iterator it = std::lower_bound( elem_uid.begin(), elem_uid.end(), uid );
             bool not_found                  = ( it == elem_uid.end() || uid < *it );
             if ( not_found ) {
-                bool inserted = new_elem_uid.insert( uid ).second;
+                bool inserted = new_elem_uid.insert( uid );
                 return not inserted;
             }
             else {
@@ -1039,7 +905,7 @@ void increase_halo_interior( BuildHaloHelper& helper ) {
     helper.update();
     if ( helper.node_to_elem.size() == 0 ) build_lookup_node2elem( helper.mesh, helper.node_to_elem );
 
-    if ( helper.uid2node.size() == 0 ) build_lookup_uid2node( helper.mesh, helper.uid2node );
+    if ( helper.uid2node.size() == 0 ) mesh::detail::build_uid2node( helper.mesh.nodes(), helper.uid2node );
 
     // All buffers needed to move elements and nodes
     BuildHaloHelper::Buffers sendmesh( helper.mesh );
@@ -1076,7 +942,7 @@ void increase_halo_interior( BuildHaloHelper& helper ) {
         mpi::BufferView<uid_t> recv_bdry_nodes_uid = recv_bdry_nodes_uid_from_parts[jpart];
 
         std::vector<idx_t> found_bdry_elems;
-        std::set<uid_t> found_bdry_nodes_uid;
+        std::vector<uid_t> found_bdry_nodes_uid;
 
         accumulate_elements( helper.mesh, recv_bdry_nodes_uid, helper.uid2node, helper.node_to_elem, found_bdry_elems,
                              found_bdry_nodes_uid );
@@ -1133,7 +999,7 @@ void increase_halo_periodic( BuildHaloHelper& helper, const PeriodicPoints& peri
 
     // if( helper.uid2node.size() == 0 ) !!! NOT ALLOWED !!! (atlas_test_halo will
     // fail)
-    build_lookup_uid2node( helper.mesh, helper.uid2node );
+    mesh::detail::build_uid2node( helper.mesh.nodes(), helper.uid2node );
 
     // All buffers needed to move elements and nodes
     BuildHaloHelper::Buffers sendmesh( helper.mesh );
@@ -1180,7 +1046,7 @@ void increase_halo_periodic( BuildHaloHelper& helper, const PeriodicPoints& peri
         atlas::mpi::BufferView<uid_t> recv_bdry_nodes_uid = recv_bdry_nodes_uid_from_parts[jpart];
 
         std::vector<int> found_bdry_elems;
-        std::set<uid_t> found_bdry_nodes_uid;
+        std::vector<uid_t> found_bdry_nodes_uid;
 
         accumulate_elements( helper.mesh, recv_bdry_nodes_uid, helper.uid2node, helper.node_to_elem, found_bdry_elems,
                              found_bdry_nodes_uid );
@@ -1209,11 +1075,13 @@ void BuildHalo::operator()( int nb_elems ) {
 
     ATLAS_TRACE( "Increasing mesh halo" );
 
+    Uid2Node uid2node;
+
     for ( int jhalo = halo; jhalo < nb_elems; ++jhalo ) {
         Log::debug() << "Increase halo " << jhalo + 1 << std::endl;
         size_t nb_nodes_before_halo_increase = mesh_.nodes().size();
 
-        BuildHaloHelper helper( *this, mesh_ );
+        BuildHaloHelper helper( *this, mesh_, uid2node );
 
         ATLAS_TRACE_SCOPE( "increase_halo_interior" ) { increase_halo_interior( helper ); }
 
@@ -24,6 +24,8 @@
 #include "atlas/mesh/Nodes.h"
 #include "atlas/mesh/actions/BuildParallelFields.h"
 #include "atlas/mesh/detail/PeriodicTransform.h"
+#include "atlas/mesh/detail/RenumberGlobalIndex.h"
+#include "atlas/mesh/detail/Uid2Node.h"
 #include "atlas/parallel/GatherScatter.h"
 #include "atlas/parallel/mpi/Buffer.h"
 #include "atlas/parallel/mpi/mpi.h"
@@ -32,6 +34,7 @@
 #include "atlas/runtime/Trace.h"
 #include "atlas/util/CoordinateEnums.h"
 #include "atlas/util/Unique.h"
+#include "atlas/util/detail/FlatHashMap.h"
 
 #define EDGE( jedge )                                                                                     \
     "Edge(" << node_gidx( edge_nodes( jedge, 0 ) ) << "[p" << node_part( edge_nodes( jedge, 0 ) ) << "] " \
@@ -157,10 +160,6 @@ void renumber_nodes_glb_idx( mesh::Nodes& nodes ) {
 
     UniqueLonLat compute_uid( nodes );
 
-    // unused // int mypart = mpi::comm().rank();
-    int nparts  = mpi::comm().size();
-    size_t root = 0;
-
     array::ArrayView<gidx_t, 1> glb_idx = array::make_view<gidx_t, 1>( nodes.global_index() );
 
     /*
@@ -174,60 +173,12 @@ void renumber_nodes_glb_idx( mesh::Nodes& nodes ) {
         if ( glb_idx( jnode ) <= 0 ) { glb_idx( jnode ) = compute_uid( jnode ); }
     }
 
-    // 1) Gather all global indices, together with location
-    array::ArrayT<uid_t> loc_id_arr( nb_nodes );
-    array::ArrayView<uid_t, 1> loc_id = array::make_view<uid_t, 1>( loc_id_arr );
-
-    for ( int jnode = 0; jnode < nb_nodes; ++jnode ) {
-        loc_id( jnode ) = glb_idx( jnode );
-    }
-
-    std::vector<int> recvcounts( mpi::comm().size() );
-    std::vector<int> recvdispls( mpi::comm().size() );
-
-    ATLAS_TRACE_MPI( GATHER ) { mpi::comm().gather( nb_nodes, recvcounts, root ); }
-
-    recvdispls[0] = 0;
-    for ( int jpart = 1; jpart < nparts; ++jpart ) {  // start at 1
-        recvdispls[jpart] = recvcounts[jpart - 1] + recvdispls[jpart - 1];
-    }
-    int glb_nb_nodes = std::accumulate( recvcounts.begin(), recvcounts.end(), 0 );
-
-    array::ArrayT<uid_t> glb_id_arr( glb_nb_nodes );
-    array::ArrayView<uid_t, 1> glb_id = array::make_view<uid_t, 1>( glb_id_arr );
-
-    ATLAS_TRACE_MPI( GATHER ) {
-        mpi::comm().gatherv( loc_id.data(), loc_id.size(), glb_id.data(), recvcounts.data(), recvdispls.data(), root );
-    }
-
-    // 2) Sort all global indices, and renumber from 1 to glb_nb_edges
-    std::vector<Node> node_sort;
-    node_sort.reserve( glb_nb_nodes );
-    ATLAS_TRACE_SCOPE( "sort global indices" ) {
-        for ( size_t jnode = 0; jnode < glb_id.shape( 0 ); ++jnode ) {
-            node_sort.push_back( Node( glb_id( jnode ), jnode ) );
-        }
-        std::sort( node_sort.begin(), node_sort.end() );
-    }
-
-    // Assume edge gid start
-    uid_t gid = 0;
-    for ( size_t jnode = 0; jnode < node_sort.size(); ++jnode ) {
-        if ( jnode == 0 ) { ++gid; }
-        else if ( node_sort[jnode].g != node_sort[jnode - 1].g ) {
-            ++gid;
-        }
-        int inode       = node_sort[jnode].i;
-        glb_id( inode ) = gid;
-    }
-
-    // 3) Scatter renumbered back
-    ATLAS_TRACE_MPI( SCATTER ) {
-        mpi::comm().scatterv( glb_id.data(), recvcounts.data(), recvdispls.data(), loc_id.data(), loc_id.size(), root );
-    }
+    // Renumber from 1 to the number of distinct global indices, following their order
+    std::vector<gidx_t> gid( glb_idx.data(), glb_idx.data() + nb_nodes );
+    mesh::detail::renumber_global_index( gid, 1 );
 
     for ( int jnode = 0; jnode < nb_nodes; ++jnode ) {
-        glb_idx( jnode ) = loc_id( jnode );
+        glb_idx( jnode ) = gid[jnode];
     }
     nodes.global_index().metadata().set( "human_readable", true );
 }
@@ -258,15 +209,12 @@ Field& build_nodes_remote_idx( mesh::Nodes& nodes ) {
     std::vector<std::vector<uid_t>> send_needed( mpi::comm().size() );
     std::vector<std::vector<uid_t>> recv_needed( mpi::comm().size() );
     int sendcnt = 0;
-    std::map<uid_t, int> lookup;
+    mesh::detail::Uid2Node lookup;
+    mesh::detail::build_uid2node( nodes, lookup, mypart );
     for ( size_t jnode = 0; jnode < nb_nodes; ++jnode ) {
-        uid_t uid = compute_uid( jnode );
-
-        if ( size_t( part( jnode ) ) == mypart ) {
-            lookup[uid]   = jnode;
-            ridx( jnode ) = jnode;
-        }
+        if ( size_t( part( jnode ) ) == mypart ) { ridx( jnode ) = jnode; }
         else {
+            uid_t uid = compute_uid( jnode );
             ASSERT( jnode < part.shape( 0 ) );
             if ( part( jnode ) >= (int)proc.size() ) {
                 std::stringstream msg;
@@ -296,11 +244,12 @@ Field& build_nodes_remote_idx( mesh::Nodes& nodes ) {
         //     array::make_shape(recv_needed[ proc[jpart] ].size()/varsize,varsize)
         //     );
         for ( size_t jnode = 0; jnode < nb_recv_nodes; ++jnode ) {
-            uid_t uid = recv_node[jnode * varsize + 0];
-            int inode = recv_node[jnode * varsize + 1];
-            if ( lookup.count( uid ) ) {
+            uid_t uid        = recv_node[jnode * varsize + 0];
+            int inode        = recv_node[jnode * varsize + 1];
+            const int* found = lookup.find( uid );
+            if ( found ) {
                 send_found[proc[jpart]].push_back( inode );
-                send_found[proc[jpart]].push_back( lookup[uid] );
+                send_found[proc[jpart]].push_back( *found );
             }
             else {
                 std::stringstream msg;
@@ -585,7 +534,7 @@ Field& build_edges_remote_idx( Mesh& mesh ) {
     std::vector<std::vector<uid_t>> send_needed( mpi::comm().size() );
     std::vector<std::vector<uid_t>> recv_needed( mpi::comm().size() );
     int sendcnt = 0;
-    std::map<uid_t, int> lookup;
+    util::FlatHashMap<uid_t, int> lookup( nb_edges );
 
     PeriodicTransform transform;
 
@@ -650,19 +599,18 @@ Field& build_edges_remote_idx( Mesh& mesh ) {
     std::vector<std::vector<int>> send_found( mpi::comm().size() );
     std::vector<std::vector<int>> recv_found( mpi::comm().size() );
 
-    std::map<uid_t, int>::iterator found;
     for ( size_t jpart = 0; jpart < nparts; ++jpart ) {
         const std::vector<uid_t>& recv_edge = recv_needed[jpart];
         const size_t nb_recv_edges          = recv_edge.size() / varsize;
         // array::ArrayView<uid_t,2> recv_edge( recv_needed[ jpart ].data(),
         //     array::make_shape(recv_needed[ jpart ].size()/varsize,varsize) );
         for ( size_t jedge = 0; jedge < nb_recv_edges; ++jedge ) {
-            uid_t recv_uid = recv_edge[jedge * varsize + 0];
-            int recv_idx   = recv_edge[jedge * varsize + 1];
-            found          = lookup.find( recv_uid );
-            if ( found != lookup.end() ) {
+            uid_t recv_uid   = recv_edge[jedge * varsize + 0];
+            int recv_idx     = recv_edge[jedge * varsize + 1];
+            const int* found = lookup.find( recv_uid );
+            if ( found ) {
                 send_found[jpart].push_back( recv_idx );
-                send_found[jpart].push_back( found->second );
+                send_found[jpart].push_back( *found );
             }
             else {
                 std::stringstream msg;
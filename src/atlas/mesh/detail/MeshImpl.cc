@@ -9,8 +9,10 @@
  */
 
 #include <algorithm>
+#include <string>
 
 #include "eckit/exception/Exceptions.h"
+#include "eckit/serialisation/Stream.h"
 #include "eckit/types/FloatCompare.h"
 
 #include "atlas/grid/Grid.h"
@@ -19,7 +21,10 @@
 #include "atlas/mesh/Mesh.h"
 #include "atlas/mesh/Nodes.h"
 #include "atlas/mesh/detail/MeshImpl.h"
+#include "atlas/mesh/detail/MeshStream.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/util/Config.h"
 
 using atlas::Grid;
 using atlas::Projection;
@@ -30,12 +35,75 @@ namespace detail {
 
 //----------------------------------------------------------------------------------------------------------------------
 
+namespace {
+static const std::string stream_tag = "atlas::Mesh";
+static const int stream_version     = 1;
+}  // namespace
+
 MeshImpl::MeshImpl( eckit::Stream& s ) {
-    NOTIMP;
+    std::string tag;
+    int version;
+    s >> tag;
+    if ( tag != stream_tag ) { throw eckit::BadValue( "Stream does not contain an atlas::Mesh", Here() ); }
+    s >> version;
+    if ( version != stream_version ) {
+        throw eckit::BadValue( "Unsupported atlas::Mesh stream version " + std::to_string( version ), Here() );
+    }
+
+    s >> dimensionality_;
+    nodes_.reset( new mesh::Nodes() );
+    createElements();
+
+    decode( metadata_, s );
+
+    bool has_grid;
+    s >> has_grid;
+    if ( has_grid ) {
+        util::Config spec;
+        decode( spec, s );
+        try {
+            grid_.reset( new Grid( spec ) );
+        }
+        catch ( const eckit::Exception& e ) {
+            Log::warning() << "Grid of decoded mesh could not be recreated: " << e.what() << std::endl;
+        }
+    }
+
+    bool has_projection;
+    s >> has_projection;
+    if ( has_projection ) {
+        util::Config spec;
+        decode( spec, s );
+        projection_ = Projection( spec );
+    }
+
+    decode( *nodes_, s );
+    decode( *cells_, s );
+    decode( *facets_, s );
+    decode( *ridges_, s );
+    decode( *peaks_, s );
 }
 
 void MeshImpl::encode( eckit::Stream& s ) const {
-    NOTIMP;
+    syncHostDevice();
+
+    s << stream_tag;
+    s << stream_version;
+    s << dimensionality_;
+
+    mesh::detail::encode( metadata_, s );
+
+    s << bool( grid_ );
+    if ( grid_ ) { mesh::detail::encode( grid_->spec(), s ); }
+
+    s << bool( projection_ );
+    if ( projection_ ) { mesh::detail::encode( projection_.spec(), s ); }
+
+    mesh::detail::encode( *nodes_, s );
+    mesh::detail::encode( *cells_, s );
+    mesh::detail::encode( *facets_, s );
+    mesh::detail::encode( *ridges_, s );
+    mesh::detail::encode( *peaks_, s );
 }
 
 MeshImpl::MeshImpl() : dimensionality_( 2 ) {
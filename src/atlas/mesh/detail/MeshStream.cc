@@ -0,0 +1,355 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/mesh/detail/MeshStream.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/parser/JSON.h"
+#include "eckit/parser/JSONParser.h"
+#include "eckit/serialisation/Stream.h"
+
+#include "atlas/array/Array.h"
+#include "atlas/array/DataType.h"
+#include "atlas/field/Field.h"
+#include "atlas/library/config.h"
+#include "atlas/mesh/Connectivity.h"
+#include "atlas/mesh/ElementType.h"
+#include "atlas/mesh/Elements.h"
+#include "atlas/mesh/HybridElements.h"
+#include "atlas/mesh/Nodes.h"
+#include "atlas/util/Config.h"
+#include "atlas/util/Metadata.h"
+
+namespace atlas {
+namespace mesh {
+namespace detail {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+#if ATLAS_HAVE_FORTRAN
+static const int connectivity_base = 1;
+#else
+static const int connectivity_base = 0;
+#endif
+
+std::string to_json( const eckit::Configuration& config ) {
+    std::stringstream s;
+    eckit::JSON json( s );
+    json.precision( 17 );
+    json << config;
+    return s.str();
+}
+
+util::Metadata from_json( const std::string& str ) {
+    std::stringstream s;
+    s << str;
+    eckit::JSONParser parser( s );
+    return util::Metadata( parser.parse() );
+}
+
+size_t bytes( const array::Array& array ) {
+    return array.size() * array.sizeof_data();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void encode_field( const Field& field, eckit::Stream& s ) {
+    const array::Array& array = field.array();
+    if ( not array.contiguous() ) {
+        throw eckit::NotImplemented( "Field " + field.name() + " is not contiguous and cannot be encoded", Here() );
+    }
+    s << field.name();
+    s << field.datatype().str();
+    s << array.rank();
+    for ( size_t j = 0; j < array.rank(); ++j ) {
+        s << array.shape( j );
+    }
+    encode( field.metadata(), s );
+    s.writeBlob( array.storage(), bytes( array ) );
+}
+
+/// Decode a field into nodes or elements. An existing field with the same name is reused when its
+/// datatype and shape match, so that the builtin fields keep their identity, and replaced otherwise.
+template <typename FieldContainer>
+void decode_field( FieldContainer& container, eckit::Stream& s ) {
+    std::string name;
+    std::string datatype;
+    size_t rank;
+    s >> name;
+    s >> datatype;
+    s >> rank;
+    array::ArrayShape shape;
+    shape.resize( rank );
+    for ( size_t j = 0; j < rank; ++j ) {
+        s >> shape[j];
+    }
+    util::Metadata metadata;
+    decode( metadata, s );
+
+    Field field;
+    if ( container.has_field( name ) ) {
+        field = container.field( name );
+        if ( field.datatype().kind() != array::DataType( datatype ).kind() || field.shape() != shape ) {
+            container.remove_field( name );
+            field = Field();
+        }
+    }
+    if ( not field ) { field = container.add( Field( name, array::DataType( datatype ), shape ) ); }
+    field.metadata() = metadata;
+    s.readBlob( field.array().storage(), bytes( field.array() ) );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void encode_values( const idx_t* values, size_t size, idx_t missing_value, eckit::Stream& s ) {
+    s << size;
+    s << connectivity_base;
+    s << sizeof( idx_t );
+    s << missing_value;
+    s.writeBlob( values, size * sizeof( idx_t ) );
+}
+
+/// Read connectivity values into preallocated storage, converting them to the base of this build.
+/// Missing values are not indices: they are mapped to the missing value of the decoded connectivity.
+void decode_values( idx_t* values, size_t size, idx_t missing_value, eckit::Stream& s ) {
+    size_t encoded_size;
+    int encoded_base;
+    size_t encoded_sizeof_idx;
+    s >> encoded_size;
+    s >> encoded_base;
+    s >> encoded_sizeof_idx;
+    ASSERT( encoded_size == size );
+    if ( encoded_sizeof_idx != sizeof( idx_t ) ) {
+        std::stringstream msg;
+        msg << "Connectivity was encoded with indices of " << encoded_sizeof_idx << " bytes, but atlas uses "
+            << sizeof( idx_t ) << " bytes";
+        throw eckit::BadValue( msg.str(), Here() );
+    }
+    idx_t encoded_missing_value;
+    s >> encoded_missing_value;
+    s.readBlob( values, size * sizeof( idx_t ) );
+    if ( encoded_base != connectivity_base || encoded_missing_value != missing_value ) {
+        // Missing values are stored with the base added, like any other value
+        const idx_t encoded_missing = encoded_missing_value + encoded_base;
+        const idx_t missing         = missing_value + connectivity_base;
+        const idx_t shift           = connectivity_base - encoded_base;
+        for ( size_t j = 0; j < size; ++j ) {
+            values[j] = ( values[j] == encoded_missing ) ? missing : values[j] + shift;
+        }
+    }
+}
+
+size_t nb_values( const IrregularConnectivity& connectivity ) {
+    return connectivity.rows() ? connectivity.displs( connectivity.rows() ) : 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void encode_connectivity( const IrregularConnectivity& connectivity, eckit::Stream& s ) {
+    const size_t rows = connectivity.rows();
+    std::vector<size_t> counts( rows );
+    for ( size_t j = 0; j < rows; ++j ) {
+        counts[j] = connectivity.cols( j );
+    }
+    s << connectivity.name();
+    s << rows;
+    s.writeBlob( counts.data(), rows * sizeof( size_t ) );
+    encode_values( connectivity.data(), nb_values( connectivity ), connectivity.missing_value(), s );
+}
+
+void decode_connectivity( Nodes& nodes, eckit::Stream& s ) {
+    std::string name;
+    size_t rows;
+    s >> name;
+    s >> rows;
+    std::vector<size_t> counts( rows );
+    s.readBlob( counts.data(), rows * sizeof( size_t ) );
+
+    Nodes::Connectivity& connectivity =
+        nodes.has_connectivity( name ) ? nodes.connectivity( name ) : nodes.add( new Nodes::Connectivity( name ) );
+    ASSERT( connectivity.rows() == 0 );
+    if ( rows ) { connectivity.add( rows, counts.data() ); }
+    decode_values( connectivity.data(), nb_values( connectivity ), connectivity.missing_value(), s );
+}
+
+void encode_connectivity( const MultiBlockConnectivity& connectivity, eckit::Stream& s ) {
+    size_t rows = 0;
+    for ( size_t b = 0; b < connectivity.blocks(); ++b ) {
+        rows += connectivity.block( b ).rows();
+    }
+    if ( rows != connectivity.rows() ) {
+        throw eckit::NotImplemented(
+            "Connectivity " + connectivity.name() + " has rows outside of its blocks and cannot be encoded", Here() );
+    }
+    s << connectivity.name();
+    s << connectivity.blocks();
+    for ( size_t b = 0; b < connectivity.blocks(); ++b ) {
+        s << connectivity.block( b ).rows();
+        s << connectivity.block( b ).cols();
+    }
+    encode_values( connectivity.data(), nb_values( connectivity ), connectivity.missing_value(), s );
+}
+
+void decode_connectivity( HybridElements& elements, eckit::Stream& s ) {
+    std::string name;
+    size_t blocks;
+    s >> name;
+    s >> blocks;
+    std::vector<size_t> rows( blocks );
+    std::vector<size_t> cols( blocks );
+    for ( size_t b = 0; b < blocks; ++b ) {
+        s >> rows[b];
+        s >> cols[b];
+    }
+
+    HybridElements::Connectivity* connectivity;
+    if ( name == "node" ) { connectivity = &elements.node_connectivity(); }
+    else if ( name == "edge" ) {
+        connectivity = &elements.edge_connectivity();
+    }
+    else if ( name == "cell" ) {
+        connectivity = &elements.cell_connectivity();
+    }
+    else {
+        throw eckit::BadValue( "Unknown element connectivity " + name, Here() );
+    }
+
+    // The node connectivity blocks are already created when the element types are added
+    if ( connectivity->blocks() == 0 ) {
+        for ( size_t b = 0; b < blocks; ++b ) {
+            connectivity->add( rows[b], cols[b] );
+        }
+    }
+    else {
+        ASSERT( connectivity->blocks() == blocks );
+        for ( size_t b = 0; b < blocks; ++b ) {
+            ASSERT( connectivity->block( b ).rows() == rows[b] );
+            ASSERT( connectivity->block( b ).cols() == cols[b] );
+        }
+    }
+    decode_values( connectivity->data(), nb_values( *connectivity ), connectivity->missing_value(), s );
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void encode( const util::Metadata& metadata, eckit::Stream& s ) {
+    s << to_json( metadata );
+}
+
+void decode( util::Metadata& metadata, eckit::Stream& s ) {
+    std::string json;
+    s >> json;
+    metadata = from_json( json );
+}
+
+void encode( const util::Config& config, eckit::Stream& s ) {
+    s << to_json( config );
+}
+
+void decode( util::Config& config, eckit::Stream& s ) {
+    std::string json;
+    s >> json;
+    config = util::Config( from_json( json ) );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void encode( const Nodes& nodes, eckit::Stream& s ) {
+    s << nodes.size();
+    encode( nodes.metadata(), s );
+
+    s << nodes.nb_fields();
+    for ( size_t j = 0; j < nodes.nb_fields(); ++j ) {
+        encode_field( nodes.field( j ), s );
+    }
+
+    s << nodes.nb_connectivities();
+    for ( size_t j = 0; j < nodes.nb_connectivities(); ++j ) {
+        encode_connectivity( nodes.connectivity( j ), s );
+    }
+}
+
+void decode( Nodes& nodes, eckit::Stream& s ) {
+    size_t size;
+    s >> size;
+    nodes.resize( size );
+    decode( nodes.metadata(), s );
+
+    size_t nb_fields;
+    s >> nb_fields;
+    for ( size_t j = 0; j < nb_fields; ++j ) {
+        decode_field( nodes, s );
+    }
+
+    size_t nb_connectivities;
+    s >> nb_connectivities;
+    for ( size_t j = 0; j < nb_connectivities; ++j ) {
+        decode_connectivity( nodes, s );
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void encode( const HybridElements& elements, eckit::Stream& s ) {
+    s << elements.nb_types();
+    for ( size_t t = 0; t < elements.nb_types(); ++t ) {
+        s << elements.element_type( t ).name();
+        s << elements.elements( t ).size();
+    }
+    encode( elements.metadata(), s );
+
+    s << elements.nb_fields();
+    for ( size_t j = 0; j < elements.nb_fields(); ++j ) {
+        encode_field( elements.field( j ), s );
+    }
+
+    encode_connectivity( elements.node_connectivity(), s );
+    encode_connectivity( elements.edge_connectivity(), s );
+    encode_connectivity( elements.cell_connectivity(), s );
+}
+
+void decode( HybridElements& elements, eckit::Stream& s ) {
+    ASSERT( elements.size() == 0 );
+
+    size_t nb_types;
+    s >> nb_types;
+    for ( size_t t = 0; t < nb_types; ++t ) {
+        std::string name;
+        size_t size;
+        s >> name;
+        s >> size;
+        elements.add( ElementType::create( name ), size );
+    }
+    decode( elements.metadata(), s );
+
+    size_t nb_fields;
+    s >> nb_fields;
+    for ( size_t j = 0; j < nb_fields; ++j ) {
+        decode_field( elements, s );
+    }
+
+    for ( size_t j = 0; j < 3; ++j ) {
+        decode_connectivity( elements, s );
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace detail
+}  // namespace mesh
+}  // namespace atlas
@@ -0,0 +1,60 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+/// @file MeshStream.h
+///
+/// Binary serialisation of the components of a mesh partition, used by
+/// MeshImpl::encode() and MeshImpl( eckit::Stream& ).
+///
+/// Fields are written with their name, datatype, shape and metadata, and connectivities with
+/// their rows and columns, each followed by their raw values as a single blob. Decoding
+/// allocates every array with its final size, and reads its values with a single read.
+
+#pragma once
+
+namespace eckit {
+class Stream;
+}
+namespace atlas {
+namespace util {
+class Config;
+class Metadata;
+}  // namespace util
+namespace mesh {
+class Nodes;
+class HybridElements;
+}  // namespace mesh
+}  // namespace atlas
+
+namespace atlas {
+namespace mesh {
+namespace detail {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void encode( const util::Metadata&, eckit::Stream& );
+void decode( util::Metadata&, eckit::Stream& );
+
+void encode( const util::Config&, eckit::Stream& );
+void decode( util::Config&, eckit::Stream& );
+
+/// Fields, metadata and connectivities of nodes
+void encode( const Nodes&, eckit::Stream& );
+void decode( Nodes&, eckit::Stream& );
+
+/// Element types, fields, metadata and connectivities of elements
+void encode( const HybridElements&, eckit::Stream& );
+void decode( HybridElements&, eckit::Stream& );
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace detail
+}  // namespace mesh
+}  // namespace atlas
@@ -0,0 +1,129 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include "atlas/mesh/detail/RenumberGlobalIndex.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/runtime/Trace.h"
+
+namespace atlas {
+namespace mesh {
+namespace detail {
+
+namespace {
+
+// Number of samples each task contributes to the choice of splitters
+constexpr size_t nb_samples_per_task = 64;
+
+void displacements( const std::vector<int>& counts, std::vector<int>& displs ) {
+    displs.resize( counts.size() );
+    displs[0] = 0;
+    for ( size_t j = 1; j < counts.size(); ++j ) {
+        displs[j] = displs[j - 1] + counts[j - 1];
+    }
+}
+
+void sort_unique( std::vector<gidx_t>& v ) {
+    std::sort( v.begin(), v.end() );
+    v.erase( std::unique( v.begin(), v.end() ), v.end() );
+}
+
+}  // namespace
+
+void renumber_global_index( std::vector<gidx_t>& glb_idx, gidx_t first ) {
+    ATLAS_TRACE();
+
+    const auto& comm    = mpi::comm();
+    const size_t nparts = comm.size();
+
+    // 1) Distinct local values
+    std::vector<gidx_t> keys( glb_idx );
+    sort_unique( keys );
+
+    // 2) Splitters from a regular sample of every task's values. Task j will own the
+    //    values v with splitters[j-1] <= v < splitters[j].
+    std::vector<gidx_t> splitters;
+    ATLAS_TRACE_SCOPE( "splitters" ) {
+        std::vector<gidx_t> samples;
+        const size_t nb_samples = std::min( keys.size(), nb_samples_per_task );
+        for ( size_t j = 0; j < nb_samples; ++j ) {
+            samples.push_back( keys[( j * keys.size() ) / nb_samples] );
+        }
+        std::vector<int> counts( nparts );
+        std::vector<int> displs;
+        ATLAS_TRACE_MPI( ALLGATHER ) { comm.allGather( int( samples.size() ), counts.begin(), counts.end() ); }
+        displacements( counts, displs );
+        std::vector<gidx_t> all_samples( displs.back() + counts.back() );
+        ATLAS_TRACE_MPI( ALLGATHER ) {
+            comm.allGatherv( samples.begin(), samples.end(), all_samples.data(), counts.data(), displs.data() );
+        }
+        sort_unique( all_samples );
+        for ( size_t j = 1; j < nparts; ++j ) {
+            if ( all_samples.empty() ) { break; }
+            splitters.push_back( all_samples[( j * all_samples.size() ) / nparts] );
+        }
+        // tasks without splitter receive nothing
+        splitters.resize( nparts - 1, std::numeric_limits<gidx_t>::max() );
+    }
+
+    // 3) Send every distinct value to the task owning it. The keys are sorted, so the
+    //    values for each task are contiguous.
+    std::vector<int> sendcounts( nparts, 0 );
+    std::vector<int> recvcounts( nparts );
+    std::vector<int> senddispls, recvdispls;
+    {
+        size_t jpart = 0;
+        for ( gidx_t key : keys ) {
+            while ( jpart < nparts - 1 && key >= splitters[jpart] ) {
+                ++jpart;
+            }
+            ++sendcounts[jpart];
+        }
+    }
+    ATLAS_TRACE_MPI( ALLTOALL ) { comm.allToAll( sendcounts, recvcounts ); }
+    displacements( sendcounts, senddispls );
+    displacements( recvcounts, recvdispls );
+
+    std::vector<gidx_t> received( recvdispls.back() + recvcounts.back() );
+    ATLAS_TRACE_MPI( ALLTOALL ) {
+        comm.allToAllv( keys.data(), sendcounts.data(), senddispls.data(), received.data(), recvcounts.data(),
+                        recvdispls.data() );
+    }
+
+    // 4) Number the distinct values owned by this task, after those of lower tasks
+    std::vector<gidx_t> owned( received );
+    sort_unique( owned );
+
+    std::vector<gidx_t> nb_owned( nparts );
+    ATLAS_TRACE_MPI( ALLGATHER ) { comm.allGather( gidx_t( owned.size() ), nb_owned.begin(), nb_owned.end() ); }
+    const gidx_t offset = first + std::accumulate( nb_owned.begin(), nb_owned.begin() + comm.rank(), gidx_t( 0 ) );
+
+    for ( gidx_t& value : received ) {
+        value = offset + ( std::lower_bound( owned.begin(), owned.end(), value ) - owned.begin() );
+    }
+
+    // 5) Return the new numbers to the tasks that sent the values, in the same order
+    std::vector<gidx_t> renumbered( keys.size() );
+    ATLAS_TRACE_MPI( ALLTOALL ) {
+        comm.allToAllv( received.data(), recvcounts.data(), recvdispls.data(), renumbered.data(), sendcounts.data(),
+                        senddispls.data() );
+    }
+
+    for ( gidx_t& value : glb_idx ) {
+        value = renumbered[std::lower_bound( keys.begin(), keys.end(), value ) - keys.begin()];
+    }
+}
+
+}  // namespace detail
+}  // namespace mesh
+}  // namespace atlas
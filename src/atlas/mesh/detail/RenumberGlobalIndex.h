@@ -0,0 +1,31 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "atlas/library/config.h"
+
+namespace atlas {
+namespace mesh {
+namespace detail {
+
+/// Replace every global index by the position of its value in the sorted set of distinct
+/// values over all MPI tasks, counting from first. Equal values, also on different tasks,
+/// are replaced by the same index.
+///
+/// The values are distributed over the tasks with a sample sort, so that no task needs to
+/// hold the global set of indices. Collective over mpi::comm().
+void renumber_global_index( std::vector<gidx_t>& glb_idx, gidx_t first );
+
+}  // namespace detail
+}  // namespace mesh
+}  // namespace atlas
@@ -0,0 +1,59 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/mesh/detail/Uid2Node.h"
+
+#include <sstream>
+
+#include "eckit/exception/Exceptions.h"
+
+#include "atlas/array/ArrayView.h"
+#include "atlas/array/MakeView.h"
+#include "atlas/field/Field.h"
+#include "atlas/mesh/Nodes.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/CoordinateEnums.h"
+#include "atlas/util/Unique.h"
+
+namespace atlas {
+namespace mesh {
+namespace detail {
+
+void build_uid2node( const Nodes& nodes, Uid2Node& uid2node, int part ) {
+    ATLAS_TRACE();
+    auto xy               = array::make_view<double, 2>( nodes.xy() );
+    auto glb_idx          = array::make_view<gidx_t, 1>( nodes.global_index() );
+    auto partition        = array::make_view<int, 1>( nodes.partition() );
+    const size_t nb_nodes = nodes.size();
+
+    util::UniqueLonLat compute_uid( nodes );
+
+    uid2node.clear();
+    uid2node.reserve( nb_nodes );
+    std::stringstream errors;
+    bool error = false;
+    for ( size_t jnode = 0; jnode < nb_nodes; ++jnode ) {
+        if ( part >= 0 && partition( jnode ) != part ) continue;
+        uidx_t uid = compute_uid( jnode );
+        if ( not uid2node.insert( uid, jnode ) ) {
+            int other = uid2node[uid];
+            if ( error ) errors << "\n";
+            errors << "Node uid: " << uid << "   " << glb_idx( jnode ) << " (" << xy( jnode, XX ) << ","
+                   << xy( jnode, YY ) << ")  has already been added as node " << glb_idx( other ) << " ("
+                   << xy( other, XX ) << "," << xy( other, YY ) << ")";
+            error = true;
+        }
+    }
+    if ( error ) throw eckit::SeriousBug( errors.str(), Here() );
+}
+
+}  // namespace detail
+}  // namespace mesh
+}  // namespace atlas
@@ -0,0 +1,36 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include "atlas/library/config.h"
+#include "atlas/util/detail/FlatHashMap.h"
+
+namespace atlas {
+namespace mesh {
+class Nodes;
+}  // namespace mesh
+}  // namespace atlas
+
+namespace atlas {
+namespace mesh {
+namespace detail {
+
+/// Local index of nodes by their unique id, as computed by util::UniqueLonLat
+using Uid2Node = util::FlatHashMap<uidx_t, int>;
+
+/// Fill uid2node with the nodes of partition part, or with all nodes when part is negative.
+/// The storage of uid2node is reused. Throws eckit::SeriousBug when two of these nodes have
+/// the same unique id.
+void build_uid2node( const Nodes&, Uid2Node& uid2node, int part = -1 );
+
+}  // namespace detail
+}  // namespace mesh
+}  // namespace atlas
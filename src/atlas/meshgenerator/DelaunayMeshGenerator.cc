@@ -80,17 +80,8 @@ void DelaunayMeshGenerator::createNodes( const Grid& grid, Mesh& mesh ) const {
 
     array::ArrayView<double, 2> xy     = array::make_view<double, 2>( mesh.nodes().xy() );
     array::ArrayView<double, 2> lonlat = array::make_view<double, 2>( mesh.nodes().lonlat() );
-    size_t jnode( 0 );
-    Projection projection = grid.projection();
-    PointLonLat Pll;
-    for ( PointXY Pxy : grid.xy() ) {
-        xy( jnode, XX )      = Pxy.x();
-        xy( jnode, YY )      = Pxy.y();
-        Pll                  = projection.lonlat( Pxy );
-        lonlat( jnode, LON ) = Pll.lon();
-        lonlat( jnode, LAT ) = Pll.lat();
-        ++jnode;
-    }
+    grid.fill_xy( xy.data() );
+    grid.fill_lonlat( lonlat.data() );
 }
 
 namespace {
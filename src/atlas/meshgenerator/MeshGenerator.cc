@@ -16,6 +16,7 @@
 #include "eckit/thread/AutoLock.h"
 #include "eckit/thread/Mutex.h"
 #include "eckit/utils/Hash.h"
+#include "eckit/utils/MD5.h"
 
 #include "atlas/array/ArrayView.h"
 #include "atlas/field/Field.h"
@@ -127,6 +128,11 @@ void MeshGeneratorImpl::setProjection( Mesh& mesh, const Projection& p ) const {
 void MeshGeneratorImpl::setGrid( Mesh& mesh, const Grid& g, const grid::Distribution& d ) const {
     mesh.setGrid( g );
     mesh.metadata().set( "distribution", d.type() );
+
+    // Identifies the generator and its options, e.g. to key caches of quantities derived from the mesh
+    eckit::MD5 md5;
+    hash( md5 );
+    mesh.metadata().set( "mesh_generator", md5.digest() );
 }
 
 //----------------------------------------------------------------------------------------------------------------------
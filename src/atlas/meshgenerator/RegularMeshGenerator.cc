@@ -119,12 +119,12 @@ void RegularMeshGenerator::generate( const Grid& grid, const grid::Distribution&
 
     ASSERT( !mesh.generated() );
 
-    if ( grid.size() != distribution.partition().size() ) {
+    if ( grid.size() != distribution.size() ) {
         std::stringstream msg;
         msg << "Number of points in grid (" << grid.size()
             << ") different from "
                "number of points in grid distribution ("
-            << distribution.partition().size() << ")";
+            << distribution.size() << ")";
         throw eckit::AssertionFailed( msg.str(), Here() );
     }
 
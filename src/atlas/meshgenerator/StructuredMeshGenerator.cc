@@ -12,6 +12,7 @@
 #include <cmath>
 #include <limits>
 #include <numeric>
+#include <utility>
 #include <vector>
 
 #include "eckit/memory/SharedPtr.h"
@@ -35,6 +36,7 @@
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
+#include "atlas/util/Config.h"
 #include "atlas/util/CoordinateEnums.h"
 
 #define DEBUG_OUTPUT 0
@@ -63,6 +65,11 @@ struct Region {
     std::vector<int> lat_begin;
     std::vector<int> lat_end;
     std::vector<int> nb_lat_elems;
+
+    // Partitions of the grid points of the latitudes of this region, starting at global index parts_begin
+    gidx_t parts_begin;
+    std::vector<int> parts;
+    int partition( gidx_t n ) const { return parts[n - parts_begin]; }
 };
 
 StructuredMeshGenerator::StructuredMeshGenerator( const eckit::Parametrisation& p ) {
@@ -169,7 +176,7 @@ void StructuredMeshGenerator::generate( const Grid& grid, Mesh& mesh ) const {
         partitioner_type = "equal_regions";  // Only one part --> Trans is slower
 
     grid::Partitioner partitioner( partitioner_type, nb_parts );
-    grid::Distribution distribution( partitioner.partition( grid ) );
+    grid::Distribution distribution( grid, partitioner, util::Config( "compact", true ) );
     generate( grid, distribution, mesh );
 }
 
@@ -186,12 +193,12 @@ void StructuredMeshGenerator::generate( const Grid& grid, const grid::Distributi
 
     ASSERT( !mesh.generated() );
 
-    if ( grid.size() != distribution.partition().size() ) {
+    if ( grid.size() != distribution.size() ) {
         std::stringstream msg;
         msg << "Number of points in grid (" << grid.size()
             << ") different from "
                "number of points in grid distribution ("
-            << distribution.partition().size() << ")";
+            << distribution.size() << ")";
         throw eckit::AssertionFailed( msg.str(), Here() );
     }
 
@@ -217,10 +224,10 @@ void StructuredMeshGenerator::generate( const Grid& grid, const grid::Distributi
     Region region;
     generate_region( rg, distribution, mypart, region );
 
-    generate_mesh( rg, distribution, region, mesh );
+    generate_mesh( rg, region, mesh );
 }
 
-void StructuredMeshGenerator::generate_region( const grid::StructuredGrid& rg, const std::vector<int>& parts,
+void StructuredMeshGenerator::generate_region( const grid::StructuredGrid& rg, const grid::Distribution& distribution,
                                                int mypart, Region& region ) const {
     ATLAS_TRACE();
 
@@ -233,48 +240,44 @@ void StructuredMeshGenerator::generate_region( const grid::StructuredGrid& rg, c
     bool periodic_east_west = rg.periodic();
 
     int n;
-    /*
-Find min and max latitudes used by this part.
-*/
-    n             = 0;
-    int lat_north = -1;
-    for ( size_t jlat = 0; jlat < rg.ny(); ++jlat ) {
-        for ( size_t jlon = 0; jlon < rg.nx( jlat ); ++jlon ) {
-            if ( parts.at( n ) == mypart ) {
-                lat_north = jlat;
-                goto end_north;
-            }
-            ++n;
-        }
-    }
-end_north:
-
-    n             = rg.size() - 1;
-    int lat_south = -1;
-    for ( int jlat = rg.ny() - 1; jlat >= 0; --jlat ) {
-        for ( int jlon = rg.nx( jlat ) - 1; jlon >= 0; --jlon ) {
-            if ( parts.at( n ) == mypart ) {
-                lat_south = jlat;
-                goto end_south;
-            }
-            --n;
-        }
-    }
-end_south:
 
-    std::vector<int> offset( rg.ny(), 0 );
+    std::vector<int> offset( rg.ny() + 1, 0 );
 
     n = 0;
     for ( size_t jlat = 0; jlat < rg.ny(); ++jlat ) {
         offset.at( jlat ) = n;
         n += rg.nx( jlat );
     };
+    offset.at( rg.ny() ) = n;
+
+    auto latitude = [&offset]( gidx_t gidx ) -> int {
+        return std::upper_bound( offset.begin(), offset.end(), gidx ) - offset.begin() - 1;
+    };
+
+    /*
+Find min and max latitudes used by this part, from its runs of global indices
+*/
+    const std::vector<std::pair<gidx_t, gidx_t>> runs = distribution.runs( mypart );
+    if ( runs.empty() ) {
+        throw Exception(
+            "Trying to generate mesh with too many partitions. Reduce "
+            "the number of partitions.",
+            Here() );
+    }
+
+    int lat_north = latitude( runs.front().first );
+    int lat_south = latitude( runs.back().second - 1 );
 
     /*
 We need to connect to next region
 */
     if ( lat_north - 1 >= 0 && rg.nx( lat_north - 1 ) > 0 ) --lat_north;
     if ( size_t( lat_south + 1 ) <= rg.ny() - 1 && rg.nx( lat_south + 1 ) > 0 ) ++lat_south;
+    if ( lat_north >= 0 ) {
+        region.parts_begin = offset.at( lat_north );
+        region.parts.resize( offset.at( lat_south + 1 ) - offset.at( lat_north ) );
+        distribution.partition( offset.at( lat_north ), offset.at( lat_south + 1 ), region.parts.data() );
+    }
     region.lat_begin.resize( rg.ny(), -1 );
     region.lat_end.resize( rg.ny(), -1 );
     region.nb_lat_elems.resize( rg.ny(), 0 );
@@ -328,7 +331,7 @@ We need to connect to next region
         ipS2 = std::min( ipS1 + 1, endS );
 
         int jelem = 0;
-        int pE    = parts.at( offset.at( latN ) );
+        int pE    = region.partition( offset.at( latN ) );
 
 #if DEBUG_OUTPUT
         Log::info() << "=================\n";
@@ -342,27 +345,27 @@ We need to connect to next region
             Log::info() << "-------\n";
 #endif
 
-            // ASSERT(offset.at(latN)+ipN1 < parts.size());
-            // ASSERT(offset.at(latS)+ipS1 < parts.size());
+            // ASSERT(offset.at(latN)+ipN1 < distribution.size());
+            // ASSERT(offset.at(latS)+ipS1 < distribution.size());
 
             int pN1, pS1, pN2, pS2;
             if ( ipN1 != rg.nx( latN ) )
-                pN1 = parts.at( offset.at( latN ) + ipN1 );
+                pN1 = region.partition( offset.at( latN ) + ipN1 );
             else
-                pN1 = parts.at( offset.at( latN ) );
+                pN1 = region.partition( offset.at( latN ) );
             if ( ipS1 != rg.nx( latS ) )
-                pS1 = parts.at( offset.at( latS ) + ipS1 );
+                pS1 = region.partition( offset.at( latS ) + ipS1 );
             else
-                pS1 = parts.at( offset.at( latS ) );
+                pS1 = region.partition( offset.at( latS ) );
 
             if ( ipN2 == rg.nx( latN ) )
-                pN2 = parts.at( offset.at( latN ) );
+                pN2 = region.partition( offset.at( latN ) );
             else
-                pN2 = parts.at( offset.at( latN ) + ipN2 );
+                pN2 = region.partition( offset.at( latN ) + ipN2 );
             if ( ipS2 == rg.nx( latS ) )
-                pS2 = parts.at( offset.at( latS ) );
+                pS2 = region.partition( offset.at( latS ) );
             else
-                pS2 = parts.at( offset.at( latS ) + ipS2 );
+                pS2 = region.partition( offset.at( latS ) + ipS2 );
 
                 // Log::info()  << ipN1 << "("<<pN1<<") " << ipN2 <<"("<<pN2<<")" <<  std::endl;
                 // Log::info()  << ipS1 << "("<<pS2<<") " << ipS2 <<"("<<pS2<<")" <<  std::endl;
@@ -636,17 +639,22 @@ We need to connect to next region
     //  Log::info()  << "nb_quads = " << region.nquads << std::endl;
     //  Log::info()  << "nb_elems = " << nelems << std::endl;
 
-    int nb_region_nodes = 0;
     for ( int jlat = region.north; jlat <= region.south; ++jlat ) {
-        n                           = offset.at( jlat );
         region.lat_begin.at( jlat ) = std::max( 0, region.lat_begin.at( jlat ) );
-        for ( size_t jlon = 0; jlon < rg.nx( jlat ); ++jlon ) {
-            if ( parts.at( n ) == mypart ) {
-                region.lat_begin.at( jlat ) = std::min( region.lat_begin.at( jlat ), int( jlon ) );
-                region.lat_end.at( jlat )   = std::max( region.lat_end.at( jlat ), int( jlon ) );
+    }
+    for ( const auto& run : runs ) {
+        for ( gidx_t begin = run.first; begin < run.second; ) {
+            const int jlat   = latitude( begin );
+            const gidx_t end = std::min<gidx_t>( run.second, offset.at( jlat + 1 ) );
+            if ( jlat >= region.north && jlat <= region.south ) {
+                region.lat_begin.at( jlat ) = std::min( region.lat_begin.at( jlat ), int( begin - offset.at( jlat ) ) );
+                region.lat_end.at( jlat )   = std::max( region.lat_end.at( jlat ), int( end - 1 - offset.at( jlat ) ) );
             }
-            ++n;
+            begin = end;
         }
+    }
+    int nb_region_nodes = 0;
+    for ( int jlat = region.north; jlat <= region.south; ++jlat ) {
         nb_region_nodes += region.lat_end.at( jlat ) - region.lat_begin.at( jlat ) + 1;
 
         // Count extra periodic node
@@ -679,8 +687,7 @@ struct GhostNode {
 };
 }  // namespace
 
-void StructuredMeshGenerator::generate_mesh( const grid::StructuredGrid& rg, const std::vector<int>& parts,
-                                             const Region& region, Mesh& mesh ) const {
+void StructuredMeshGenerator::generate_mesh( const grid::StructuredGrid& rg, const Region& region, Mesh& mesh ) const {
     ATLAS_TRACE();
 
     ASSERT( !mesh.generated() );
@@ -809,7 +816,7 @@ void StructuredMeshGenerator::generate_mesh( const grid::StructuredGrid& rg, con
             for ( int jlon = region.lat_begin.at( jlat ); jlon <= region.lat_end.at( jlat ); ++jlon ) {
                 if ( jlon < rg.nx( jlat ) ) {
                     n = offset_glb.at( jlat ) + jlon;
-                    if ( parts.at( n ) == mypart ) {
+                    if ( region.partition( n ) == mypart ) {
                         node_numbering.at( jnode ) = node_number;
                         ++node_number;
                     }
@@ -822,7 +829,7 @@ void StructuredMeshGenerator::generate_mesh( const grid::StructuredGrid& rg, con
                 {
 //#warning TODO: use commented approach
                     part( jnode ) = mypart;
-                    // part(jnode)      = parts.at( offset_glb.at(jlat) );
+                    // part(jnode)      = distribution.partition( offset_glb.at(jlat) );
                     ghost( jnode ) = 1;
                     ghost_nodes.push_back( GhostNode( jlat, rg.nx( jlat ), jnode ) );
                     ++jnode;
@@ -873,14 +880,8 @@ void StructuredMeshGenerator::generate_mesh( const grid::StructuredGrid& rg, con
                 xy( inode, XX ) = x;
                 xy( inode, YY ) = y;
 
-                // geographic coordinates by using projection
-                double crd[] = {x, y};
-                rg.projection().xy2lonlat( crd );
-                lonlat( inode, LON ) = crd[LON];
-                lonlat( inode, LAT ) = crd[LAT];
-
                 glb_idx( inode ) = n + 1;
-                part( inode )    = parts.at( n );
+                part( inode )    = region.partition( n );
                 ghost( inode )   = 0;
                 Topology::reset( flags( inode ) );
                 if ( jlat == 0 && !include_north_pole ) {
@@ -908,15 +909,9 @@ void StructuredMeshGenerator::generate_mesh( const grid::StructuredGrid& rg, con
                 xy( inode, XX ) = x;
                 xy( inode, YY ) = y;
 
-                // geographic coordinates by using projection
-                double crd[] = {x, y};
-                rg.projection().xy2lonlat( crd );
-                lonlat( inode, LON ) = crd[LON];
-                lonlat( inode, LAT ) = crd[LAT];
-
                 glb_idx( inode ) = periodic_glb.at( jlat ) + 1;
 //#warning TODO: use commented approach
-                //        part(inode)      = parts.at( offset_glb.at(jlat) );
+                //        part(inode)      = distribution.partition( offset_glb.at(jlat) );
                 part( inode )  = mypart;  // The actual part will be fixed later
                 ghost( inode ) = 1;
                 Topology::reset( flags( inode ) );
@@ -939,12 +934,6 @@ void StructuredMeshGenerator::generate_mesh( const grid::StructuredGrid& rg, con
         xy( inode, XX ) = x;
         xy( inode, YY ) = y;
 
-        // geographic coordinates by using projection
-        double crd[] = {x, y};
-        rg.projection().xy2lonlat( crd );
-        lonlat( inode, LON ) = crd[LON];
-        lonlat( inode, LAT ) = crd[LAT];
-
         glb_idx( inode ) = periodic_glb.at( rg.ny() - 1 ) + 2;
         part( inode )    = mypart;
         ghost( inode )   = 0;
@@ -962,12 +951,6 @@ void StructuredMeshGenerator::generate_mesh( const grid::StructuredGrid& rg, con
         xy( inode, XX ) = x;
         xy( inode, YY ) = y;
 
-        // geographic coordinates by using projection
-        double crd[] = {x, y};
-        rg.projection().xy2lonlat( crd );
-        lonlat( inode, LON ) = crd[LON];
-        lonlat( inode, LAT ) = crd[LAT];
-
         glb_idx( inode ) = periodic_glb.at( rg.ny() - 1 ) + 3;
         part( inode )    = mypart;
         ghost( inode )   = 0;
@@ -976,6 +959,9 @@ void StructuredMeshGenerator::generate_mesh( const grid::StructuredGrid& rg, con
         ++jnode;
     }
 
+    // geographic coordinates by using projection, all nodes in one batch
+    rg.projection().xy2lonlat( nnodes, xy.data(), lonlat.data() );
+
     nodes.global_index().metadata().set( "human_readable", true );
     nodes.global_index().metadata().set( "min", 1 );
     nodes.global_index().metadata().set( "max", max_glb_idx );
@@ -12,6 +12,7 @@
 #include "eckit/exception/Exceptions.h"
 
 #include "atlas/array/ArrayView.h"
+#include "atlas/array/IndexView.h"
 #include "atlas/array/MakeView.h"
 #include "atlas/field/Field.h"
 #include "atlas/mesh/HybridElements.h"
@@ -19,6 +20,8 @@
 #include "atlas/mesh/Nodes.h"
 #include "atlas/numerics/fvm/Method.h"
 #include "atlas/numerics/fvm/Nabla.h"
+#include "atlas/parallel/HaloExchange.h"
+#include "atlas/parallel/mpi/mpi.h"
 #include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/util/CoordinateEnums.h"
@@ -65,6 +68,53 @@ void Nabla::setup() {
     pole_edges_.reserve( c );
     for ( size_t jedge = 0; jedge < c; ++jedge )
         pole_edges_.push_back( tmp[jedge] );
+
+    // Split edges and nodes in interior and boundary ones, based on the nodes that are
+    // updated by a halo exchange
+    const mesh::Nodes& nodes = fvm_->mesh().nodes();
+
+    const size_t nnodes = nodes.size();
+
+    const auto part  = array::make_view<int, 1>( nodes.partition() );
+    const auto ridx  = array::make_indexview<int, 1>( nodes.remote_index() );
+    const int mypart = mpi::comm().rank();
+
+    std::vector<bool> is_halo( nnodes );
+    for ( size_t jnode = 0; jnode < nnodes; ++jnode ) {
+        is_halo[jnode] = part( jnode ) != mypart || size_t( ridx( jnode ) ) != jnode;
+    }
+
+    const mesh::MultiBlockConnectivity& edge2node = edges.node_connectivity();
+    std::vector<bool> is_interior_edge( nedges );
+    std::vector<size_t> boundary_edges;
+    edges_.clear();
+    edges_.reserve( nedges );
+    for ( size_t jedge = 0; jedge < nedges; ++jedge ) {
+        is_interior_edge[jedge] = not is_halo[edge2node( jedge, 0 )] && not is_halo[edge2node( jedge, 1 )];
+        if ( is_interior_edge[jedge] )
+            edges_.push_back( jedge );
+        else
+            boundary_edges.push_back( jedge );
+    }
+    nb_interior_edges_ = edges_.size();
+    edges_.insert( edges_.end(), boundary_edges.begin(), boundary_edges.end() );
+
+    const mesh::Connectivity& node2edge = nodes.edge_connectivity();
+    std::vector<size_t> boundary_nodes;
+    nodes_.clear();
+    nodes_.reserve( nnodes );
+    for ( size_t jnode = 0; jnode < nnodes; ++jnode ) {
+        bool interior = not is_halo[jnode];
+        for ( size_t jedge = 0; interior && jedge < node2edge.cols( jnode ); ++jedge ) {
+            interior = is_interior_edge[node2edge( jnode, jedge )];
+        }
+        if ( interior )
+            nodes_.push_back( jnode );
+        else
+            boundary_nodes.push_back( jnode );
+    }
+    nb_interior_nodes_ = nodes_.size();
+    nodes_.insert( nodes_.end(), boundary_nodes.begin(), boundary_nodes.end() );
 }
 
 void Nabla::gradient( const Field& field, Field& grad_field ) const {
@@ -252,15 +302,19 @@ void Nabla::gradient_of_vector( const Field& vector_field, Field& grad_field ) c
 // ================================================================================
 
 void Nabla::divergence( const Field& vector_field, Field& div_field ) const {
+    array::ArrayT<double> avgS( fvm_->mesh().edges().size(), vector_field.levels(), 2ul );
+    divergence( vector_field, div_field, avgS, 0, edges_.size(), 0, nodes_.size() );
+}
+
+void Nabla::divergence( const Field& vector_field, Field& div_field, array::Array& avgS_arr, size_t edge_begin,
+                        size_t edge_end, size_t node_begin, size_t node_end ) const {
     const double radius  = fvm_->radius();
     const double deg2rad = M_PI / 180.;
 
     const mesh::Edges& edges = fvm_->mesh().edges();
     const mesh::Nodes& nodes = fvm_->mesh().nodes();
 
-    const size_t nnodes = nodes.size();
-    const size_t nedges = edges.size();
-    const size_t nlev   = vector_field.levels();
+    const size_t nlev = vector_field.levels();
     if ( div_field.levels() != nlev )
         throw eckit::AssertionFailed( "divergence field should have same number of levels", Here() );
 
@@ -279,19 +333,19 @@ void Nabla::divergence( const Field& vector_field, Field& div_field ) const {
     const mesh::Connectivity& node2edge           = nodes.edge_connectivity();
     const mesh::MultiBlockConnectivity& edge2node = edges.node_connectivity();
 
-    array::ArrayT<double> avgS_arr( nedges, nlev, 2ul );
     array::ArrayView<double, 3> avgS = array::make_view<double, 3>( avgS_arr );
 
     const double scale = deg2rad * deg2rad * radius;
 
     atlas_omp_parallel {
-        atlas_omp_for( size_t jedge = 0; jedge < nedges; ++jedge ) {
-            size_t ip1   = edge2node( jedge, 0 );
-            size_t ip2   = edge2node( jedge, 1 );
-            double y1    = lonlat_deg( ip1, LAT ) * deg2rad;
-            double y2    = lonlat_deg( ip2, LAT ) * deg2rad;
-            double cosy1 = std::cos( y1 );
-            double cosy2 = std::cos( y2 );
+        atlas_omp_for( size_t j = edge_begin; j < edge_end; ++j ) {
+            const size_t jedge = edges_[j];
+            size_t ip1         = edge2node( jedge, 0 );
+            size_t ip2         = edge2node( jedge, 1 );
+            double y1          = lonlat_deg( ip1, LAT ) * deg2rad;
+            double y2          = lonlat_deg( ip2, LAT ) * deg2rad;
+            double cosy1       = std::cos( y1 );
+            double cosy2       = std::cos( y2 );
 
             double pbc = 1. - edge_is_pole( jedge );
 
@@ -311,7 +365,8 @@ void Nabla::divergence( const Field& vector_field, Field& div_field ) const {
             }
         }
 
-        atlas_omp_for( size_t jnode = 0; jnode < nnodes; ++jnode ) {
+        atlas_omp_for( size_t j = node_begin; j < node_end; ++j ) {
+            const size_t jnode = nodes_[j];
             for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
                 div( jnode, jlev ) = 0.;
             }
@@ -414,8 +469,18 @@ void Nabla::laplacian( const Field& scalar, Field& lapl ) const {
     Field grad( fvm_->node_columns().createField<double>( option::name( "grad" ) | option::levels( scalar.levels() ) |
                                                           option::variables( 2 ) ) );
     gradient( scalar, grad );
-    if ( fvm_->node_columns().halo().size() < 2 ) fvm_->node_columns().haloExchange( grad );
-    divergence( grad, lapl );
+    if ( fvm_->node_columns().halo().size() < 2 ) {
+        // Compute the divergence on interior nodes while the halo of the gradient is exchanged
+        array::ArrayT<double> avgS( fvm_->mesh().edges().size(), grad.levels(), 2ul );
+
+        parallel::HaloExchange::Handle handle = fvm_->node_columns().haloExchangeStart( grad );
+        divergence( grad, lapl, avgS, 0, nb_interior_edges_, 0, nb_interior_nodes_ );
+        fvm_->node_columns().haloExchangeWait( handle );
+        divergence( grad, lapl, avgS, nb_interior_edges_, edges_.size(), nb_interior_nodes_, nodes_.size() );
+    }
+    else {
+        divergence( grad, lapl );
+    }
 }
 
 }  // namespace fvm
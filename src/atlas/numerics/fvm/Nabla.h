@@ -12,6 +12,7 @@
 
 #include <vector>
 
+#include "atlas/array_fwd.h"
 #include "atlas/numerics/Nabla.h"
 
 namespace atlas {
@@ -40,15 +41,31 @@ public:
     void curl( const Field& vector, Field& curl ) const;
     void laplacian( const Field& scalar, Field& laplacian ) const;
 
+    /// Number of nodes and edges that do not depend on values received by a halo exchange
+    size_t nb_interior_nodes() const { return nb_interior_nodes_; }
+    size_t nb_interior_edges() const { return nb_interior_edges_; }
+
 private:
     void setup();
 
     void gradient_of_scalar( const Field& scalar, Field& grad ) const;
     void gradient_of_vector( const Field& vector, Field& grad ) const;
 
+    /// Divergence on the edges edges_[edge_begin:edge_end] and nodes nodes_[node_begin:node_end]
+    void divergence( const Field& vector, Field& div, array::Array& avgS, size_t edge_begin, size_t edge_end,
+                     size_t node_begin, size_t node_end ) const;
+
 private:
     fvm::Method const* fvm_;
     std::vector<size_t> pole_edges_;
+
+    // Edges and nodes, with the interior ones first. Interior edges only connect nodes that are
+    // not updated by a halo exchange, and interior nodes only have interior edges. They can be
+    // computed while a halo exchange is in progress.
+    std::vector<size_t> edges_;
+    std::vector<size_t> nodes_;
+    size_t nb_interior_edges_;
+    size_t nb_interior_nodes_;
 };
 
 // ------------------------------------------------------------------
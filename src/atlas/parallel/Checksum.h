@@ -18,7 +18,9 @@
 
 #include "atlas/array/ArrayView.h"
 #include "atlas/parallel/GatherScatter.h"
+#include "atlas/parallel/mpi/Statistics.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/util/Checksum.h"
 
@@ -86,24 +88,25 @@ private:  // data
 template <typename DATA_TYPE>
 std::string Checksum::execute( const DATA_TYPE data[], const int var_strides[], const int var_extents[],
                                const int var_rank ) const {
-    size_t root = 0;
-
     if ( !is_setup_ ) { throw eckit::SeriousBug( "Checksum was not setup", Here() ); }
-    std::vector<util::checksum_t> local_checksums( parsize_ );
-    int var_size = var_extents[0] * var_strides[0];
-
-    for ( size_t pp = 0; pp < parsize_; ++pp ) {
-        local_checksums[pp] = util::checksum( data + pp * var_size, var_size );
+    const size_t var_size = var_extents[0] * var_strides[0];
+
+    // Every owned point contributes the hash of its values seeded with its global position.
+    // Summing these is independent of the order of points and of the partitioning, so that
+    // no point checksums need to be gathered: one reduction over tasks suffices.
+    const std::vector<int>& locmap = gather_->locmap_;
+    const std::vector<int>& locpos = gather_->locpos_;
+    const long nb_points           = long( locmap.size() );
+
+    util::checksum_t local_checksum = 0;
+    atlas_omp_pragma( omp parallel for reduction( + : local_checksum ) )
+    for ( long p = 0; p < nb_points; ++p ) {
+        local_checksum +=
+            util::checksum( data + size_t( locmap[p] ) * var_size, var_size, util::checksum_t( locpos[p] ) );
     }
 
-    std::vector<util::checksum_t> global_checksums( mpi::comm().rank() == root ? gather_->glb_dof() : 0 );
-    parallel::Field<util::checksum_t const> loc( local_checksums.data(), 1 );
-    parallel::Field<util::checksum_t> glb( global_checksums.data(), 1 );
-    gather_->gather( &loc, &glb, 1 );
-
-    util::checksum_t glb_checksum = util::checksum( global_checksums.data(), global_checksums.size() );
-
-    mpi::comm().broadcast( glb_checksum, root );
+    util::checksum_t glb_checksum = local_checksum;
+    ATLAS_TRACE_MPI( ALLREDUCE ) { mpi::comm().allReduceInPlace( glb_checksum, eckit::mpi::sum() ); }
 
     return eckit::Translator<util::checksum_t, std::string>()( glb_checksum );
 }
@@ -8,7 +8,9 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <numeric>
 #include <sstream>
 #include <stdexcept>
@@ -54,7 +56,13 @@ struct Node {
         i = idx;
     }
 
-    bool operator<( const Node& other ) const { return ( g < other.g ); }
+    // Ties on "g" are broken on partition and index, so that the node kept when removing
+    // duplicates does not depend on the order in which they were received
+    bool operator<( const Node& other ) const {
+        if ( g != other.g ) return ( g < other.g );
+        if ( p != other.p ) return ( p < other.p );
+        return ( i < other.i );
+    }
 
     bool operator==( const Node& other ) const { return ( g == other.g ); }
 };
@@ -63,6 +71,49 @@ bool operator<( const gidx_t g, const Node& n ) {
     return ( g < n.g );
 }
 
+// Number of samples each task contributes to the choice of splitters
+constexpr size_t nb_samples_per_task = 64;
+
+void displacements( const std::vector<int>& counts, std::vector<int>& displs ) {
+    displs.resize( counts.size() );
+    displs[0] = 0;
+    for ( size_t j = 1; j < counts.size(); ++j ) {
+        displs[j] = displs[j - 1] + counts[j - 1];
+    }
+}
+
+/// Splitters from a regular sample of every task's sorted nodes. Task j will own the
+/// nodes with global index g such that splitters[j-1] <= g < splitters[j].
+std::vector<gidx_t> splitters( const std::vector<Node>& nodes ) {
+    const auto& comm    = mpi::comm();
+    const size_t nparts = comm.size();
+
+    std::vector<gidx_t> samples;
+    const size_t nb_samples = std::min( nodes.size(), nb_samples_per_task );
+    for ( size_t j = 0; j < nb_samples; ++j ) {
+        samples.push_back( nodes[( j * nodes.size() ) / nb_samples].g );
+    }
+    std::vector<int> counts( nparts );
+    std::vector<int> displs;
+    ATLAS_TRACE_MPI( ALLGATHER ) { comm.allGather( int( samples.size() ), counts.begin(), counts.end() ); }
+    displacements( counts, displs );
+    std::vector<gidx_t> all_samples( displs.back() + counts.back() );
+    ATLAS_TRACE_MPI( ALLGATHER ) {
+        comm.allGatherv( samples.begin(), samples.end(), all_samples.data(), counts.data(), displs.data() );
+    }
+    std::sort( all_samples.begin(), all_samples.end() );
+    all_samples.erase( std::unique( all_samples.begin(), all_samples.end() ), all_samples.end() );
+
+    std::vector<gidx_t> split;
+    for ( size_t j = 1; j < nparts; ++j ) {
+        if ( all_samples.empty() ) { break; }
+        split.push_back( all_samples[( j * all_samples.size() ) / nparts] );
+    }
+    // tasks without splitter receive nothing
+    split.resize( nparts - 1, std::numeric_limits<gidx_t>::max() );
+    return split;
+}
+
 }  // namespace
 
 GatherScatter::GatherScatter() : name_(), is_setup_( false ) {
@@ -79,88 +130,133 @@ void GatherScatter::setup( const int part[], const int remote_idx[], const int b
                            const int mask[], const size_t parsize ) {
     ATLAS_TRACE( "GatherScatter::setup" );
 
-    parsize_ = parsize;
+    const auto& comm = mpi::comm();
 
-    glbcounts_.resize( nproc );
-    glbcounts_.assign( nproc, 0 );
-    glbdispls_.resize( nproc );
-    glbdispls_.assign( nproc, 0 );
-    const size_t nvar = 3;
+    parsize_ = parsize;
 
-    std::vector<gidx_t> sendnodes( parsize_ * nvar );
+    // The global ordering is computed with a distributed sort, so that no task holds more than
+    // its own nodes plus its share of the global range. Only the root of a gather/scatter
+    // stores the global map.
 
-    loccnt_ = 0;
+    // 1) Nodes to communicate, sorted on global index
+    std::vector<Node> nodes;
+    nodes.reserve( parsize_ );
     for ( size_t n = 0; n < parsize_; ++n ) {
-        if ( !mask[n] ) {
-            sendnodes[loccnt_++] = glb_idx[n];
-            sendnodes[loccnt_++] = part[n];
-            sendnodes[loccnt_++] = remote_idx[n] - base;
-        }
+        if ( !mask[n] ) { nodes.emplace_back( glb_idx[n], part[n], remote_idx[n] - base ); }
     }
+    ATLAS_TRACE_SCOPE( "sorting" ) { std::sort( nodes.begin(), nodes.end() ); }
 
-    ATLAS_TRACE_MPI( ALLGATHER ) { mpi::comm().allGather( loccnt_, glbcounts_.begin(), glbcounts_.end() ); }
-
-    glbcnt_ = std::accumulate( glbcounts_.begin(), glbcounts_.end(), 0 );
-
-    glbdispls_[0] = 0;
-    for ( size_t jproc = 1; jproc < nproc; ++jproc )  // start at 1
+    // 2) Send every node to the task owning its range of global indices
+    const size_t nvar = 3;
+    std::vector<int> sendcounts( nproc, 0 );
+    std::vector<int> recvcounts( nproc );
+    std::vector<int> senddispls, recvdispls;
     {
-        glbdispls_[jproc] = glbcounts_[jproc - 1] + glbdispls_[jproc - 1];
+        const std::vector<gidx_t> split = splitters( nodes );
+        size_t jproc                    = 0;
+        for ( const Node& node : nodes ) {
+            while ( jproc < nproc - 1 && node.g >= split[jproc] ) {
+                ++jproc;
+            }
+            sendcounts[jproc] += nvar;
+        }
+    }
+    ATLAS_TRACE_MPI( ALLTOALL ) { comm.allToAll( sendcounts, recvcounts ); }
+    displacements( sendcounts, senddispls );
+    displacements( recvcounts, recvdispls );
+
+    std::vector<gidx_t> sendnodes( nodes.size() * nvar );
+    for ( size_t n = 0; n < nodes.size(); ++n ) {
+        sendnodes[n * nvar + 0] = nodes[n].g;
+        sendnodes[n * nvar + 1] = nodes[n].p;
+        sendnodes[n * nvar + 2] = nodes[n].i;
     }
-    std::vector<gidx_t> recvnodes( glbcnt_ );
+    std::vector<Node>().swap( nodes );
 
-    ATLAS_TRACE_MPI( ALLGATHER ) {
-        mpi::comm().allGatherv( sendnodes.begin(), sendnodes.begin() + loccnt_, recvnodes.data(), glbcounts_.data(),
-                                glbdispls_.data() );
+    std::vector<gidx_t> recvnodes( recvdispls.back() + recvcounts.back() );
+    ATLAS_TRACE_MPI( ALLTOALL ) {
+        comm.allToAllv( sendnodes.data(), sendcounts.data(), senddispls.data(), recvnodes.data(), recvcounts.data(),
+                        recvdispls.data() );
     }
+    std::vector<gidx_t>().swap( sendnodes );
 
-    // Load recvnodes in sorting structure
-    size_t nb_recv_nodes = glbcnt_ / nvar;
-    std::vector<Node> node_sort( nb_recv_nodes );
+    // 3) Sort on "g" member and remove duplicates. The global position of an owned node
+    //    follows after the distinct nodes owned by lower tasks.
+    const size_t nb_recv_nodes = recvnodes.size() / nvar;
+    std::vector<Node> owned( nb_recv_nodes );
     for ( size_t n = 0; n < nb_recv_nodes; ++n ) {
-        node_sort[n].g = recvnodes[n * nvar + 0];
-        node_sort[n].p = recvnodes[n * nvar + 1];
-        node_sort[n].i = recvnodes[n * nvar + 2];
+        owned[n].g = recvnodes[n * nvar + 0];
+        owned[n].p = recvnodes[n * nvar + 1];
+        owned[n].i = recvnodes[n * nvar + 2];
     }
+    std::vector<gidx_t>().swap( recvnodes );
 
-    recvnodes.clear();
-
-    // Sort on "g" member, and remove duplicates
     ATLAS_TRACE_SCOPE( "sorting" ) {
-        std::sort( node_sort.begin(), node_sort.end() );
-        node_sort.erase( std::unique( node_sort.begin(), node_sort.end() ), node_sort.end() );
+        std::sort( owned.begin(), owned.end() );
+        owned.erase( std::unique( owned.begin(), owned.end() ), owned.end() );
     }
-    glbcounts_.assign( nproc, 0 );
-    glbdispls_.assign( nproc, 0 );
-    for ( size_t n = 0; n < node_sort.size(); ++n ) {
-        ++glbcounts_[node_sort[n].p];
+
+    std::vector<int> nb_owned( nproc );
+    ATLAS_TRACE_MPI( ALLGATHER ) { comm.allGather( int( owned.size() ), nb_owned.begin(), nb_owned.end() ); }
+    const int offset = std::accumulate( nb_owned.begin(), nb_owned.begin() + myproc, 0 );
+
+    // 4) Return ( global position, local index ) of every node to its partition
+    sendcounts.assign( nproc, 0 );
+    for ( const Node& node : owned ) {
+        sendcounts[node.p] += 2;
     }
-    glbdispls_[0] = 0;
+    ATLAS_TRACE_MPI( ALLTOALL ) { comm.allToAll( sendcounts, recvcounts ); }
+    displacements( sendcounts, senddispls );
+    displacements( recvcounts, recvdispls );
 
-    for ( size_t jproc = 1; jproc < nproc; ++jproc )  // start at 1
+    std::vector<int> sendpos( 2 * owned.size() );
     {
-        glbdispls_[jproc] = glbcounts_[jproc - 1] + glbdispls_[jproc - 1];
+        std::vector<int> idx( senddispls );
+        for ( size_t n = 0; n < owned.size(); ++n ) {
+            const size_t jproc    = owned[n].p;
+            sendpos[idx[jproc]++] = offset + int( n );
+            sendpos[idx[jproc]++] = int( owned[n].i );
+        }
+    }
+    std::vector<Node>().swap( owned );
+
+    std::vector<int> recvpos( recvdispls.back() + recvcounts.back() );
+    ATLAS_TRACE_MPI( ALLTOALL ) {
+        comm.allToAllv( sendpos.data(), sendcounts.data(), senddispls.data(), recvpos.data(), recvcounts.data(),
+                        recvdispls.data() );
     }
-    glbcnt_ = std::accumulate( glbcounts_.begin(), glbcounts_.end(), 0 );
-    loccnt_ = glbcounts_[myproc];
 
-    glbmap_.clear();
-    glbmap_.resize( glbcnt_ );
-    locmap_.clear();
+    // 5) Every task sent its nodes in increasing global position, and tasks own increasing ranges,
+    //    so the received nodes are already in global order
+    loccnt_ = int( recvpos.size() / 2 );
     locmap_.resize( loccnt_ );
-    std::vector<int> idx( nproc, 0 );
-    for ( size_t n = 0; n < node_sort.size(); ++n ) {
-        size_t jproc                            = node_sort[n].p;
-        glbmap_[glbdispls_[jproc] + idx[jproc]] = n;
+    locpos_.resize( loccnt_ );
+    for ( int n = 0; n < loccnt_; ++n ) {
+        locpos_[n] = recvpos[2 * n + 0];
+        locmap_[n] = recvpos[2 * n + 1];
+    }
 
-        if ( jproc == myproc ) locmap_[idx[jproc]] = node_sort[n].i;
+    glbcounts_.resize( nproc );
+    ATLAS_TRACE_MPI( ALLGATHER ) { comm.allGather( loccnt_, glbcounts_.begin(), glbcounts_.end() ); }
+    displacements( glbcounts_, glbdispls_ );
+    glbcnt_ = std::accumulate( glbcounts_.begin(), glbcounts_.end(), 0 );
 
-        ++idx[jproc];
-    }
+    // 6) The global map is only gathered to the root of the first gather/scatter, and not
+    //    at all when only the local map is needed (e.g. by Checksum)
+    glbmap_root_ = nproc;
+    std::vector<int>().swap( glbmap_ );
 
     is_setup_ = true;
 }
 
+void GatherScatter::gather_glbmap( const size_t root ) const {
+    if ( glbmap_root_ == root ) { return; }
+    ATLAS_TRACE( "GatherScatter::gather_glbmap" );
+    std::vector<int>( glb_cnt( root ) ).swap( glbmap_ );
+    ATLAS_TRACE_MPI( GATHER ) { mpi::comm().gatherv( locpos_, glbmap_, glbcounts_, glbdispls_, root ); }
+    glbmap_root_ = root;
+}
+
 void GatherScatter::setup( const int part[], const int remote_idx[], const int base, const gidx_t glb_idx[],
                            const size_t parsize ) {
     std::vector<int> mask( parsize );
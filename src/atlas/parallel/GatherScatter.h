@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <functional>
 #include <stdexcept>
 #include <vector>
 
@@ -18,6 +20,7 @@
 
 #include "atlas/array/ArrayView.h"
 #include "atlas/library/config.h"
+#include "atlas/parallel/mpi/Statistics.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/runtime/Log.h"
 
@@ -164,6 +167,19 @@ public:  // methods
     void gather( const array::ArrayView<DATA_TYPE, LRANK>& ldata, array::ArrayView<DATA_TYPE, GRANK>& gdata,
                  const size_t root = 0 ) const;
 
+    /// @brief Gather a field to root in chunks of its second variable dimension (the levels of a
+    ///        leveled field), without ever holding the complete global field.
+    ///
+    /// The chunks are sent with non-blocking messages, and the next chunk is already in flight while
+    /// the callback processes the current one. On root, callback( chunk, begin, end ) is called once
+    /// per chunk, in order, with the values of [begin,end) of all global points, contiguous per point
+    /// and in the order of the variable dimensions. The callback is not called on other tasks.
+    /// Memory on root is bounded by three chunks, i.e. glb_dof() * chunk * (size of one level).
+    template <typename DATA_TYPE>
+    void gather( const parallel::Field<DATA_TYPE const>& lfield, const size_t chunk,
+                 const std::function<void( const DATA_TYPE[], size_t begin, size_t end )>& callback,
+                 const size_t root = 0 ) const;
+
     template <typename DATA_TYPE>
     void scatter( parallel::Field<DATA_TYPE const> gfields[], parallel::Field<DATA_TYPE> lfields[],
                   const size_t nb_fields, const size_t root = 0 ) const;
@@ -183,6 +199,13 @@ public:  // methods
     void scatter( const array::ArrayView<DATA_TYPE, GRANK>& gdata, array::ArrayView<DATA_TYPE, LRANK>& ldata,
                   const size_t root = 0 ) const;
 
+    /// @brief Scatter a field from root in chunks of its second variable dimension, the inverse of
+    ///        the chunked gather. On root, callback( chunk, begin, end ) fills each chunk in the same
+    ///        layout, while the previous chunk is still being sent.
+    template <typename DATA_TYPE>
+    void scatter( const std::function<void( DATA_TYPE[], size_t begin, size_t end )>& callback,
+                  const parallel::Field<DATA_TYPE>& lfield, const size_t chunk, const size_t root = 0 ) const;
+
     int glb_dof() const { return glbcnt_; }
 
     int loc_dof() const { return loccnt_; }
@@ -196,6 +219,18 @@ private:  // methods
     void unpack_recv_buffer( const std::vector<int>& recvmap, const DATA_TYPE recv_buffer[],
                              const parallel::Field<DATA_TYPE>& field ) const;
 
+    /// Gather the global map to given root, if not already there. Collective.
+    void gather_glbmap( const size_t root ) const;
+
+    /// Number of chunks of given size in the chunked dimension of the field, and the field
+    /// restricted to [begin,end) of that dimension
+    template <typename DATA_TYPE>
+    static size_t nb_chunks( const parallel::Field<DATA_TYPE>& field, const size_t chunk );
+
+    template <typename DATA_TYPE>
+    static parallel::Field<DATA_TYPE> chunk_of( const parallel::Field<DATA_TYPE>& field, const size_t chunk,
+                                                const size_t jchunk, size_t& begin, size_t& end );
+
     template <typename DATA_TYPE, int RANK>
     void var_info( const array::ArrayView<DATA_TYPE, RANK>& arr, std::vector<size_t>& varstrides,
                    std::vector<size_t>& varshape ) const;
@@ -207,7 +242,11 @@ private:  // data
     std::vector<int> glbcounts_;
     std::vector<int> glbdispls_;
     std::vector<int> locmap_;
-    std::vector<int> glbmap_;
+    std::vector<int> locpos_;  // global position of every node in locmap_
+
+    // Only stored on one task at a time: the root of the last gather/scatter
+    mutable std::vector<int> glbmap_;
+    mutable size_t glbmap_root_;
 
     size_t nproc;
     size_t myproc;
@@ -227,6 +266,8 @@ void GatherScatter::gather( parallel::Field<DATA_TYPE const> lfields[], parallel
                             size_t nb_fields, const size_t root ) const {
     if ( !is_setup_ ) { throw eckit::SeriousBug( "GatherScatter was not setup", Here() ); }
 
+    gather_glbmap( root );
+
     for ( size_t jfield = 0; jfield < nb_fields; ++jfield ) {
         const size_t lvar_size = std::accumulate( lfields[jfield].var_shape.data(),
                                                   lfields[jfield].var_shape.data() + lfields[jfield].var_rank, 1,
@@ -273,6 +314,8 @@ void GatherScatter::scatter( parallel::Field<DATA_TYPE const> gfields[], paralle
                              const size_t nb_fields, const size_t root ) const {
     if ( !is_setup_ ) { throw eckit::SeriousBug( "GatherScatter was not setup", Here() ); }
 
+    gather_glbmap( root );
+
     for ( size_t jfield = 0; jfield < nb_fields; ++jfield ) {
         const int lvar_size =
             std::accumulate( lfields[jfield].var_shape.data(),
@@ -316,6 +359,216 @@ void GatherScatter::scatter( const DATA_TYPE gdata[], const size_t gvar_strides[
     scatter( &gfield, &lfield, 1, root );
 }
 
+template <typename DATA_TYPE>
+size_t GatherScatter::nb_chunks( const parallel::Field<DATA_TYPE>& field, const size_t chunk ) {
+    ASSERT( chunk > 0 );
+    // The first variable dimension also determines the stride between points, so a field with a
+    // single variable dimension is not split
+    if ( field.var_rank < 2 ) { return 1; }
+    return std::max<size_t>( 1, ( field.var_shape[1] + chunk - 1 ) / chunk );
+}
+
+template <typename DATA_TYPE>
+parallel::Field<DATA_TYPE> GatherScatter::chunk_of( const parallel::Field<DATA_TYPE>& field, const size_t chunk,
+                                                    const size_t jchunk, size_t& begin, size_t& end ) {
+    parallel::Field<DATA_TYPE> part( field );
+    if ( field.var_rank < 2 ) {
+        begin = 0;
+        end   = 1;
+        return part;
+    }
+    begin = std::min( jchunk * chunk, field.var_shape[1] );
+    end   = std::min( begin + chunk, field.var_shape[1] );
+    part.data += begin * field.var_strides[1];
+    part.var_shape[1] = end - begin;
+    return part;
+}
+
+template <typename DATA_TYPE>
+void GatherScatter::gather( const parallel::Field<DATA_TYPE const>& lfield, const size_t chunk,
+                            const std::function<void( const DATA_TYPE[], size_t begin, size_t end )>& callback,
+                            const size_t root ) const {
+    if ( !is_setup_ ) { throw eckit::SeriousBug( "GatherScatter was not setup", Here() ); }
+
+    ATLAS_TRACE( "GatherScatter::gather (chunked)" );
+
+    gather_glbmap( root );
+
+    const int tag           = 2;
+    const size_t nchunks    = nb_chunks( lfield, chunk );
+    const size_t max_chunk  = lfield.var_rank < 2 ? 1 : std::min( chunk, lfield.var_shape[1] );
+    const size_t var_size   = std::accumulate( lfield.var_shape.data(), lfield.var_shape.data() + lfield.var_rank,
+                                               size_t( 1 ), std::multiplies<size_t>() );
+    const size_t level_size = lfield.var_rank < 2 ? var_size : var_size / std::max<size_t>( lfield.var_shape[1], 1 );
+    const size_t chunk_size = level_size * max_chunk;
+
+    // Double buffered: while chunk k is unpacked and processed, chunk k+1 is being received
+    std::vector<DATA_TYPE> buffer[2];
+    std::vector<eckit::mpi::Request> requests[2];
+    std::vector<DATA_TYPE> glb_chunk;
+
+    const auto& comm = mpi::comm();
+
+    auto post = [&]( size_t jchunk ) {
+        size_t begin, end;
+        parallel::Field<DATA_TYPE const> part = chunk_of( lfield, chunk, jchunk, begin, end );
+        const size_t size                     = level_size * ( end - begin );
+        std::vector<DATA_TYPE>& buf           = buffer[jchunk % 2];
+        std::vector<eckit::mpi::Request>& req = requests[jchunk % 2];
+        if ( myproc == root ) {
+            buf.resize( glbcnt_ * chunk_size );
+            req.clear();
+            ATLAS_TRACE_MPI( IRECEIVE ) {
+                for ( size_t jproc = 0; jproc < nproc; ++jproc ) {
+                    if ( jproc == root || glbcounts_[jproc] == 0 ) { continue; }
+                    req.push_back(
+                        comm.iReceive( buf.data() + glbdispls_[jproc] * size, glbcounts_[jproc] * size, jproc, tag ) );
+                }
+            }
+            pack_send_buffer( part, locmap_, buf.data() + glbdispls_[root] * size );
+        }
+        else {
+            // The buffer was last used to send chunk k-2
+            ATLAS_TRACE_MPI( WAIT ) {
+                for ( auto& r : req ) {
+                    comm.wait( r );
+                }
+            }
+            req.clear();
+            buf.resize( loccnt_ * chunk_size );
+            pack_send_buffer( part, locmap_, buf.data() );
+            if ( loccnt_ ) {
+                ATLAS_TRACE_MPI( ISEND ) { req.push_back( comm.iSend( buf.data(), loccnt_ * size, root, tag ) ); }
+            }
+        }
+    };
+
+    if ( myproc == root ) { glb_chunk.resize( glbcnt_ * chunk_size ); }
+
+    post( 0 );
+    for ( size_t jchunk = 0; jchunk < nchunks; ++jchunk ) {
+        if ( jchunk + 1 < nchunks ) { post( jchunk + 1 ); }
+        if ( myproc == root ) {
+            ATLAS_TRACE_MPI( WAIT ) {
+                for ( auto& r : requests[jchunk % 2] ) {
+                    comm.wait( r );
+                }
+            }
+            size_t begin, end;
+            chunk_of( lfield, chunk, jchunk, begin, end );
+            const size_t size = level_size * ( end - begin );
+            parallel::Field<DATA_TYPE> glb( glb_chunk.data(), size );
+            unpack_recv_buffer( glbmap_, buffer[jchunk % 2].data(), glb );
+            callback( glb_chunk.data(), begin, end );
+        }
+    }
+
+    if ( myproc != root ) {
+        ATLAS_TRACE_MPI( WAIT ) {
+            for ( auto& req : requests ) {
+                for ( auto& r : req ) {
+                    comm.wait( r );
+                }
+            }
+        }
+    }
+}
+
+template <typename DATA_TYPE>
+void GatherScatter::scatter( const std::function<void( DATA_TYPE[], size_t begin, size_t end )>& callback,
+                             const parallel::Field<DATA_TYPE>& lfield, const size_t chunk, const size_t root ) const {
+    if ( !is_setup_ ) { throw eckit::SeriousBug( "GatherScatter was not setup", Here() ); }
+
+    ATLAS_TRACE( "GatherScatter::scatter (chunked)" );
+
+    gather_glbmap( root );
+
+    const int tag           = 3;
+    const size_t nchunks    = nb_chunks( lfield, chunk );
+    const size_t max_chunk  = lfield.var_rank < 2 ? 1 : std::min( chunk, lfield.var_shape[1] );
+    const size_t var_size   = std::accumulate( lfield.var_shape.data(), lfield.var_shape.data() + lfield.var_rank,
+                                               size_t( 1 ), std::multiplies<size_t>() );
+    const size_t level_size = lfield.var_rank < 2 ? var_size : var_size / std::max<size_t>( lfield.var_shape[1], 1 );
+    const size_t chunk_size = level_size * max_chunk;
+
+    // Double buffered: while chunk k is being sent, chunk k+1 is filled by the callback (root),
+    // or already being received (other tasks)
+    std::vector<DATA_TYPE> buffer[2];
+    std::vector<eckit::mpi::Request> requests[2];
+    std::vector<DATA_TYPE> glb_chunk;
+
+    const auto& comm = mpi::comm();
+
+    auto post_receive = [&]( size_t jchunk ) {
+        size_t begin, end;
+        chunk_of( lfield, chunk, jchunk, begin, end );
+        const size_t size           = level_size * ( end - begin );
+        std::vector<DATA_TYPE>& buf = buffer[jchunk % 2];
+        buf.resize( loccnt_ * chunk_size );
+        requests[jchunk % 2].clear();
+        if ( loccnt_ ) {
+            ATLAS_TRACE_MPI( IRECEIVE ) {
+                requests[jchunk % 2].push_back( comm.iReceive( buf.data(), loccnt_ * size, root, tag ) );
+            }
+        }
+    };
+
+    if ( myproc == root ) { glb_chunk.resize( glbcnt_ * chunk_size ); }
+    else {
+        post_receive( 0 );
+    }
+
+    for ( size_t jchunk = 0; jchunk < nchunks; ++jchunk ) {
+        size_t begin, end;
+        parallel::Field<DATA_TYPE> part = chunk_of( lfield, chunk, jchunk, begin, end );
+        const size_t size               = level_size * ( end - begin );
+        std::vector<DATA_TYPE>& buf     = buffer[jchunk % 2];
+        auto& req                       = requests[jchunk % 2];
+
+        if ( myproc == root ) {
+            callback( glb_chunk.data(), begin, end );
+
+            // The buffer was last used to send chunk k-2
+            ATLAS_TRACE_MPI( WAIT ) {
+                for ( auto& r : req ) {
+                    comm.wait( r );
+                }
+            }
+            req.clear();
+            buf.resize( glbcnt_ * chunk_size );
+            parallel::Field<DATA_TYPE const> glb( glb_chunk.data(), size );
+            pack_send_buffer( glb, glbmap_, buf.data() );
+            ATLAS_TRACE_MPI( ISEND ) {
+                for ( size_t jproc = 0; jproc < nproc; ++jproc ) {
+                    if ( jproc == root || glbcounts_[jproc] == 0 ) { continue; }
+                    req.push_back(
+                        comm.iSend( buf.data() + glbdispls_[jproc] * size, glbcounts_[jproc] * size, jproc, tag ) );
+                }
+            }
+            unpack_recv_buffer( locmap_, buf.data() + glbdispls_[root] * size, part );
+        }
+        else {
+            if ( jchunk + 1 < nchunks ) { post_receive( jchunk + 1 ); }
+            ATLAS_TRACE_MPI( WAIT ) {
+                for ( auto& r : req ) {
+                    comm.wait( r );
+                }
+            }
+            unpack_recv_buffer( locmap_, buf.data(), part );
+        }
+    }
+
+    if ( myproc == root ) {
+        ATLAS_TRACE_MPI( WAIT ) {
+            for ( auto& req : requests ) {
+                for ( auto& r : req ) {
+                    comm.wait( r );
+                }
+            }
+        }
+    }
+}
+
 template <typename DATA_TYPE>
 void GatherScatter::pack_send_buffer( const parallel::Field<DATA_TYPE const>& field, const std::vector<int>& sendmap,
                                       DATA_TYPE send_buffer[] ) const {
@@ -129,6 +129,19 @@ void HaloExchange::setup( const int part[], const int remote_idx[], const int ba
     for ( int jj = 0; jj < sendcnt_; ++jj )
         sendmap_[jj] = recv_requests[jj];
 
+    /*
+  Only communicate with procs that have something to send or receive
+*/
+    send_neighbours_.clear();
+    recv_neighbours_.clear();
+    for ( int jproc = 0; jproc < nproc; ++jproc ) {
+        if ( sendcounts_[jproc] > 0 ) send_neighbours_.push_back( jproc );
+        if ( recvcounts_[jproc] > 0 ) recv_neighbours_.push_back( jproc );
+    }
+
+    // Plans of a previous setup have the wrong buffer sizes
+    plans_.clear();
+
     is_setup_        = true;
     backdoor.parsize = parsize_;
 }
@@ -137,6 +150,243 @@ void HaloExchange::setup( const int part[], const int remote_idx[], const int ba
 
 namespace {
 
+/// Type erased packing of an array with parallel first dimension into a byte buffer
+struct MultiFieldPacker {
+    array::Array* array;
+    size_t var_size;
+    size_t value_size;
+    void ( *pack )( array::Array&, const int* map, int cnt, char* buffer );
+    void ( *unpack )( array::Array&, const int* map, int cnt, const char* buffer );
+
+    /// Bytes for cnt nodes, rounded up to keep every segment in the buffer aligned
+    size_t bytes( int cnt ) const {
+        constexpr size_t alignment = sizeof( double );
+        return ( ( cnt * var_size * value_size + alignment - 1 ) / alignment ) * alignment;
+    }
+};
+
+template <typename DATA_TYPE, int RANK>
+struct MultiFieldPackerImpl {
+    static void pack( array::Array& arr, const int* map, int cnt, char* buffer ) {
+        auto field = array::make_host_view<DATA_TYPE, RANK>( arr );
+        const array::SVector<int> sendmap( const_cast<int*>( map ), cnt );
+        array::SVector<DATA_TYPE> send_buffer( reinterpret_cast<DATA_TYPE*>( buffer ),
+                                               cnt * array::get_var_size<0>( field ) );
+        halo_packer<0, RANK>::pack( cnt, sendmap, field, send_buffer );
+    }
+    static void unpack( array::Array& arr, const int* map, int cnt, const char* buffer ) {
+        auto field = array::make_host_view<DATA_TYPE, RANK>( arr );
+        const array::SVector<int> recvmap( const_cast<int*>( map ), cnt );
+        const array::SVector<DATA_TYPE> recv_buffer( reinterpret_cast<DATA_TYPE*>( const_cast<char*>( buffer ) ),
+                                                     cnt * array::get_var_size<0>( field ) );
+        halo_packer<0, RANK>::unpack( cnt, recvmap, recv_buffer, field );
+    }
+    static MultiFieldPacker create( array::Array& arr ) {
+        auto field = array::make_host_view<DATA_TYPE, RANK, array::Intent::ReadOnly>( arr );
+        return MultiFieldPacker{&arr, array::get_var_size<0>( field ), sizeof( DATA_TYPE ), &pack, &unpack};
+    }
+};
+
+template <typename DATA_TYPE>
+MultiFieldPacker make_packer( array::Array& arr ) {
+    switch ( arr.rank() ) {
+        case 1:
+            return MultiFieldPackerImpl<DATA_TYPE, 1>::create( arr );
+        case 2:
+            return MultiFieldPackerImpl<DATA_TYPE, 2>::create( arr );
+        case 3:
+            return MultiFieldPackerImpl<DATA_TYPE, 3>::create( arr );
+        case 4:
+            return MultiFieldPackerImpl<DATA_TYPE, 4>::create( arr );
+        default:
+            throw eckit::AssertionFailed( "Rank not supported in halo exchange", Here() );
+    }
+}
+
+MultiFieldPacker make_packer( array::Array& arr ) {
+    switch ( arr.datatype().kind() ) {
+        case array::DataType::KIND_INT32:
+            return make_packer<int>( arr );
+        case array::DataType::KIND_INT64:
+            return make_packer<long>( arr );
+        case array::DataType::KIND_REAL32:
+            return make_packer<float>( arr );
+        case array::DataType::KIND_REAL64:
+            return make_packer<double>( arr );
+        default:
+            throw eckit::Exception( "datatype not supported", Here() );
+    }
+}
+
+}  // namespace
+
+HaloExchange::Handle::Handle( Handle&& other ) :
+    halo_exchange_( other.halo_exchange_ ),
+    fields_( std::move( other.fields_ ) ),
+    send_buffer_( std::move( other.send_buffer_ ) ),
+    recv_buffer_( std::move( other.recv_buffer_ ) ),
+    send_req_( std::move( other.send_req_ ) ),
+    recv_req_( std::move( other.recv_req_ ) ),
+    active_( other.active_ ) {
+    other.active_ = false;
+}
+
+HaloExchange::Handle& HaloExchange::Handle::operator=( Handle&& other ) {
+    ASSERT( not active_ );
+    halo_exchange_ = other.halo_exchange_;
+    fields_        = std::move( other.fields_ );
+    send_buffer_   = std::move( other.send_buffer_ );
+    recv_buffer_   = std::move( other.recv_buffer_ );
+    send_req_      = std::move( other.send_req_ );
+    recv_req_      = std::move( other.recv_req_ );
+    active_        = other.active_;
+    other.active_  = false;
+    return *this;
+}
+
+HaloExchange::Handle::~Handle() {
+    if ( active_ ) {
+        // MPI may still read and write the buffers
+        for ( eckit::mpi::Request& req : recv_req_ ) {
+            mpi::comm().wait( req );
+        }
+        for ( eckit::mpi::Request& req : send_req_ ) {
+            mpi::comm().wait( req );
+        }
+    }
+}
+
+void HaloExchange::execute( const std::vector<array::Array*>& fields ) const {
+    ATLAS_TRACE( "HaloExchange", {"halo-exchange"} );
+    Handle handle;
+    start( fields, handle );
+    wait( handle );
+}
+
+HaloExchange::Handle HaloExchange::start( const std::vector<array::Array*>& fields ) const {
+    Handle handle;
+    start( fields, handle );
+    return handle;
+}
+
+namespace {
+// Per neighbour, the buffers contain one segment per field
+size_t message_size( const std::vector<MultiFieldPacker>& packers, int cnt ) {
+    size_t bytes = 0;
+    for ( const MultiFieldPacker& packer : packers ) {
+        bytes += packer.bytes( cnt );
+    }
+    return bytes;
+}
+
+std::vector<MultiFieldPacker> make_packers( const std::vector<array::Array*>& fields ) {
+    std::vector<MultiFieldPacker> packers;
+    packers.reserve( fields.size() );
+    for ( array::Array* field : fields ) {
+        packers.push_back( make_packer( *field ) );
+    }
+    return packers;
+}
+}  // namespace
+
+void HaloExchange::start( const std::vector<array::Array*>& fields, Handle& handle ) const {
+    if ( !is_setup_ ) { throw eckit::SeriousBug( "HaloExchange was not setup", Here() ); }
+    if ( handle.active_ ) { throw eckit::SeriousBug( "HaloExchange::Handle is still in use", Here() ); }
+
+    ATLAS_TRACE( "HaloExchange::start", {"halo-exchange"} );
+
+    const int tag = 1;
+
+    std::vector<MultiFieldPacker> packers = make_packers( fields );
+
+    size_t send_size = 0;
+    for ( int jproc : send_neighbours_ ) {
+        send_size += message_size( packers, sendcounts_[jproc] );
+    }
+    size_t recv_size = 0;
+    for ( int jproc : recv_neighbours_ ) {
+        recv_size += message_size( packers, recvcounts_[jproc] );
+    }
+    if ( handle.send_buffer_.size() < send_size ) { handle.send_buffer_.resize( send_size ); }
+    if ( handle.recv_buffer_.size() < recv_size ) { handle.recv_buffer_.resize( recv_size ); }
+    handle.send_req_.resize( send_neighbours_.size() );
+    handle.recv_req_.resize( recv_neighbours_.size() );
+
+    ATLAS_TRACE_MPI( IRECEIVE ) {
+        size_t offset = 0;
+        for ( size_t j = 0; j < recv_neighbours_.size(); ++j ) {
+            const int jproc     = recv_neighbours_[j];
+            const size_t bytes  = message_size( packers, recvcounts_[jproc] );
+            handle.recv_req_[j] = mpi::comm().iReceive( handle.recv_buffer_.data() + offset, bytes, jproc, tag );
+            offset += bytes;
+        }
+    }
+
+    ATLAS_TRACE_SCOPE( "pack" ) {
+        char* buffer = handle.send_buffer_.data();
+        for ( int jproc : send_neighbours_ ) {
+            for ( const MultiFieldPacker& packer : packers ) {
+                packer.pack( *packer.array, sendmap_.data() + senddispls_[jproc], sendcounts_[jproc], buffer );
+                buffer += packer.bytes( sendcounts_[jproc] );
+            }
+        }
+    }
+
+    ATLAS_TRACE_MPI( ISEND ) {
+        size_t offset = 0;
+        for ( size_t j = 0; j < send_neighbours_.size(); ++j ) {
+            const int jproc     = send_neighbours_[j];
+            const size_t bytes  = message_size( packers, sendcounts_[jproc] );
+            handle.send_req_[j] = mpi::comm().iSend( handle.send_buffer_.data() + offset, bytes, jproc, tag );
+            offset += bytes;
+        }
+    }
+
+    handle.halo_exchange_ = this;
+    handle.fields_        = fields;
+    handle.active_        = true;
+}
+
+void HaloExchange::wait( Handle& handle ) const {
+    if ( not handle.active_ ) { throw eckit::SeriousBug( "HaloExchange::Handle was not started", Here() ); }
+    if ( handle.halo_exchange_ != this ) {
+        throw eckit::SeriousBug( "HaloExchange::Handle was started by a different HaloExchange", Here() );
+    }
+
+    ATLAS_TRACE( "HaloExchange::wait", {"halo-exchange"} );
+
+    std::vector<MultiFieldPacker> packers = make_packers( handle.fields_ );
+
+    ATLAS_TRACE_MPI( WAIT, "mpi-wait receive" ) {
+        for ( size_t j = 0; j < recv_neighbours_.size(); ++j ) {
+            mpi::comm().wait( handle.recv_req_[j] );
+        }
+    }
+
+    ATLAS_TRACE_SCOPE( "unpack" ) {
+        const char* buffer = handle.recv_buffer_.data();
+        for ( int jproc : recv_neighbours_ ) {
+            for ( const MultiFieldPacker& packer : packers ) {
+                packer.unpack( *packer.array, recvmap_.data() + recvdispls_[jproc], recvcounts_[jproc], buffer );
+                buffer += packer.bytes( recvcounts_[jproc] );
+            }
+        }
+    }
+
+    ATLAS_TRACE_MPI( WAIT, "mpi-wait send" ) {
+        for ( size_t j = 0; j < send_neighbours_.size(); ++j ) {
+            mpi::comm().wait( handle.send_req_[j] );
+        }
+    }
+
+    handle.fields_.clear();
+    handle.active_ = false;
+}
+
+/////////////////////
+
+namespace {
+
 template <typename Value>
 void execute_halo_exchange( HaloExchange* This, Value field[], int var_strides[], int var_extents[], int var_rank ) {
     // WARNING: Only works if there is only one parallel dimension AND being
@@ -13,13 +13,17 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "atlas/parallel/HaloExchangeImpl.h"
 #include "atlas/parallel/mpi/Statistics.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "eckit/exception/Exceptions.h"
 #include "eckit/memory/Owned.h"
 #include "eckit/memory/SharedPtr.h"
@@ -27,6 +31,7 @@
 #include "atlas/array/ArrayView.h"
 #include "atlas/array/ArrayViewDefs.h"
 #include "atlas/array/ArrayViewUtil.h"
+#include "atlas/array/DataType.h"
 #include "atlas/array/SVector.h"
 #include "atlas/array_fwd.h"
 #include "atlas/runtime/Log.h"
@@ -42,6 +47,34 @@ class HaloExchange : public eckit::Owned {
 public:  // types
     typedef eckit::SharedPtr<HaloExchange> Ptr;
 
+    /// State of a halo exchange of multiple arrays that has been started, but not completed.
+    /// A Handle is returned by start(), and must be passed to wait() of the same HaloExchange.
+    /// It owns the communication buffers, so that it can be reused for following exchanges
+    /// without allocating. An active Handle cannot be assigned to; when it is destroyed, e.g. by an
+    /// exception before wait(), it waits for the communication to complete without updating the halos.
+    class Handle {
+    public:
+        Handle() : halo_exchange_( nullptr ), active_( false ) {}
+        Handle( Handle&& other );
+        Handle& operator=( Handle&& other );
+        ~Handle();
+        Handle( const Handle& ) = delete;
+        Handle& operator=( const Handle& ) = delete;
+
+        /// True between start() and wait()
+        bool active() const { return active_; }
+
+    private:
+        friend class HaloExchange;
+        const HaloExchange* halo_exchange_;
+        std::vector<array::Array*> fields_;
+        std::vector<char> send_buffer_;
+        std::vector<char> recv_buffer_;
+        std::vector<eckit::mpi::Request> send_req_;
+        std::vector<eckit::mpi::Request> recv_req_;
+        bool active_;
+    };
+
 public:
     HaloExchange();
     HaloExchange( const std::string& name );
@@ -58,7 +91,55 @@ public:  // methods
     template <typename DATA_TYPE, int RANK, typename ParallelDim = array::FirstDim>
     void execute( array::Array& field, bool on_device = false ) const;
 
+    /// Exchange the halos of multiple arrays at once, sending a single message per neighbour.
+    /// Arrays may differ in datatype, rank and variable size. The first dimension must be the
+    /// parallel dimension, and only host memory is supported.
+    void execute( const std::vector<array::Array*>& fields ) const;
+
+    /// Pack the owned values of the arrays and post all messages, without waiting for them.
+    /// Until wait() has returned, the halo values of the arrays must not be accessed, and
+    /// the arrays must stay alive. Owned values may be read and written in the meantime, so
+    /// that computations not depending on the halo overlap with the communication.
+    Handle start( const std::vector<array::Array*>& fields ) const;
+
+    /// As above, reusing the buffers of a previously completed handle
+    void start( const std::vector<array::Array*>& fields, Handle& handle ) const;
+
+    /// Wait for the messages posted by start() and unpack the halo values
+    void wait( Handle& handle ) const;
+
+    /// Number of plans created for the single array execute(), one per datatype and variable size
+    size_t nb_plans() const { return plans_.size(); }
+
+    /// Send buffer of the plan for given datatype and variable size, or nullptr if not created yet
+    template <typename DATA_TYPE>
+    const DATA_TYPE* plan_send_buffer( size_t var_size ) const;
+
+private:  // types
+    /// Communication buffers and requests for one datatype and variable size.
+    /// Plans are created on first use and reused by all following exchanges with
+    /// the same datatype and variable size, so that repeated exchanges do not allocate.
+    struct PlanBase {
+        virtual ~PlanBase() {}
+    };
+
+    template <typename DATA_TYPE>
+    struct Plan : PlanBase {
+        Plan( size_t send_size, size_t recv_size, size_t nb_send_neighbours, size_t nb_recv_neighbours ) :
+            send_buffer( send_size ),
+            recv_buffer( recv_size ),
+            send_req( nb_send_neighbours ),
+            recv_req( nb_recv_neighbours ) {}
+        array::SVector<DATA_TYPE> send_buffer;
+        array::SVector<DATA_TYPE> recv_buffer;
+        std::vector<eckit::mpi::Request> send_req;
+        std::vector<eckit::mpi::Request> recv_req;
+    };
+
 private:  // methods
+    template <typename DATA_TYPE>
+    Plan<DATA_TYPE>& plan( size_t var_size ) const;
+
     void create_mappings( std::vector<int>& send_map, std::vector<int>& recv_map, size_t nb_vars ) const;
 
     template <int N, int P>
@@ -98,6 +179,15 @@ private:  // data
     array::SVector<int> recvmap_;
     int parsize_;
 
+    // Ranks that this rank sends to / receives from
+    std::vector<int> send_neighbours_;
+    std::vector<int> recv_neighbours_;
+
+    // Plans, keyed by datatype and variable size. They are created by the const execute(), which is
+    // therefore not thread-safe: like any MPI collective, a halo exchange must be called by a single
+    // thread per MPI task, and never from within an OpenMP parallel region.
+    mutable std::map<std::pair<array::DataType::kind_t, size_t>, std::unique_ptr<PlanBase>> plans_;
+
     int nproc;
     int myproc;
 
@@ -107,6 +197,24 @@ public:
     } backdoor;
 };
 
+template <typename DATA_TYPE>
+HaloExchange::Plan<DATA_TYPE>& HaloExchange::plan( size_t var_size ) const {
+    ASSERT( not atlas_omp_in_parallel() );
+    std::unique_ptr<PlanBase>& p = plans_[std::make_pair( array::DataType::kind<DATA_TYPE>(), var_size )];
+    if ( not p ) {
+        p.reset( new Plan<DATA_TYPE>( sendcnt_ * var_size, recvcnt_ * var_size, send_neighbours_.size(),
+                                      recv_neighbours_.size() ) );
+    }
+    return static_cast<Plan<DATA_TYPE>&>( *p );
+}
+
+template <typename DATA_TYPE>
+const DATA_TYPE* HaloExchange::plan_send_buffer( size_t var_size ) const {
+    auto it = plans_.find( std::make_pair( array::DataType::kind<DATA_TYPE>(), var_size ) );
+    if ( it == plans_.end() ) { return nullptr; }
+    return static_cast<const Plan<DATA_TYPE>&>( *it->second ).send_buffer.data();
+}
+
 template <typename DATA_TYPE, int RANK, typename ParallelDim>
 void HaloExchange::execute( array::Array& field, bool on_device ) const {
     if ( !is_setup_ ) { throw eckit::SeriousBug( "HaloExchange was not setup", Here() ); }
@@ -118,65 +226,47 @@ void HaloExchange::execute( array::Array& field, bool on_device ) const {
     int tag                   = 1;
     constexpr int parallelDim = array::get_parallel_dim<ParallelDim>( field_hv );
     size_t var_size           = array::get_var_size<parallelDim>( field_hv );
-    int send_size             = sendcnt_ * var_size;
-    int recv_size             = recvcnt_ * var_size;
-
-    array::SVector<DATA_TYPE> send_buffer( send_size );
-    array::SVector<DATA_TYPE> recv_buffer( recv_size );
-    std::vector<int> send_displs( nproc );
-    std::vector<int> recv_displs( nproc );
-    std::vector<int> send_counts( nproc );
-    std::vector<int> recv_counts( nproc );
-
-    std::vector<eckit::mpi::Request> send_req( nproc );
-    std::vector<eckit::mpi::Request> recv_req( nproc );
-
-    for ( int jproc = 0; jproc < nproc; ++jproc ) {
-        send_counts[jproc] = sendcounts_[jproc] * var_size;
-        recv_counts[jproc] = recvcounts_[jproc] * var_size;
-        send_displs[jproc] = senddispls_[jproc] * var_size;
-        recv_displs[jproc] = recvdispls_[jproc] * var_size;
-    }
+
+    Plan<DATA_TYPE>& p = plan<DATA_TYPE>( var_size );
 
     auto field_dv =
         on_device ? array::make_device_view<DATA_TYPE, RANK>( field ) : array::make_host_view<DATA_TYPE, RANK>( field );
 
     ATLAS_TRACE_MPI( IRECEIVE ) {
         /// Let MPI know what we like to receive
-        for ( int jproc = 0; jproc < nproc; ++jproc ) {
-            if ( recv_counts[jproc] > 0 ) {
-                recv_req[jproc] =
-                    mpi::comm().iReceive( &recv_buffer[recv_displs[jproc]], recv_counts[jproc], jproc, tag );
-            }
+        for ( size_t j = 0; j < recv_neighbours_.size(); ++j ) {
+            const int jproc = recv_neighbours_[j];
+            p.recv_req[j]   = mpi::comm().iReceive( p.recv_buffer.data() + recvdispls_[jproc] * var_size,
+                                                  recvcounts_[jproc] * var_size, jproc, tag );
         }
     }
 
     /// Pack
-    pack_send_buffer<parallelDim>( field_hv, field_dv, send_buffer, on_device );
+    pack_send_buffer<parallelDim>( field_hv, field_dv, p.send_buffer, on_device );
 
     /// Send
     ATLAS_TRACE_MPI( ISEND ) {
-        for ( int jproc = 0; jproc < nproc; ++jproc ) {
-            if ( send_counts[jproc] > 0 ) {
-                send_req[jproc] = mpi::comm().iSend( &send_buffer[send_displs[jproc]], send_counts[jproc], jproc, tag );
-            }
+        for ( size_t j = 0; j < send_neighbours_.size(); ++j ) {
+            const int jproc = send_neighbours_[j];
+            p.send_req[j]   = mpi::comm().iSend( p.send_buffer.data() + senddispls_[jproc] * var_size,
+                                               sendcounts_[jproc] * var_size, jproc, tag );
         }
     }
 
     /// Wait for receiving to finish
     ATLAS_TRACE_MPI( WAIT, "mpi-wait receive" ) {
-        for ( int jproc = 0; jproc < nproc; ++jproc ) {
-            if ( recvcounts_[jproc] > 0 ) { mpi::comm().wait( recv_req[jproc] ); }
+        for ( size_t j = 0; j < recv_neighbours_.size(); ++j ) {
+            mpi::comm().wait( p.recv_req[j] );
         }
     }
 
     /// Unpack
-    unpack_recv_buffer<parallelDim>( recv_buffer, field_hv, field_dv, on_device );
+    unpack_recv_buffer<parallelDim>( p.recv_buffer, field_hv, field_dv, on_device );
 
     /// Wait for sending to finish
     ATLAS_TRACE_MPI( WAIT, "mpi-wait send" ) {
-        for ( int jproc = 0; jproc < nproc; ++jproc ) {
-            if ( sendcounts_[jproc] > 0 ) { mpi::comm().wait( send_req[jproc] ); }
+        for ( size_t j = 0; j < send_neighbours_.size(); ++j ) {
+            mpi::comm().wait( p.send_req[j] );
         }
     }
 }
@@ -46,6 +46,14 @@ public:
     void xy2lonlat( double crd[] ) const;
     void lonlat2xy( double crd[] ) const;
 
+    /// Convert n points given as separate coordinate arrays. Output may alias input.
+    void xy2lonlat( size_t n, const double x[], const double y[], double lon[], double lat[] ) const;
+    void lonlat2xy( size_t n, const double lon[], const double lat[], double x[], double y[] ) const;
+
+    /// Convert n points given as interleaved coordinate pairs. Output may alias input.
+    void xy2lonlat( size_t n, const double xy[], double lonlat[] ) const;
+    void lonlat2xy( size_t n, const double lonlat[], double xy[] ) const;
+
     PointLonLat lonlat( const PointXY& ) const;
     PointXY xy( const PointLonLat& ) const;
 
@@ -73,6 +81,18 @@ inline void Projection::xy2lonlat( double crd[] ) const {
 inline void Projection::lonlat2xy( double crd[] ) const {
     return projection_->lonlat2xy( crd );
 }
+inline void Projection::xy2lonlat( size_t n, const double x[], const double y[], double lon[], double lat[] ) const {
+    projection_->xy2lonlat( n, x, y, lon, lat, 1 );
+}
+inline void Projection::lonlat2xy( size_t n, const double lon[], const double lat[], double x[], double y[] ) const {
+    projection_->lonlat2xy( n, lon, lat, x, y, 1 );
+}
+inline void Projection::xy2lonlat( size_t n, const double xy[], double lonlat[] ) const {
+    projection_->xy2lonlat( n, xy, xy + 1, lonlat, lonlat + 1, 2 );
+}
+inline void Projection::lonlat2xy( size_t n, const double lonlat[], double xy[] ) const {
+    projection_->lonlat2xy( n, lonlat, lonlat + 1, xy, xy + 1, 2 );
+}
 inline PointLonLat Projection::lonlat( const PointXY& xy ) const {
     return projection_->lonlat( xy );
 }
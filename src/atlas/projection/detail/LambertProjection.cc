@@ -88,6 +88,39 @@ void LambertProjection::xy2lonlat( double crd[] ) const {
     }
 }
 
+void LambertProjection::lonlat2xy( size_t n, const double lon[], const double lat[], double x[], double y[],
+                                   size_t stride ) const {
+    const double rF   = radius_ * F_;
+    const double nn   = n_;
+    const double lon0 = lon0_;
+    const double rho0 = rho0_;
+    for ( size_t k = 0; k < n; ++k ) {
+        const size_t i     = k * stride;
+        const double rho   = rF / std::pow( std::tan( D2R( 45 + lat[i] * 0.5 ) ), nn );
+        const double theta = D2R( nn * ( lon[i] - lon0 ) );
+        x[i]               = rho * std::sin( theta );
+        y[i]               = rho0 - rho * std::cos( theta );
+    }
+}
+
+void LambertProjection::xy2lonlat( size_t n, const double x[], const double y[], double lon[], double lat[],
+                                   size_t stride ) const {
+    const double rF    = radius_ * F_;
+    const double inv_n = inv_n_;
+    const double lon0  = lon0_;
+    const double rho0  = rho0_;
+    const double sign  = sign_;
+    for ( size_t k = 0; k < n; ++k ) {
+        const size_t i     = k * stride;
+        const double xi    = x[i];
+        const double y0    = rho0 - y[i];
+        const double rho   = sign * std::sqrt( xi * xi + y0 * y0 );
+        const double theta = R2D( std::atan2( sign * xi, sign * y0 ) );
+        lon[i]             = theta * inv_n + lon0;
+        lat[i]             = rho == 0. ? sign * 90. : 2. * R2D( std::atan( std::pow( rF / rho, inv_n ) ) ) - 90.;
+    }
+}
+
 // specification
 LambertProjection::Spec LambertProjection::spec() const {
     Spec proj_spec;
@@ -32,6 +32,11 @@ public:
     virtual void xy2lonlat( double crd[] ) const override;
     virtual void lonlat2xy( double crd[] ) const override;
 
+    virtual void xy2lonlat( size_t n, const double x[], const double y[], double lon[], double lat[],
+                            size_t stride ) const override;
+    virtual void lonlat2xy( size_t n, const double lon[], const double lat[], double x[], double y[],
+                            size_t stride ) const override;
+
     virtual bool strictlyRegional() const override {
         return true;
     }  // lambert projection cannot be used for global grids
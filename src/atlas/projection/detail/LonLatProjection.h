@@ -38,6 +38,17 @@ public:
     virtual void xy2lonlat( double crd[] ) const override { rotation_.rotate( crd ); }
     virtual void lonlat2xy( double crd[] ) const override { rotation_.unrotate( crd ); }
 
+    virtual void xy2lonlat( size_t n, const double x[], const double y[], double lon[], double lat[],
+                            size_t stride ) const override {
+        copy( n, x, y, lon, lat, stride );
+        rotation_.rotate( n, lon, lat, stride );
+    }
+    virtual void lonlat2xy( size_t n, const double lon[], const double lat[], double x[], double y[],
+                            size_t stride ) const override {
+        copy( n, lon, lat, x, y, stride );
+        rotation_.unrotate( n, x, y, stride );
+    }
+
     virtual bool strictlyRegional() const override { return false; }
 
     // specification
@@ -68,6 +68,40 @@ void MercatorProjectionT<Rotation>::xy2lonlat( double crd[] ) const {
     rotation_.rotate( crd );
 }
 
+template <typename Rotation>
+void MercatorProjectionT<Rotation>::lonlat2xy( size_t n, const double lon[], const double lat[], double x[],
+                                               double y[], size_t stride ) const {
+    // first unrotate
+    copy( n, lon, lat, x, y, stride );
+    rotation_.unrotate( n, x, y, stride );
+
+    // then project
+    const double radius = radius_;
+    const double lon0   = lon0_;
+    for ( size_t k = 0; k < n; ++k ) {
+        const size_t i = k * stride;
+        x[i]           = radius * ( D2R( x[i] - lon0 ) );
+        y[i]           = radius * std::log( std::tan( D2R( 45. + y[i] * 0.5 ) ) );
+    }
+}
+
+template <typename Rotation>
+void MercatorProjectionT<Rotation>::xy2lonlat( size_t n, const double x[], const double y[], double lon[],
+                                               double lat[], size_t stride ) const {
+    // first projection
+    const double inv_radius = inv_radius_;
+    const double lon0       = lon0_;
+    for ( size_t k = 0; k < n; ++k ) {
+        const size_t i  = k * stride;
+        const double xi = x[i];
+        const double yi = y[i];
+        lon[i]          = lon0 + R2D( xi * inv_radius );
+        lat[i]          = 2. * R2D( std::atan( std::exp( yi * inv_radius ) ) ) - 90.;
+    }
+    // then rotate
+    rotation_.rotate( n, lon, lat, stride );
+}
+
 // specification
 template <typename Rotation>
 typename MercatorProjectionT<Rotation>::Spec MercatorProjectionT<Rotation>::spec() const {
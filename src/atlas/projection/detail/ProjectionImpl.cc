@@ -31,6 +31,41 @@ ProjectionImpl* ProjectionImpl::create( const eckit::Parametrisation& p ) {
     throw eckit::BadParameter( "type missing in Params", Here() );
 }
 
+void ProjectionImpl::xy2lonlat( size_t n, const double x[], const double y[], double lon[], double lat[],
+                                size_t stride ) const {
+    for ( size_t k = 0; k < n; ++k ) {
+        const size_t i = k * stride;
+        double crd[]   = {x[i], y[i]};
+        xy2lonlat( crd );
+        lon[i] = crd[0];
+        lat[i] = crd[1];
+    }
+}
+
+void ProjectionImpl::lonlat2xy( size_t n, const double lon[], const double lat[], double x[], double y[],
+                                size_t stride ) const {
+    for ( size_t k = 0; k < n; ++k ) {
+        const size_t i = k * stride;
+        double crd[]   = {lon[i], lat[i]};
+        lonlat2xy( crd );
+        x[i] = crd[0];
+        y[i] = crd[1];
+    }
+}
+
+void ProjectionImpl::copy( size_t n, const double x[], const double y[], double u[], double v[], size_t stride ) {
+    if ( u != x ) {
+        for ( size_t k = 0; k < n; ++k ) {
+            u[k * stride] = x[k * stride];
+        }
+    }
+    if ( v != y ) {
+        for ( size_t k = 0; k < n; ++k ) {
+            v[k * stride] = y[k * stride];
+        }
+    }
+}
+
 Rotated::Rotated( const PointLonLat& south_pole, double rotation_angle ) :
     util::Rotation( south_pole, rotation_angle ) {}
 
@@ -44,6 +44,17 @@ public:
     virtual void xy2lonlat( double crd[] ) const = 0;
     virtual void lonlat2xy( double crd[] ) const = 0;
 
+    /// @brief Inverse projection of n points with a single virtual dispatch
+    /// Arrays are accessed with given stride and output may alias input, so that
+    /// interleaved (x,y) pairs can be converted in place using stride 2.
+    /// The default implementation converts point by point.
+    virtual void xy2lonlat( size_t n, const double x[], const double y[], double lon[], double lat[],
+                            size_t stride ) const;
+
+    /// @brief Projection of n points with a single virtual dispatch, see xy2lonlat
+    virtual void lonlat2xy( size_t n, const double lon[], const double lat[], double x[], double y[],
+                            size_t stride ) const;
+
     PointLonLat lonlat( const PointXY& ) const;
     PointXY xy( const PointLonLat& ) const;
 
@@ -56,6 +67,10 @@ public:
     virtual operator bool() const { return true; }
 
     virtual void hash( eckit::Hash& ) const = 0;
+
+protected:
+    /// Copy n strided points from (x,y) to (u,v), skipping arrays that alias
+    static void copy( size_t n, const double x[], const double y[], double u[], double v[], size_t stride );
 };
 
 inline PointLonLat ProjectionImpl::lonlat( const PointXY& xy ) const {
@@ -102,6 +117,11 @@ public:
     void unrotate( double crd[] ) const { /* do nothing */
     }
 
+    void rotate( size_t n, double lon[], double lat[], size_t stride = 1 ) const { /* do nothing */
+    }
+    void unrotate( size_t n, double lon[], double lat[], size_t stride = 1 ) const { /* do nothing */
+    }
+
     bool rotated() const { return false; }
 
     void spec( Spec& ) const {}
@@ -55,6 +55,39 @@ void SchmidtProjectionT<Rotation>::lonlat2xy( double crd[] ) const {
         R2D( std::asin( std::cos( 2. * std::atan( c_ * std::tan( std::acos( std::sin( D2R( crd[1] ) ) ) * 0.5 ) ) ) ) );
 }
 
+template <typename Rotation>
+void SchmidtProjectionT<Rotation>::xy2lonlat( size_t n, const double x[], const double y[], double lon[],
+                                              double lat[], size_t stride ) const {
+    const double inv_c = 1 / c_;
+    for ( size_t k = 0; k < n; ++k ) {
+        const size_t i  = k * stride;
+        const double yi = y[i];
+        lon[i]          = x[i];
+        // stretch
+        lat[i] = R2D(
+            std::asin( std::cos( 2. * std::atan( inv_c * std::tan( std::acos( std::sin( D2R( yi ) ) ) * 0.5 ) ) ) ) );
+    }
+    // perform rotation
+    rotation_.rotate( n, lon, lat, stride );
+}
+
+template <typename Rotation>
+void SchmidtProjectionT<Rotation>::lonlat2xy( size_t n, const double lon[], const double lat[], double x[],
+                                              double y[], size_t stride ) const {
+    // inverse rotation
+    copy( n, lon, lat, x, y, stride );
+    rotation_.unrotate( n, x, y, stride );
+
+    // unstretch
+    const double c = c_;
+    for ( size_t k = 0; k < n; ++k ) {
+        const size_t i  = k * stride;
+        const double yi = y[i];
+        y[i]            = R2D(
+            std::asin( std::cos( 2. * std::atan( c * std::tan( std::acos( std::sin( D2R( yi ) ) ) * 0.5 ) ) ) ) );
+    }
+}
+
 // specification
 template <typename Rotation>
 typename SchmidtProjectionT<Rotation>::Spec SchmidtProjectionT<Rotation>::spec() const {
@@ -14,6 +14,7 @@
 
 #include "atlas/library/Library.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/trace/StopWatch.h"
 
 //-----------------------------------------------------------------------------------------------------------
@@ -64,7 +65,8 @@ bool Barriers::state() {
 }
 
 void Barriers::execute() {
-    if ( state() ) {
+    // Inside a parallel region every thread would enter the MPI barrier
+    if ( state() && not atlas_omp_in_parallel() ) {
         BarriersState::instance().stopwatch().start();
         mpi::comm().barrier();
         BarriersState::instance().stopwatch().stop();
@@ -1,28 +1,69 @@
-
 #include "CallStack.h"
 
-#include <functional>
+#include <algorithm>
 
+#include "eckit/exception/Exceptions.h"
 #include "eckit/log/CodeLocation.h"
 
 namespace atlas {
 namespace runtime {
 namespace trace {
 
-void CallStack::push_front( const eckit::CodeLocation& loc ) {
-    stack_.push_front( std::hash<std::string>{}( loc.asString() ) );
+namespace {
+
+/// FNV-1a over the characters of str, so that the same location seen from
+/// different translation units (different string literal addresses) gives the same key
+size_t hash_chars( size_t h, const char* str ) {
+    if ( str ) {
+        for ( ; *str; ++str ) {
+            h = ( h ^ static_cast<unsigned char>( *str ) ) * 1099511628211ul;
+        }
+    }
+    return h;
 }
 
-void CallStack::pop_front() {
-    stack_.pop_front();
+size_t hash_location( const eckit::CodeLocation& loc ) {
+    size_t h = 14695981039346656037ul;
+    h        = hash_chars( h, loc.file() );
+    h        = hash_chars( h, loc.func() );
+    return ( h ^ static_cast<size_t>( loc.line() ) ) * 1099511628211ul;
 }
 
-size_t CallStack::hash() const {
-    if ( hash_ ) return hash_;
-    for ( auto h : stack_ ) {
-        hash_ ^= ( h << 1 );
-    }
-    return hash_;
+size_t hash_combine( size_t seed, size_t h ) {
+    return seed ^ ( h + 0x9e3779b97f4a7c15ul + ( seed << 6 ) + ( seed >> 2 ) );
+}
+
+}  // namespace
+
+CallStack::CallStack( const CallStack& other ) : size_( other.size_ ) {
+    std::copy( other.stack_, other.stack_ + size_, stack_ );
+    std::copy( other.hash_, other.hash_ + size_, hash_ );
+}
+
+CallStack::CallStack( const CallStack& other, size_t depth ) : size_( depth ) {
+    ASSERT( depth <= max_depth );
+    std::copy( other.stack_, other.stack_ + size_, stack_ );
+    std::copy( other.hash_, other.hash_ + size_, hash_ );
+}
+
+CallStack& CallStack::operator=( const CallStack& other ) {
+    size_ = other.size_;
+    std::copy( other.stack_, other.stack_ + size_, stack_ );
+    std::copy( other.hash_, other.hash_ + size_, hash_ );
+    return *this;
+}
+
+void CallStack::push_front( const eckit::CodeLocation& loc ) {
+    ASSERT( size_ < max_depth );
+    const size_t key = hash_location( loc );
+    hash_[size_]     = hash_combine( hash(), key );
+    stack_[size_]    = key;
+    ++size_;
+}
+
+void CallStack::pop_front() {
+    ASSERT( size_ > 0 );
+    --size_;
 }
 
 }  // namespace trace
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <cstddef>
-#include <list>
+#include <iterator>
 
 namespace eckit {
 class CodeLocation;
@@ -13,27 +13,41 @@ namespace trace {
 
 /// @class CallStack
 /// Instances of CallStack can keep track of nested eckit::CodeLocations
+///
+/// The stack has a fixed maximum depth and keeps the hash of every sub-stack, so that
+/// push_front, pop_front and hash() neither allocate nor iterate over the stack.
+/// Iteration goes from the most recently pushed location (front) to the outermost.
 class CallStack {
 public:
-    using const_iterator         = std::list<size_t>::const_iterator;
-    using const_reverse_iterator = std::list<size_t>::const_reverse_iterator;
+    static constexpr size_t max_depth = 64;
+
+    using const_iterator         = std::reverse_iterator<const size_t*>;
+    using const_reverse_iterator = const size_t*;
 
 public:
+    CallStack() = default;
+    CallStack( const CallStack& );
+
+    /// Copy of the outermost depth locations of another stack; only these entries of the other stack are read
+    CallStack( const CallStack&, size_t depth );
+    CallStack& operator=( const CallStack& );
+
     void push_front( const eckit::CodeLocation& );
     void pop_front();
 
-    const_iterator begin() const { return stack_.begin(); }
-    const_iterator end() const { return stack_.end(); }
+    const_iterator begin() const { return const_iterator( stack_ + size_ ); }
+    const_iterator end() const { return const_iterator( stack_ ); }
 
-    const_reverse_iterator rbegin() const { return stack_.rbegin(); }
-    const_reverse_iterator rend() const { return stack_.rend(); }
+    const_reverse_iterator rbegin() const { return stack_; }
+    const_reverse_iterator rend() const { return stack_ + size_; }
 
-    size_t hash() const;
-    size_t size() const { return stack_.size(); }
+    size_t hash() const { return size_ ? hash_[size_ - 1] : 0; }
+    size_t size() const { return size_; }
 
 private:
-    std::list<size_t> stack_;
-    mutable size_t hash_{0};
+    size_t stack_[max_depth];
+    size_t hash_[max_depth];
+    size_t size_{0};
 };
 
 }  // namespace trace
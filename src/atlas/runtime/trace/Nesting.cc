@@ -10,30 +10,83 @@
 
 #include "Nesting.h"
 
+#include <atomic>
+
+#include "atlas/parallel/omp/omp.h"
+
 //-----------------------------------------------------------------------------------------------------------
 
 namespace atlas {
 namespace runtime {
 namespace trace {
 
+/// Call stack of the calling thread.
+///
+/// Each thread has its own stack, so that traces can be used inside OpenMP parallel regions.
+/// A thread that starts a trace inside a parallel region with an empty stack continues from the
+/// stack of the last thread that traced outside parallel regions, so that its timers are nested
+/// under the scope that opened the parallel region.
+///
+/// Publishing is lock-free and copies nothing: outside parallel regions a thread only stores a pointer
+/// to its state and its depth. Entries below that depth do not change while the parallel region runs,
+/// as the thread that opened it can only push and pop above them, so the stack is copied once per
+/// thread when it is inherited.
 class NestingState {
 private:
     NestingState() {}
+    ~NestingState() {
+        const NestingState* self = this;
+        published().compare_exchange_strong( self, nullptr );
+    }
     CallStack stack_;
+    size_t inherited_{0};
+    std::atomic<size_t> published_depth_{0};
+
+    static std::atomic<const NestingState*>& published() {
+        static std::atomic<const NestingState*> state{nullptr};
+        return state;
+    }
+    void publish() {
+        published_depth_.store( stack_.size(), std::memory_order_release );
+        if ( published().load( std::memory_order_relaxed ) != this ) {
+            published().store( this, std::memory_order_release );
+        }
+    }
+    void inherit() {
+        const NestingState* state = published().load( std::memory_order_acquire );
+        if ( state == nullptr || state == this ) { return; }
+        stack_     = CallStack( state->stack_, state->published_depth_.load( std::memory_order_acquire ) );
+        inherited_ = stack_.size();
+    }
 
 public:
     NestingState( NestingState const& ) = delete;
     void operator=( NestingState const& ) = delete;
     static NestingState& instance() {
-        static NestingState state;
+        static thread_local NestingState state;
         return state;
     }
     operator CallStack() const { return stack_; }
     CallStack& push( const eckit::CodeLocation& loc ) {
+        const bool in_parallel = atlas_omp_in_parallel();
+        if ( in_parallel && stack_.size() == 0 ) { inherit(); }
         stack_.push_front( loc );
+        if ( not in_parallel ) { publish(); }
         return stack_;
     }
-    void pop() { stack_.pop_front(); }
+    void pop() {
+        stack_.pop_front();
+        if ( inherited_ ) {
+            if ( stack_.size() == inherited_ ) {
+                // back at the scope of the parallel region: forget it, as the next region may differ
+                stack_     = CallStack();
+                inherited_ = 0;
+            }
+        }
+        else if ( not atlas_omp_in_parallel() ) {
+            publish();
+        }
+    }
 };
 
 Nesting::Nesting( const eckit::CodeLocation& loc ) : loc_( loc ), stack_( NestingState::instance().push( loc ) ) {}
@@ -24,7 +24,7 @@ class Nesting {
 public:
     Nesting( const eckit::CodeLocation& );
     ~Nesting();
-    operator CallStack() const { return stack_; }
+    operator const CallStack&() const { return stack_; }
     void stop();
     void start();
 
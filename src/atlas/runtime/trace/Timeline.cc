@@ -0,0 +1,267 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "Timeline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/thread/AutoLock.h"
+#include "eckit/thread/Mutex.h"
+
+#include "atlas/library/Library.h"
+#include "atlas/parallel/mpi/mpi.h"
+
+//-----------------------------------------------------------------------------------------------------------
+
+namespace atlas {
+namespace runtime {
+namespace trace {
+
+namespace {
+
+struct TimelineEvent {
+    Timings::Identifier id;
+    double start;
+    double duration;
+};
+
+/// Fixed capacity ring buffer of events, written by one thread only
+class TimelineBuffer {
+public:
+    TimelineBuffer( size_t capacity, size_t thread ) : events_( std::max<size_t>( capacity, 1 ) ), thread_( thread ) {}
+
+    void record( const TimelineEvent& event ) {
+        events_[next_] = event;
+        next_          = ( next_ + 1 ) % events_.size();
+        ++recorded_;
+    }
+
+    void clear() {
+        next_     = 0;
+        recorded_ = 0;
+    }
+
+    /// Events in the order they were recorded
+    template <typename Function>
+    void for_each( const Function& f ) const {
+        if ( recorded_ <= events_.size() ) {
+            for ( size_t i = 0; i < recorded_; ++i ) {
+                f( events_[i] );
+            }
+        }
+        else {
+            for ( size_t i = 0; i < events_.size(); ++i ) {
+                f( events_[( next_ + i ) % events_.size()] );
+            }
+        }
+    }
+
+    size_t thread() const { return thread_; }
+    size_t recorded() const { return recorded_; }
+    size_t dropped() const { return recorded_ > events_.size() ? recorded_ - events_.size() : 0; }
+
+private:
+    std::vector<TimelineEvent> events_;
+    size_t next_{0};
+    size_t recorded_{0};
+    size_t thread_;
+};
+
+/// Owns the buffers of all threads, so that events of threads that have finished are still written.
+/// Never destroyed, so that traces with static lifetime can still record.
+class TimelineRegistry {
+public:
+    static TimelineRegistry& instance() {
+        static TimelineRegistry* registry = new TimelineRegistry();
+        return *registry;
+    }
+
+    TimelineBuffer& buffer() {
+        thread_local TimelineBuffer* buffer = nullptr;
+        if ( buffer == nullptr ) {
+            eckit::AutoLock<eckit::Mutex> lock( mutex_ );
+            size_t capacity = size_t( std::max( atlas::Library::instance().traceTimelineSize(), 1 ) );
+            buffers_.emplace_back( new TimelineBuffer( capacity, buffers_.size() ) );
+            buffer = buffers_.back().get();
+        }
+        return *buffer;
+    }
+
+    double now() const {
+        return std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now() - steady_origin_ ).count();
+    }
+
+    size_t size() {
+        eckit::AutoLock<eckit::Mutex> lock( mutex_ );
+        size_t n = 0;
+        for ( const auto& b : buffers_ ) {
+            n += b->recorded();
+        }
+        return n;
+    }
+
+    size_t dropped() {
+        eckit::AutoLock<eckit::Mutex> lock( mutex_ );
+        size_t n = 0;
+        for ( const auto& b : buffers_ ) {
+            n += b->dropped();
+        }
+        return n;
+    }
+
+    void clear() {
+        eckit::AutoLock<eckit::Mutex> lock( mutex_ );
+        for ( auto& b : buffers_ ) {
+            b->clear();
+        }
+    }
+
+    void write( std::ostream& );
+
+private:
+    TimelineRegistry() :
+        steady_origin_( std::chrono::steady_clock::now() ),
+        system_origin_( std::chrono::duration<double, std::micro>(
+                            std::chrono::system_clock::now().time_since_epoch() )
+                            .count() ) {}
+
+    eckit::Mutex mutex_;
+    std::vector<std::unique_ptr<TimelineBuffer>> buffers_;
+    std::chrono::steady_clock::time_point steady_origin_;
+    double system_origin_;
+};
+
+std::string escape( const std::string& str ) {
+    std::string s;
+    s.reserve( str.size() );
+    for ( char c : str ) {
+        switch ( c ) {
+            case '"':
+                s += "\\\"";
+                break;
+            case '\\':
+                s += "\\\\";
+                break;
+            case '\n':
+                s += "\\n";
+                break;
+            case '\t':
+                s += "\\t";
+                break;
+            default:
+                if ( static_cast<unsigned char>( c ) < 0x20 ) {
+                    char code[8];
+                    std::snprintf( code, sizeof( code ), "\\u%04x", c );
+                    s += code;
+                }
+                else {
+                    s += c;
+                }
+        }
+    }
+    return s;
+}
+
+void TimelineRegistry::write( std::ostream& out ) {
+    eckit::AutoLock<eckit::Mutex> lock( mutex_ );
+
+    const size_t rank = mpi::comm().rank();
+
+    // Name and category of every timer, looked up once
+    std::map<Timings::Identifier, std::pair<std::string, std::string>> timers;
+    auto timer = [&]( Timings::Identifier id ) -> const std::pair<std::string, std::string>& {
+        auto it = timers.find( id );
+        if ( it == timers.end() ) {
+            std::string category;
+            for ( const auto& label : Timings::labels( id ) ) {
+                category += ( category.empty() ? "" : "," ) + label;
+            }
+            if ( category.empty() ) { category = "atlas"; }
+            it = timers.emplace( id, std::make_pair( escape( Timings::title( id ) ), escape( category ) ) ).first;
+        }
+        return it->second;
+    };
+
+    size_t dropped = 0;
+
+    std::ostringstream events;
+    events << std::fixed << std::setprecision( 3 );
+    events << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank << ",\"tid\":0,\"args\":{\"name\":\"rank "
+           << rank << "\"}}";
+    for ( const auto& buffer : buffers_ ) {
+        const size_t tid = buffer->thread();
+        events << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << rank << ",\"tid\":" << tid
+               << ",\"args\":{\"name\":\"thread " << tid << "\"}}";
+        buffer->for_each( [&]( const TimelineEvent& event ) {
+            const auto& t = timer( event.id );
+            events << ",\n{\"name\":\"" << t.first << "\",\"cat\":\"" << t.second << "\",\"ph\":\"X\",\"pid\":" << rank
+                   << ",\"tid\":" << tid << ",\"ts\":" << system_origin_ + event.start << ",\"dur\":" << event.duration
+                   << "}";
+        } );
+        dropped += buffer->dropped();
+    }
+
+    out << "{\"traceEvents\":[\n" << events.str() << "\n],\n";
+    out << "\"displayTimeUnit\":\"ms\",\n";
+    out << "\"otherData\":{\"rank\":" << rank << ",\"dropped_events\":" << dropped << "}}\n";
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------------------------------------
+
+bool Timeline::enabled() {
+    return atlas::Library::instance().traceTimeline();
+}
+
+double Timeline::now() {
+    return TimelineRegistry::instance().now();
+}
+
+void Timeline::record( const Identifier& id, double start, double end ) {
+    TimelineRegistry::instance().buffer().record( TimelineEvent{id, start, end - start} );
+}
+
+size_t Timeline::size() {
+    return TimelineRegistry::instance().size();
+}
+
+size_t Timeline::dropped() {
+    return TimelineRegistry::instance().dropped();
+}
+
+void Timeline::clear() {
+    TimelineRegistry::instance().clear();
+}
+
+void Timeline::write( std::ostream& out ) {
+    TimelineRegistry::instance().write( out );
+}
+
+void Timeline::write( const std::string& prefix ) {
+    std::string file = prefix + "." + std::to_string( mpi::comm().rank() ) + ".json";
+    std::ofstream out( file.c_str() );
+    if ( not out ) { throw eckit::CantOpenFile( file, Here() ); }
+    write( out );
+}
+
+}  // namespace trace
+}  // namespace runtime
+}  // namespace atlas
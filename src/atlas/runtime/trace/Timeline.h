@@ -0,0 +1,67 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <iosfwd>
+#include <string>
+
+#include "atlas/runtime/trace/Timings.h"
+
+//-----------------------------------------------------------------------------------------------------------
+
+namespace atlas {
+namespace runtime {
+namespace trace {
+
+/// @class Timeline
+/// Records every completed trace scope with its start time, thread and duration, so that the
+/// sequence of events of each MPI task and thread can be inspected in a timeline viewer.
+///
+/// Recording is enabled with the environment variable ATLAS_TRACE_TIMELINE=1 or with the
+/// library configuration "trace.timeline". Each thread records into its own ring buffer of
+/// ATLAS_TRACE_TIMELINE_SIZE events (configuration "trace.timeline_size"), so that recording
+/// needs no locking and keeps bounded memory; when the buffer is full the oldest events are dropped.
+///
+/// The events are written in the Chrome trace event format ( chrome://tracing, https://ui.perfetto.dev ),
+/// with the MPI rank as process id and the thread number as thread id. Timestamps are microseconds since
+/// the epoch, so that files of different MPI tasks can be merged by concatenating their "traceEvents".
+class Timeline {
+public:
+    using Identifier = Timings::Identifier;
+
+public:  // static methods
+    static bool enabled();
+
+    /// Current time in microseconds, on the time base of recorded events
+    static double now();
+
+    /// Record a completed trace scope, timed with now()
+    static void record( const Identifier& id, double start, double end );
+
+    /// Number of events recorded (including dropped ones) by all threads
+    static size_t size();
+
+    /// Number of events that were overwritten because a thread's buffer was full
+    static size_t dropped();
+
+    /// Forget all recorded events
+    static void clear();
+
+    /// Write events of this MPI task in Chrome trace event format
+    static void write( std::ostream& );
+
+    /// Write events of this MPI task to file "<prefix>.<rank>.json"; throws eckit::CantOpenFile if it cannot be opened
+    static void write( const std::string& prefix );
+};
+
+}  // namespace trace
+}  // namespace runtime
+}  // namespace atlas
@@ -13,16 +13,20 @@
 
 #include <cmath>
 #include <limits>
+#include <memory>
 #include <regex>
 #include <sstream>
 #include <string>
 
 #include "eckit/config/Configuration.h"
 #include "eckit/filesystem/PathName.h"
+#include "eckit/thread/AutoLock.h"
+#include "eckit/thread/Mutex.h"
 
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/runtime/trace/CallStack.h"
 #include "atlas/util/Config.h"
+#include "atlas/util/detail/FlatHashMap.h"
 
 //-----------------------------------------------------------------------------------------------------------
 
@@ -30,6 +34,41 @@ namespace atlas {
 namespace runtime {
 namespace trace {
 
+/// Timing statistics of every timer, accumulated by one thread
+struct TimingsAccumulator {
+    std::vector<long> counts_;
+    std::vector<double> tot_timings_;
+    std::vector<double> min_timings_;
+    std::vector<double> max_timings_;
+    std::vector<double> mean_timings_;
+    std::vector<double> m2_timings_;  // sum of squared deviations from the mean (Welford)
+
+    void update( size_t idx, double seconds ) {
+        if ( idx >= counts_.size() ) {
+            const size_t size = std::max( idx + 1, 2 * counts_.size() );
+            counts_.resize( size, 0 );
+            tot_timings_.resize( size, 0 );
+            min_timings_.resize( size, std::numeric_limits<double>::max() );
+            max_timings_.resize( size, 0 );
+            mean_timings_.resize( size, 0 );
+            m2_timings_.resize( size, 0 );
+        }
+        const long n       = ++counts_[idx];
+        const double delta = seconds - mean_timings_[idx];
+        mean_timings_[idx] += delta / double( n );
+        m2_timings_[idx] += delta * ( seconds - mean_timings_[idx] );
+        min_timings_[idx] = std::min( seconds, min_timings_[idx] );
+        max_timings_[idx] = std::max( seconds, max_timings_[idx] );
+        tot_timings_[idx] += seconds;
+    }
+};
+
+/// Registry of timers, shared by all threads.
+///
+/// A timer is identified by the hash of its call stack. Each thread looks up identifiers in its own
+/// cache first, so that the registry lock is only taken the first time a thread meets a call stack.
+/// Timings are accumulated per thread without synchronisation, and merged when reporting.
+/// Reporting is meant to be done outside parallel regions.
 class TimingsRegistry {
 private:
     std::vector<long> counts_;
@@ -44,43 +83,76 @@ private:
     std::map<size_t, size_t> index_;
 
     std::map<std::string, std::vector<size_t>> labels_;
+    std::vector<Timings::Labels> timer_labels_;
+
+    // Owned here rather than by the threads, so that timings of finished threads are still reported
+    std::vector<std::unique_ptr<TimingsAccumulator>> accumulators_;
+
+    eckit::Mutex mutex_;
 
     TimingsRegistry() {}
 
+    struct ThreadLocal {
+        util::FlatHashMap<size_t, size_t> index_;
+        TimingsAccumulator* accumulator_{nullptr};
+    };
+
+    static ThreadLocal& thread_local_state() {
+        static thread_local ThreadLocal state;
+        return state;
+    }
+
 public:
     static TimingsRegistry& instance() {
-        static TimingsRegistry registry;
-        return registry;
+        static TimingsRegistry* registry = new TimingsRegistry();
+        return *registry;
     }
 
     size_t add( const eckit::CodeLocation&, const CallStack& stack, const std::string& title, const Timings::Labels& );
 
     void update( size_t idx, double seconds );
 
+    std::string title( size_t idx );
+
+    Timings::Labels labels( size_t idx );
+
     size_t size() const;
 
     void report( std::ostream& out, const eckit::Configuration& config );
 
 private:
+    size_t add_locked( const eckit::CodeLocation&, const CallStack& stack, const std::string& title,
+                       const Timings::Labels& );
+
+    void merge();
+
     std::string filter_filepath( const std::string& filepath ) const;
 };
 
 size_t TimingsRegistry::add( const eckit::CodeLocation& loc, const CallStack& stack, const std::string& title,
                              const Timings::Labels& labels ) {
+    ThreadLocal& local = thread_local_state();
+    const size_t key   = stack.hash();
+    if ( const size_t* idx = local.index_.find( key ) ) { return *idx; }
+
+    eckit::AutoLock<eckit::Mutex> lock( mutex_ );
+    const size_t idx = add_locked( loc, stack, title, labels );
+    local.index_.insert( key, idx );
+    return idx;
+}
+
+size_t TimingsRegistry::add_locked( const eckit::CodeLocation& loc, const CallStack& stack, const std::string& title,
+                                    const Timings::Labels& labels ) {
     size_t key = stack.hash();
     auto it    = index_.find( key );
     if ( it == index_.end() ) {
-        size_t idx  = size();
+        size_t idx  = titles_.size();
         index_[key] = idx;
-        counts_.emplace_back( 0 );
-        tot_timings_.emplace_back( 0 );
-        min_timings_.emplace_back( std::numeric_limits<double>::max() );
-        max_timings_.emplace_back( 0 );
-        var_timings_.emplace_back( 0 );
         titles_.emplace_back( title );
         locations_.emplace_back( loc );
         nest_.emplace_back( stack.size() );
         stack_.emplace_back( stack );
+        timer_labels_.emplace_back( labels );
 
         for ( const auto& label : labels ) {
             labels_[label].emplace_back( idx );
@@ -94,22 +166,63 @@ size_t TimingsRegistry::add( const eckit::CodeLocation& loc, const CallStack& st
 }
 
 void TimingsRegistry::update( size_t idx, double seconds ) {
-    auto sqr          = []( double x ) { return x * x; };
-    double n          = counts_[idx] + 1;
-    double avg_nm1    = tot_timings_[idx] / std::max( n, 1. );
-    double var_nm1    = var_timings_[idx];
-    var_timings_[idx] = n == 1. ? 0. : ( n - 2. ) / ( n - 1. ) * var_nm1 + 1. / n * sqr( seconds - avg_nm1 );
-    min_timings_[idx] = std::min( seconds, min_timings_[idx] );
-    max_timings_[idx] = std::max( seconds, max_timings_[idx] );
-    tot_timings_[idx] += seconds;
-    counts_[idx] += 1;
+    ThreadLocal& local = thread_local_state();
+    if ( local.accumulator_ == nullptr ) {
+        eckit::AutoLock<eckit::Mutex> lock( mutex_ );
+        accumulators_.emplace_back( new TimingsAccumulator() );
+        local.accumulator_ = accumulators_.back().get();
+    }
+    local.accumulator_->update( idx, seconds );
+}
+
+std::string TimingsRegistry::title( size_t idx ) {
+    eckit::AutoLock<eckit::Mutex> lock( mutex_ );
+    return titles_.at( idx );
+}
+
+Timings::Labels TimingsRegistry::labels( size_t idx ) {
+    eckit::AutoLock<eckit::Mutex> lock( mutex_ );
+    return timer_labels_.at( idx );
 }
 
 size_t TimingsRegistry::size() const {
-    return counts_.size();
+    return titles_.size();
+}
+
+void TimingsRegistry::merge() {
+    const size_t n = size();
+    counts_.assign( n, 0 );
+    tot_timings_.assign( n, 0 );
+    min_timings_.assign( n, std::numeric_limits<double>::max() );
+    max_timings_.assign( n, 0 );
+    var_timings_.assign( n, 0 );
+    std::vector<double> mean( n, 0 );
+    std::vector<double> m2( n, 0 );
+    for ( const auto& accumulator : accumulators_ ) {
+        const TimingsAccumulator& a = *accumulator;
+        for ( size_t j = 0; j < std::min( n, a.counts_.size() ); ++j ) {
+            if ( a.counts_[j] == 0 ) { continue; }
+            // Combine mean and sum of squared deviations of two samples (Chan et al.)
+            const double na    = counts_[j];
+            const double nb    = a.counts_[j];
+            const double delta = a.mean_timings_[j] - mean[j];
+            mean[j] += delta * nb / ( na + nb );
+            m2[j] += a.m2_timings_[j] + delta * delta * na * nb / ( na + nb );
+            counts_[j] += a.counts_[j];
+            tot_timings_[j] += a.tot_timings_[j];
+            min_timings_[j] = std::min( min_timings_[j], a.min_timings_[j] );
+            max_timings_[j] = std::max( max_timings_[j], a.max_timings_[j] );
+        }
+    }
+    for ( size_t j = 0; j < n; ++j ) {
+        var_timings_[j] = counts_[j] > 1 ? m2[j] / double( counts_[j] - 1 ) : 0.;
+    }
 }
 
 void TimingsRegistry::report( std::ostream& out, const eckit::Configuration& config ) {
+    eckit::AutoLock<eckit::Mutex> lock( mutex_ );
+    merge();
+
     auto box_horizontal = []( int n ) {
         std::string s;
         s.reserve( 2 * n );
@@ -361,6 +474,14 @@ void Timings::update( const Identifier& id, double seconds ) {
     TimingsRegistry::instance().update( id, seconds );
 }
 
+std::string Timings::title( const Identifier& id ) {
+    return TimingsRegistry::instance().title( id );
+}
+
+Timings::Labels Timings::labels( const Identifier& id ) {
+    return TimingsRegistry::instance().labels( id );
+}
+
 std::string Timings::report() {
     return report( util::NoConfig() );
 }
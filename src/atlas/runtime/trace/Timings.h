@@ -40,6 +40,10 @@ public:  // static methods
 
     static void update( const Identifier& id, double seconds );
 
+    static std::string title( const Identifier& id );
+
+    static Labels labels( const Identifier& id );
+
     static std::string report();
 
     static std::string report( const Configuration& );
@@ -16,6 +16,7 @@
 
 #include "atlas/runtime/trace/Nesting.h"
 #include "atlas/runtime/trace/StopWatch.h"
+#include "atlas/runtime/trace/Timeline.h"
 #include "atlas/runtime/trace/Timings.h"
 
 //-----------------------------------------------------------------------------------------------------------
@@ -81,6 +82,7 @@ private:  // member data
     Identifier id_;
     Nesting nesting_;
     Labels labels_;
+    double timeline_start_{-1.};
 };
 
 //-----------------------------------------------------------------------------------------------------------
@@ -123,7 +125,10 @@ inline void TraceT<TraceTraits>::barrier() const {
 
 template <typename TraceTraits>
 inline void TraceT<TraceTraits>::registerTimer() {
-    id_ = Timings::add( loc_, nesting_, title_ + ( Barriers::state() ? " [b]" : "" ), labels_ );
+    if ( Barriers::state() ) { id_ = Timings::add( loc_, nesting_, title_ + " [b]", labels_ ); }
+    else {
+        id_ = Timings::add( loc_, nesting_, title_, labels_ );
+    }
 }
 
 template <typename TraceTraits>
@@ -141,6 +146,7 @@ inline void TraceT<TraceTraits>::start() {
     registerTimer();
     Tracing::start( title_ );
     barrier();
+    if ( Timeline::enabled() ) { timeline_start_ = Timeline::now(); }
     stopwatch_.start();
 }
 
@@ -150,6 +156,7 @@ inline void TraceT<TraceTraits>::stop() {
         barrier();
         stopwatch_.stop();
         nesting_.stop();
+        if ( timeline_start_ >= 0. ) { Timeline::record( id_, timeline_start_, Timeline::now() ); }
         updateTimings();
         Tracing::stop( title_, stopwatch_.elapsed() );
         running_ = false;
@@ -8,6 +8,10 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
 #include "eckit/exception/Exceptions.h"
 #include "eckit/thread/AutoLock.h"
 #include "eckit/thread/Mutex.h"
@@ -34,6 +38,25 @@ namespace trans {
 
 TransImpl::~TransImpl() {}
 
+TransCacheFileEntry::TransCacheFileEntry( const eckit::PathName& path ) {
+    int fd = ::open( path.localPath(), O_RDONLY );
+    if ( fd < 0 ) { throw eckit::CantOpenFile( path ); }
+    size_ = size_t( path.size() );
+    if ( size_ ) {
+        data_ = ::mmap( nullptr, size_, PROT_READ, MAP_SHARED, fd, 0 );
+        if ( data_ == MAP_FAILED ) {
+            data_ = nullptr;
+            ::close( fd );
+            throw eckit::FailedSystemCall( "mmap " + path.asString() );
+        }
+    }
+    ::close( fd );
+}
+
+TransCacheFileEntry::~TransCacheFileEntry() {
+    if ( data_ ) { ::munmap( data_, size_ ); }
+}
+
 namespace {
 
 static eckit::Mutex* local_mutex               = 0;
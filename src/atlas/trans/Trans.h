@@ -13,8 +13,7 @@
 #include <memory>
 
 #include "eckit/config/Configuration.h"
-#include "eckit/io/Buffer.h"
-#include "eckit/io/DataHandle.h"
+#include "eckit/filesystem/PathName.h"
 #include "eckit/memory/Owned.h"
 #include "eckit/memory/SharedPtr.h"
 
@@ -39,6 +38,7 @@ namespace trans {
 
 class TransCacheEntry {
 public:
+    virtual ~TransCacheEntry() = default;
     operator bool() const { return size() != 0; }
     virtual size_t size() const      = 0;
     virtual const void* data() const = 0;
@@ -50,18 +50,17 @@ public:
     virtual const void* data() const override { return nullptr; }
 };
 
+/// Cache entry with the read-only contents of a file, mapped into memory.
+/// The file is not read upfront, and its pages are shared by all processes on a node mapping the same file.
 class TransCacheFileEntry : public TransCacheEntry {
-    eckit::Buffer buffer_;
+    size_t size_{0};
+    void* data_{nullptr};
 
 public:
-    TransCacheFileEntry( const eckit::PathName& path ) : buffer_( path.size() ) {
-        std::unique_ptr<eckit::DataHandle> dh( path.fileHandle() );
-        dh->openForRead();
-        dh->read( buffer_.data(), buffer_.size() );
-        dh->close();
-    }
-    virtual size_t size() const override { return buffer_.size(); }
-    virtual const void* data() const override { return buffer_.data(); }
+    TransCacheFileEntry( const eckit::PathName& path );
+    virtual ~TransCacheFileEntry() override;
+    virtual size_t size() const override { return size_; }
+    virtual const void* data() const override { return data_; }
 };
 
 class Cache {
@@ -13,6 +13,8 @@
 #include <cmath>
 #include <iostream>
 
+#include "eckit/exception/Exceptions.h"
+
 #include "atlas/trans/local/FourierTransforms.h"
 
 namespace atlas {
@@ -42,6 +44,23 @@ void invtrans_fourier( const size_t trcFT,
     }
 }
 
+void dirtrans_fourier( const size_t trcFT,
+                       const double lon,     // longitude in radians (in)
+                       const int nb_fields,  // Number of fields
+                       const double rgp[],   // gridpoint values (in)
+                       double rlegReal[],    // real part of Fourier coefficients (inout)
+                       double rlegImag[] )   // imag part of Fourier coefficients (inout)
+{
+    for ( int jm = 0; jm <= trcFT; ++jm ) {
+        const double cos = std::cos( jm * lon );
+        const double sin = std::sin( jm * lon );
+        for ( int jfld = 0; jfld < nb_fields; ++jfld ) {
+            rlegReal[jm * nb_fields + jfld] += cos * rgp[jfld];
+            rlegImag[jm * nb_fields + jfld] -= sin * rgp[jfld];
+        }
+    }
+}
+
 int fourier_truncation( const int truncation,    // truncation
                         const int nx,            // number of longitudes
                         const int nxmax,         // maximum nx
@@ -72,6 +91,203 @@ int fourier_truncation( const int truncation,    // truncation
     return trc;
 }
 
+//-----------------------------------------------------------------------------
+
+FFTPlan::FFTPlan( size_t n ) : n_( n ) {
+    ASSERT( n > 0 );
+
+    // Factorise n, radix 2 first as it has a dedicated butterfly
+    size_t m = n;
+    size_t p = 2;
+    while ( m > 1 ) {
+        while ( m % p ) {
+            p = ( p == 2 ) ? 3 : p + 2;
+            if ( p * p > m ) { p = m; }
+        }
+        m /= p;
+        factors_.push_back( p );
+        factors_.push_back( m );
+    }
+    if ( factors_.empty() ) {
+        factors_.push_back( 1 );
+        factors_.push_back( 1 );
+    }
+
+    twiddles_.resize( n_ );
+    for ( size_t j = 0; j < n_; ++j ) {
+        twiddles_[j] = std::polar( 1., -2. * M_PI * double( j ) / double( n_ ) );
+    }
+}
+
+void FFTPlan::forward( const complex_t in[], complex_t out[] ) const {
+    ASSERT( in != out );
+    execute( out, in, 1, 0, false );
+}
+
+void FFTPlan::backward( const complex_t in[], complex_t out[] ) const {
+    ASSERT( in != out );
+    execute( out, in, 1, 0, true );
+}
+
+void FFTPlan::execute( complex_t out[], const complex_t in[], size_t fstride, size_t f, bool backward ) const {
+    const size_t p = factors_[f];
+    const size_t m = factors_[f + 1];
+    if ( m == 1 ) {
+        for ( size_t q = 0; q < p; ++q ) {
+            out[q] = in[q * fstride];
+        }
+    }
+    else {
+        for ( size_t q = 0; q < p; ++q ) {
+            execute( out + q * m, in + q * fstride, fstride * p, f + 2, backward );
+        }
+    }
+    butterfly( out, fstride, p, m, backward );
+}
+
+void FFTPlan::butterfly( complex_t out[], size_t fstride, size_t p, size_t m, bool backward ) const {
+    auto twiddle = [&]( size_t j ) { return backward ? std::conj( twiddles_[j] ) : twiddles_[j]; };
+
+    if ( p == 1 ) { return; }
+
+    if ( p == 2 ) {
+        for ( size_t u = 0; u < m; ++u ) {
+            complex_t t = out[u + m] * twiddle( u * fstride );
+            out[u + m]  = out[u] - t;
+            out[u] += t;
+        }
+        return;
+    }
+
+    // Generic radix-p butterfly
+    complex_t scratch_stack[64];
+    std::vector<complex_t> scratch_heap( p > 64 ? p : 0 );
+    complex_t* scratch = p > 64 ? scratch_heap.data() : scratch_stack;
+
+    for ( size_t u = 0; u < m; ++u ) {
+        for ( size_t q = 0, k = u; q < p; ++q, k += m ) {
+            scratch[q] = out[k];
+        }
+        for ( size_t q1 = 0, k = u; q1 < p; ++q1, k += m ) {
+            size_t jtw = 0;
+            complex_t sum = scratch[0];
+            for ( size_t q = 1; q < p; ++q ) {
+                jtw += fstride * k;
+                if ( jtw >= n_ ) { jtw -= n_; }
+                sum += scratch[q] * twiddle( jtw );
+            }
+            out[k] = sum;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+FFTPlans::FFTPlans( const std::vector<long>& nx ) {
+    for ( long n : nx ) {
+        add( n );
+    }
+}
+
+void FFTPlans::add( size_t n ) {
+    if ( not has( n ) ) { plans_.emplace( n, std::unique_ptr<FFTPlan>( new FFTPlan( n ) ) ); }
+}
+
+const FFTPlan& FFTPlans::plan( size_t n ) const {
+    auto it = plans_.find( n );
+    ASSERT( it != plans_.end() );
+    return *it->second;
+}
+
+//-----------------------------------------------------------------------------
+
+void invtrans_fourier_regular( const FFTPlan& plan, const size_t trcFT, const double lon0, const int nb_fields,
+                               const double rlegReal[], const double rlegImag[], double rgp[],
+                               std::complex<double> work[] ) {
+    using complex_t = std::complex<double>;
+
+    const size_t nx = plan.size();
+    complex_t* spec = work;
+    complex_t* gp   = work + nx;
+
+    // Two real fields are transformed at once, as real and imaginary part of a
+    // single complex FFT of their Hermitian-symmetric spectra.
+    for ( int jfld = 0; jfld < nb_fields; jfld += 2 ) {
+        const bool pair = ( jfld + 1 < nb_fields );
+        std::fill( spec, spec + nx, complex_t( 0. ) );
+
+        for ( size_t jm = 0; jm <= trcFT; ++jm ) {
+            const complex_t shift = std::polar( 1., jm * lon0 );
+            const size_t k        = jm % nx;
+            const size_t kconj    = ( nx - k ) % nx;
+
+            const complex_t c1( rlegReal[jm * nb_fields + jfld], rlegImag[jm * nb_fields + jfld] );
+            const complex_t c2 =
+                pair ? complex_t( rlegReal[jm * nb_fields + jfld + 1], rlegImag[jm * nb_fields + jfld + 1] )
+                     : complex_t( 0. );
+            if ( jm == 0 ) { spec[0] += complex_t( c1.real(), c2.real() ); }
+            else {
+                const complex_t s1 = 0.5 * c1 * shift;
+                const complex_t s2 = 0.5 * c2 * shift;
+                spec[k] += s1 + complex_t( 0., 1. ) * s2;
+                spec[kconj] += std::conj( s1 ) + complex_t( 0., 1. ) * std::conj( s2 );
+            }
+        }
+
+        plan.backward( spec, gp );
+
+        for ( size_t i = 0; i < nx; ++i ) {
+            rgp[i * nb_fields + jfld] = gp[i].real();
+        }
+        if ( pair ) {
+            for ( size_t i = 0; i < nx; ++i ) {
+                rgp[i * nb_fields + jfld + 1] = gp[i].imag();
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void dirtrans_fourier_regular( const FFTPlan& plan, const size_t trcFT, const double lon0, const int nb_fields,
+                               const double rgp[], double rlegReal[], double rlegImag[],
+                               std::complex<double> work[] ) {
+    using complex_t = std::complex<double>;
+
+    const size_t nx    = plan.size();
+    const double scale = 1. / double( nx );
+    complex_t* gp      = work;
+    complex_t* spec    = work + nx;
+
+    // Two real fields are transformed at once, as real and imaginary part of a
+    // single complex FFT. Their spectra are separated using Hermitian symmetry.
+    for ( int jfld = 0; jfld < nb_fields; jfld += 2 ) {
+        const bool pair = ( jfld + 1 < nb_fields );
+        for ( size_t i = 0; i < nx; ++i ) {
+            gp[i] = complex_t( rgp[i * nb_fields + jfld], pair ? rgp[i * nb_fields + jfld + 1] : 0. );
+        }
+
+        plan.forward( gp, spec );
+
+        for ( size_t jm = 0; jm <= trcFT; ++jm ) {
+            const complex_t shift = std::polar( scale, -double( jm ) * lon0 );
+            const size_t k        = jm % nx;
+            const size_t kconj    = ( nx - k ) % nx;
+
+            const complex_t z  = spec[k];
+            const complex_t zc = std::conj( spec[kconj] );
+            const complex_t c1 = 0.5 * ( z + zc ) * shift;
+            rlegReal[jm * nb_fields + jfld] = c1.real();
+            rlegImag[jm * nb_fields + jfld] = c1.imag();
+            if ( pair ) {
+                const complex_t c2 = complex_t( 0., -0.5 ) * ( z - zc ) * shift;
+                rlegReal[jm * nb_fields + jfld + 1] = c2.real();
+                rlegImag[jm * nb_fields + jfld + 1] = c2.imag();
+            }
+        }
+    }
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 
 }  // namespace trans
@@ -10,7 +10,13 @@
 
 #pragma once
 
+#include <complex>
 #include <cstddef>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "atlas/trans/Trans.h"
 
 namespace atlas {
 namespace trans {
@@ -29,9 +35,104 @@ void invtrans_fourier( const size_t trcFT,
                        const double rlegImag[],  // values of associated Legendre functions, size (trc+1)*trc/2 (in)
                        double rgp[] );           // gridpoint
 
+//-----------------------------------------------------------------------------
+// Routine to add the contribution of one gridpoint to the direct Fourier
+// transformation. Summing over all nx longitudes of a latitude and dividing by
+// nx gives the Fourier coefficients F(m) = 1/nx * sum_i rgp(i) * exp(-i m lon(i))
+//
+void dirtrans_fourier( const size_t trcFT,
+                       const double lon,     // longitude in radians (in)
+                       const int nb_fields,  // Number of fields
+                       const double rgp[],   // gridpoint values, size nb_fields (in)
+                       double rlegReal[],    // real part of Fourier coefficients, size (trcFT+1)*nb_fields (inout)
+                       double rlegImag[] );  // imag part of Fourier coefficients, size (trcFT+1)*nb_fields (inout)
+
 int fourier_truncation( const int truncation, const int nx, const int nxmax, const int ndgl, const double lat,
                         const bool fullgrid );
 
+//-----------------------------------------------------------------------------
+
+/// @class FFTPlan
+///
+/// Mixed-radix complex FFT of fixed length n.
+/// The factorisation of n and the table of twiddle factors are computed once
+/// at construction; execution is thread-safe.
+class FFTPlan {
+public:
+    using complex_t = std::complex<double>;
+
+    FFTPlan( size_t n );
+
+    size_t size() const { return n_; }
+
+    /// out[k] = sum_j in[j] * exp( -2 pi i j k / n )
+    void forward( const complex_t in[], complex_t out[] ) const;
+
+    /// out[j] = sum_k in[k] * exp( +2 pi i j k / n )
+    void backward( const complex_t in[], complex_t out[] ) const;
+
+private:
+    void execute( complex_t out[], const complex_t in[], size_t fstride, size_t f, bool backward ) const;
+    void butterfly( complex_t out[], size_t fstride, size_t p, size_t m, bool backward ) const;
+
+private:
+    size_t n_;
+    std::vector<size_t> factors_;  // pairs (radix p, remaining length m)
+    std::vector<complex_t> twiddles_;
+};
+
+//-----------------------------------------------------------------------------
+
+/// @class FFTPlans
+///
+/// Collection of FFTPlan, one per distinct length.
+/// Can be stored as the fft() entry of a trans::Cache and shared between
+/// transforms of grids with the same number of longitudes per latitude.
+class FFTPlans : public TransCacheEntry {
+public:
+    FFTPlans() = default;
+    FFTPlans( const std::vector<long>& nx );
+
+    void add( size_t n );
+    bool has( size_t n ) const { return plans_.find( n ) != plans_.end(); }
+    const FFTPlan& plan( size_t n ) const;
+
+    virtual size_t size() const override { return plans_.size(); }
+    virtual const void* data() const override { return this; }
+
+private:
+    std::map<size_t, std::unique_ptr<FFTPlan>> plans_;
+};
+
+//-----------------------------------------------------------------------------
+// Routine to compute the Fourier transformation of a full latitude of
+// equally spaced longitudes lon(i) = lon0 + i * 2 pi / nx with an FFT.
+// Result is equivalent to calling invtrans_fourier for every longitude.
+//
+void invtrans_fourier_regular( const FFTPlan& plan,     // FFT plan with size nx (in)
+                               const size_t trcFT,      // truncation for Fourier transformation (in)
+                               const double lon0,       // longitude of first point in radians (in)
+                               const int nb_fields,     // Number of fields
+                               const double rlegReal[], // real part of Legendre transform, size (trcFT+1)*nb_fields (in)
+                               const double rlegImag[], // imag part of Legendre transform, size (trcFT+1)*nb_fields (in)
+                               double rgp[],            // gridpoints, size nx*nb_fields, field index fastest (out)
+                               std::complex<double> work[] );  // workspace, size 2*nx
+
+//-----------------------------------------------------------------------------
+// Routine to compute the direct Fourier transformation of a full latitude of
+// equally spaced longitudes lon(i) = lon0 + i * 2 pi / nx with an FFT.
+// Result is equivalent to accumulating dirtrans_fourier over all longitudes
+// and dividing by nx.
+//
+void dirtrans_fourier_regular( const FFTPlan& plan,     // FFT plan with size nx (in)
+                               const size_t trcFT,      // truncation for Fourier transformation (in)
+                               const double lon0,       // longitude of first point in radians (in)
+                               const int nb_fields,     // Number of fields
+                               const double rgp[],      // gridpoints, size nx*nb_fields, field index fastest (in)
+                               double rlegReal[],       // real part of Fourier coefficients, size (trcFT+1)*nb_fields (out)
+                               double rlegImag[],       // imag part of Fourier coefficients, size (trcFT+1)*nb_fields (out)
+                               std::complex<double> work[] );  // workspace, size 2*nx
+
 // --------------------------------------------------------------------------------------------------------------------
 
 }  // namespace trans
@@ -0,0 +1,102 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <unistd.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "eckit/exception/Exceptions.h"
+
+#include "atlas/grid/Grid.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/trans/Trans.h"
+#include "atlas/trans/local/LegendreCacheFile.h"
+
+namespace atlas {
+namespace trans {
+
+namespace {
+
+static const char magic[16] = "atlas-legendre";
+
+struct Header {
+    char magic[16];
+    std::uint32_t version;
+    std::uint32_t header_size;
+    std::uint64_t truncation;
+    std::uint64_t size;  // number of doubles following the header
+    char grid_uid[64];
+};
+static_assert( sizeof( Header ) % sizeof( double ) == 0, "Legendre data following header must be aligned" );
+
+Header make_header( const Grid& grid, int truncation, size_t size ) {
+    Header header;
+    std::memset( &header, 0, sizeof( Header ) );
+    std::memcpy( header.magic, magic, sizeof( magic ) );
+    header.version     = LegendreCacheFile::version;
+    header.header_size = sizeof( Header );
+    header.truncation  = truncation;
+    header.size        = size;
+    std::strncpy( header.grid_uid, grid.uid().c_str(), sizeof( header.grid_uid ) - 1 );
+    return header;
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+
+const int LegendreCacheFile::version = 1;
+
+eckit::PathName LegendreCacheFile::path( const std::string& directory, const Grid& grid, int truncation ) {
+    std::stringstream name;
+    name << directory << "/legendre-" << grid.uid() << "-T" << truncation << "-v" << version << ".bin";
+    return name.str();
+}
+
+void LegendreCacheFile::write( const eckit::PathName& path, const Grid& grid, int truncation,
+                               const std::vector<double>& legendre ) {
+    Header header = make_header( grid, truncation, legendre.size() );
+
+    std::stringstream tmp;
+    tmp << path.asString() << ".tmp." << ::getpid();
+    {
+        std::ofstream out( tmp.str().c_str(), std::ios::binary );
+        if ( not out ) { throw eckit::CantOpenFile( tmp.str() ); }
+        out.write( reinterpret_cast<const char*>( &header ), sizeof( Header ) );
+        out.write( reinterpret_cast<const char*>( legendre.data() ), legendre.size() * sizeof( double ) );
+        if ( not out ) { throw eckit::WriteError( tmp.str() ); }
+    }
+    if ( std::rename( tmp.str().c_str(), path.localPath() ) != 0 ) {
+        std::remove( tmp.str().c_str() );
+        throw eckit::FailedSystemCall( "rename " + tmp.str() + " to " + path.asString() );
+    }
+}
+
+const double* LegendreCacheFile::data( const TransCacheEntry& entry, const Grid& grid, int truncation,
+                                       size_t size ) {
+    if ( entry.size() < sizeof( Header ) ) { return nullptr; }
+    const Header& header = *reinterpret_cast<const Header*>( entry.data() );
+    Header expected      = make_header( grid, truncation, size );
+    if ( std::memcmp( &header, &expected, sizeof( Header ) ) != 0 ||
+         entry.size() != sizeof( Header ) + size * sizeof( double ) ) {
+        Log::debug() << "Legendre cache does not match grid " << grid.name() << " and truncation " << truncation
+                     << ", or is not a valid version " << version << " cache" << std::endl;
+        return nullptr;
+    }
+    return reinterpret_cast<const double*>( static_cast<const char*>( entry.data() ) + sizeof( Header ) );
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace trans
+}  // namespace atlas
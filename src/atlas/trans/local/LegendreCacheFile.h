@@ -0,0 +1,55 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "eckit/filesystem/PathName.h"
+
+namespace atlas {
+class Grid;
+namespace trans {
+class TransCacheEntry;
+}
+}  // namespace atlas
+
+namespace atlas {
+namespace trans {
+
+//-----------------------------------------------------------------------------
+
+/// @class LegendreCacheFile
+///
+/// Binary file with the precomputed Legendre polynomials of TransLocal.
+/// A header identifying the grid, truncation and file version is followed by
+/// the polynomials as contiguous doubles, so that a memory mapped file can be
+/// used without any copy.
+class LegendreCacheFile {
+public:
+    static const int version;
+
+    /// Path of the cache file for given grid and truncation of the polynomials
+    static eckit::PathName path( const std::string& directory, const Grid&, int truncation );
+
+    /// Write polynomials to file. The file is first written under a temporary name
+    /// and then renamed, so that concurrent readers never see a partial file.
+    static void write( const eckit::PathName&, const Grid&, int truncation, const std::vector<double>& legendre );
+
+    /// @return pointer to the polynomials contained in the cache entry, or nullptr if
+    ///         the entry is not a Legendre cache of this version, grid, truncation and size.
+    static const double* data( const TransCacheEntry&, const Grid&, int truncation, size_t size );
+};
+
+//-----------------------------------------------------------------------------
+
+}  // namespace trans
+}  // namespace atlas
@@ -11,8 +11,8 @@
 
 #include <cmath>
 #include <limits>
+#include <vector>
 
-#include "atlas/array.h"
 #include "atlas/trans/local/LegendrePolynomials.h"
 
 namespace atlas {
@@ -25,39 +25,8 @@ void compute_legendre_polynomials(
     const double lat,  // latitude in radians (in)
     double legpol[] )  // values of associated Legendre functions, size (trc+1)*trc/2 (out)
 {
-    array::ArrayT<int> idxmn_( trc + 1, trc + 1 );
-    array::ArrayView<int, 2> idxmn = array::make_view<int, 2>( idxmn_ );
-
-    int j = 0;
-    for ( int jm = 0; jm <= trc; ++jm ) {
-        for ( int jn = jm; jn <= trc; ++jn ) {
-            idxmn( jm, jn ) = j++;
-        }
-    }
-
-    array::ArrayT<double> zfn_( trc + 1, trc + 1 );
-    array::ArrayView<double, 2> zfn = array::make_view<double, 2>( zfn_ );
-
-    int iodd;
-
-    // Compute coefficients for Taylor series in Belousov (19) and (21)
-    // Belousov, Swarztrauber use zfn(0,0)=std::sqrt(2.)
-    // IFS normalisation chosen to be 0.5*Integral(Pnm**2) = 1
-    zfn( 0, 0 ) = 2.;
-    for ( int jn = 1; jn <= trc; ++jn ) {
-        double zfnn = zfn( 0, 0 );
-        for ( int jgl = 1; jgl <= jn; ++jgl ) {
-            zfnn *= std::sqrt( 1. - 0.25 / ( jgl * jgl ) );
-        }
-        iodd          = jn % 2;
-        zfn( jn, jn ) = zfnn;
-        for ( int jgl = 2; jgl <= jn - iodd; jgl += 2 ) {
-            double zfjn = ( ( jgl - 1. ) * ( 2. * jn - jgl + 2. ) );  // new factor numerator
-            double zfjd = ( jgl * ( 2. * jn - jgl + 1. ) );           // new factor denominator
-
-            zfn( jn, jn - jgl ) = zfn( jn, jn - jgl + 2 ) * zfjn / zfjd;
-        }
-    }
+    // index of (jm,jn) in legpol
+    auto idxmn = [trc]( int jm, int jn ) { return ( jm * ( 2 * trc + 3 - jm ) ) / 2 + jn - jm; };
 
     // --------------------
     // 1. First two columns
@@ -78,37 +47,36 @@ void compute_legendre_polynomials(
         zdl1sita = 1. / zdlsita;
     }
 
-    // ordinary Legendre polynomials from series expansion
-    // ---------------------------------------------------
+    // Coefficients for Taylor series in Belousov (19) and (21), only needed for one jn at a time
+    // Belousov, Swarztrauber use zfn(0,0)=std::sqrt(2.)
+    // IFS normalisation chosen to be 0.5*Integral(Pnm**2) = 1
+    const double zfn00 = 2.;
+    std::vector<double> zfn( trc + 1 );
 
-    // even N
-    for ( int jn = 2; jn <= trc; jn += 2 ) {
-        double zdlk   = 0.5 * zfn( jn, 0 );
-        double zdlldn = 0.0;
-        double zdsq   = 1. / std::sqrt( jn * ( jn + 1. ) );
-        // represented by only even k
-        for ( int jk = 2; jk <= jn; jk += 2 ) {
-            // normalised ordinary Legendre polynomial == \overbar{P_n}^0
-            zdlk = zdlk + zfn( jn, jk ) * std::cos( jk * zdlx1 );
-            // normalised associated Legendre polynomial == \overbar{P_n}^1
-            zdlldn = zdlldn + zdsq * zfn( jn, jk ) * jk * std::sin( jk * zdlx1 );
+    for ( int jn = 1; jn <= trc; ++jn ) {
+        double zfnn = zfn00;
+        for ( int jgl = 1; jgl <= jn; ++jgl ) {
+            zfnn *= std::sqrt( 1. - 0.25 / ( jgl * jgl ) );
+        }
+        int iodd = jn % 2;
+        zfn[jn]  = zfnn;
+        for ( int jgl = 2; jgl <= jn - iodd; jgl += 2 ) {
+            double zfjn = ( ( jgl - 1. ) * ( 2. * jn - jgl + 2. ) );  // new factor numerator
+            double zfjd = ( jgl * ( 2. * jn - jgl + 1. ) );           // new factor denominator
+
+            zfn[jn - jgl] = zfn[jn - jgl + 2] * zfjn / zfjd;
         }
-        legpol[idxmn( 0, jn )] = zdlk;
-        legpol[idxmn( 1, jn )] = zdlldn;
-    }
 
-    // odd N
-    for ( int jn = 1; jn <= trc; jn += 2 ) {
-        zfn( jn, 0 )  = 0.;
-        double zdlk   = 0.;
+        // ordinary Legendre polynomials from series expansion
+        // even N is represented by only even k, odd N by only odd k
+        double zdlk   = iodd ? 0. : 0.5 * zfn[0];
         double zdlldn = 0.0;
         double zdsq   = 1. / std::sqrt( jn * ( jn + 1. ) );
-        // represented by only even k
-        for ( int jk = 1; jk <= jn; jk += 2 ) {
+        for ( int jk = 2 - iodd; jk <= jn; jk += 2 ) {
             // normalised ordinary Legendre polynomial == \overbar{P_n}^0
-            zdlk = zdlk + zfn( jn, jk ) * std::cos( jk * zdlx1 );
+            zdlk = zdlk + zfn[jk] * std::cos( jk * zdlx1 );
             // normalised associated Legendre polynomial == \overbar{P_n}^1
-            zdlldn = zdlldn + zdsq * zfn( jn, jk ) * jk * std::sin( jk * zdlx1 );
+            zdlldn = zdlldn + zdsq * zfn[jk] * jk * std::sin( jk * zdlx1 );
         }
         legpol[idxmn( 0, jn )] = zdlk;
         legpol[idxmn( 1, jn )] = zdlldn;
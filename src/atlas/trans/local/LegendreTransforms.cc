@@ -8,7 +8,10 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <vector>
 
 #include "atlas/trans/local/LegendreTransforms.h"
 
@@ -55,6 +58,188 @@ void invtrans_legendre( const size_t trc,    // truncation (in)
     }
 }
 
+//-----------------------------------------------------------------------------
+
+namespace {
+size_t spectral_offset( const size_t trc, const size_t jm ) {
+    // index of coefficient (jm,jm) for the triangular truncation trc
+    return jm * ( trc + 1 ) - ( jm * ( jm - 1 ) ) / 2;
+}
+
+// Cache blocked matrix product C = A * B
+//   A: nb_rows x nb_inner, row major
+//   B: nb_inner x nb_cols, rows are ldb apart
+//   C: nb_rows x nb_cols, row major
+// The innermost loop runs over contiguous columns of B and C, so that it can be vectorised.
+void matmul( const size_t nb_rows, const size_t nb_inner, const size_t nb_cols, const double* A, const double* B,
+             const size_t ldb, double* C ) {
+    constexpr size_t block_inner = 64;
+    constexpr size_t block_cols  = 256;
+    std::fill( C, C + nb_rows * nb_cols, 0. );
+    for ( size_t jc0 = 0; jc0 < nb_cols; jc0 += block_cols ) {
+        const size_t nc = std::min( block_cols, nb_cols - jc0 );
+        for ( size_t ji0 = 0; ji0 < nb_inner; ji0 += block_inner ) {
+            const size_t ni = std::min( block_inner, nb_inner - ji0 );
+            for ( size_t jr = 0; jr < nb_rows; ++jr ) {
+                double* c       = C + jr * nb_cols + jc0;
+                const double* a = A + jr * nb_inner + ji0;
+                for ( size_t ji = 0; ji < ni; ++ji ) {
+                    const double aij           = a[ji];
+                    const double* b = B + ( ji0 + ji ) * ldb + jc0;
+                    for ( size_t jc = 0; jc < nc; ++jc ) {
+                        c[jc] += aij * b[jc];
+                    }
+                }
+            }
+        }
+    }
+}
+}  // namespace
+
+void invtrans_legendre_symmetric( const size_t trc, const size_t trcLP, const size_t jm, const size_t nb_lats,
+                                  const double* legpol[], const int nb_fields, const double spec[],
+                                  double leg_north[], double leg_south[] ) {
+    const size_t nb_cols = 2 * nb_fields;
+    const size_t nb_n    = trc + 1 - jm;
+    const size_t nb_sym  = ( nb_n + 1 ) / 2;  // n-m even
+    const size_t nb_anti = nb_n / 2;          // n-m odd
+    const size_t k0      = spectral_offset( trc, jm );
+    const size_t klp0    = spectral_offset( trcLP, jm );
+
+    // Pack polynomials as matrices ( latitude, n )
+    std::vector<double> legpol_sym( nb_lats * nb_sym );
+    std::vector<double> legpol_anti( nb_lats * nb_anti );
+    for ( size_t jlat = 0; jlat < nb_lats; ++jlat ) {
+        const double* lp = legpol[jlat] + klp0;
+        for ( size_t jn = 0; jn < nb_sym; ++jn ) {
+            legpol_sym[jlat * nb_sym + jn] = lp[2 * jn];
+        }
+        for ( size_t jn = 0; jn < nb_anti; ++jn ) {
+            legpol_anti[jlat * nb_anti + jn] = lp[2 * jn + 1];
+        }
+    }
+
+    // For fixed (m,n) the real and imaginary parts of all fields are contiguous in spec,
+    // so rows of the spectral matrix ( n, 2*nb_fields ) can be used in place.
+    const double* spec_m = spec + 2 * k0 * nb_fields;
+    std::vector<double> anti( nb_lats * nb_cols );
+    matmul( nb_lats, nb_sym, nb_cols, legpol_sym.data(), spec_m, 2 * nb_cols, leg_north );
+    matmul( nb_lats, nb_anti, nb_cols, legpol_anti.data(), spec_m + nb_cols, 2 * nb_cols, anti.data() );
+
+    // see invtrans_legendre for the factor 2 for jm > 0
+    const double factor = ( jm == 0 ) ? 1. : 2.;
+    for ( size_t j = 0; j < nb_lats * nb_cols; ++j ) {
+        const double sym = leg_north[j];
+        leg_north[j]     = factor * ( sym + anti[j] );
+        leg_south[j]     = factor * ( sym - anti[j] );
+    }
+}
+
+void dirtrans_legendre( const size_t trc, const size_t trcLP, const size_t jm, const size_t nb_lats,
+                        const double* legpol[], const double weights[], const int nb_fields, const double four_real[],
+                        const double four_imag[], double spec[] ) {
+    const size_t k0   = spectral_offset( trc, jm );
+    const size_t klp0 = spectral_offset( trcLP, jm );
+    for ( size_t jn = jm; jn <= trc; ++jn ) {
+        const size_t k = k0 + jn - jm;
+        for ( int jfld = 0; jfld < nb_fields; ++jfld ) {
+            spec[( 2 * k ) * nb_fields + jfld]     = 0.;
+            spec[( 2 * k + 1 ) * nb_fields + jfld] = 0.;
+        }
+    }
+    for ( size_t jlat = 0; jlat < nb_lats; ++jlat ) {
+        const double* lp  = legpol[jlat] + klp0;
+        const double* fr  = four_real + jlat * nb_fields;
+        const double* fi  = four_imag + jlat * nb_fields;
+        const double w    = weights[jlat];
+        for ( size_t jn = jm; jn <= trc; ++jn ) {
+            const size_t k  = k0 + jn - jm;
+            const double wp = w * lp[jn - jm];
+            double* sr      = spec + ( 2 * k ) * nb_fields;
+            double* si      = spec + ( 2 * k + 1 ) * nb_fields;
+            for ( int jfld = 0; jfld < nb_fields; ++jfld ) {
+                sr[jfld] += wp * fr[jfld];
+                si[jfld] += wp * fi[jfld];
+            }
+        }
+    }
+    if ( jm == 0 ) {
+        // imaginary part of zonal wavenumber 0 is zero by definition
+        for ( size_t jn = 0; jn <= trc; ++jn ) {
+            for ( int jfld = 0; jfld < nb_fields; ++jfld ) {
+                spec[( 2 * jn + 1 ) * nb_fields + jfld] = 0.;
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// The meridional derivative of the Legendre functions is computed with the
+// recurrence relation (see e.g. Temperton 1991, MWR 119 p1303)
+//    (1-mu^2) dP(m,n)/dmu = -n eps(m,n+1) P(m,n+1) + (n+1) eps(m,n) P(m,n-1)
+// with eps(m,n) = sqrt( (n^2-m^2) / (4n^2-1) ).
+// Vorticity and divergence then follow after integration by parts:
+//    vor(m,n) = sum_lat w / ( a cos(lat) ) * (  i m v(m) P(m,n) + u(m) H(m,n) )
+//    div(m,n) = sum_lat w / ( a cos(lat) ) * (  i m u(m) P(m,n) - v(m) H(m,n) )
+// with H(m,n) = (1-mu^2) dP(m,n)/dmu
+//
+void dirtrans_legendre_vordiv( const size_t trc, const size_t trcLP, const size_t jm, const size_t nb_lats,
+                               const double* legpol[], const double weights[], const int nb_fields,
+                               const double u_real[], const double u_imag[], const double v_real[],
+                               const double v_imag[], double vorticity_spectra[], double divergence_spectra[] ) {
+    const size_t k0   = spectral_offset( trc, jm );
+    const size_t klp0 = spectral_offset( trcLP, jm );
+    const double m    = jm;
+
+    auto eps = [&]( double n ) { return n > m ? std::sqrt( ( n * n - m * m ) / ( 4. * n * n - 1. ) ) : 0.; };
+
+    for ( size_t jn = jm; jn <= trc; ++jn ) {
+        const size_t k = k0 + jn - jm;
+        for ( int jfld = 0; jfld < nb_fields; ++jfld ) {
+            vorticity_spectra[( 2 * k ) * nb_fields + jfld]      = 0.;
+            vorticity_spectra[( 2 * k + 1 ) * nb_fields + jfld]  = 0.;
+            divergence_spectra[( 2 * k ) * nb_fields + jfld]     = 0.;
+            divergence_spectra[( 2 * k + 1 ) * nb_fields + jfld] = 0.;
+        }
+    }
+    for ( size_t jlat = 0; jlat < nb_lats; ++jlat ) {
+        const double* lp = legpol[jlat] + klp0;
+        const double w   = weights[jlat];
+        const double* ur = u_real + jlat * nb_fields;
+        const double* ui = u_imag + jlat * nb_fields;
+        const double* vr = v_real + jlat * nb_fields;
+        const double* vi = v_imag + jlat * nb_fields;
+        for ( size_t jn = jm; jn <= trc; ++jn ) {
+            const size_t k  = k0 + jn - jm;
+            const double n  = jn;
+            const double p  = lp[jn - jm];
+            const double pp = lp[jn + 1 - jm];
+            const double pm = ( jn > jm ) ? lp[jn - 1 - jm] : 0.;
+            const double h  = -n * eps( n + 1. ) * pp + ( n + 1. ) * eps( n ) * pm;
+            const double wp = w * m * p;
+            const double wh = w * h;
+            double* zr      = vorticity_spectra + ( 2 * k ) * nb_fields;
+            double* zi      = vorticity_spectra + ( 2 * k + 1 ) * nb_fields;
+            double* dr      = divergence_spectra + ( 2 * k ) * nb_fields;
+            double* di      = divergence_spectra + ( 2 * k + 1 ) * nb_fields;
+            for ( int jfld = 0; jfld < nb_fields; ++jfld ) {
+                zr[jfld] += -wp * vi[jfld] + wh * ur[jfld];
+                zi[jfld] += wp * vr[jfld] + wh * ui[jfld];
+                dr[jfld] += -wp * ui[jfld] - wh * vr[jfld];
+                di[jfld] += wp * ur[jfld] - wh * vi[jfld];
+            }
+        }
+    }
+    if ( jm == 0 ) {
+        for ( size_t jn = 0; jn <= trc; ++jn ) {
+            for ( int jfld = 0; jfld < nb_fields; ++jfld ) {
+                vorticity_spectra[( 2 * jn + 1 ) * nb_fields + jfld]  = 0.;
+                divergence_spectra[( 2 * jn + 1 ) * nb_fields + jfld] = 0.;
+            }
+        }
+    }
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 
 }  // namespace trans
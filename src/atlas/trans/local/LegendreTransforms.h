@@ -30,6 +30,63 @@ void invtrans_legendre( const size_t trc,    // truncation (in)
                         double leg_real[],      // values of associated Legendre functions, size (trc+1)*trc/2 (out)
                         double leg_imag[] );    // values of associated Legendre functions, size (trc+1)*trc/2 (out)
 
+//-----------------------------------------------------------------------------
+// Routine to compute the Legendre transformation for one zonal wavenumber jm,
+// for all fields and for a batch of latitude pairs which are symmetric about
+// the equator (e.g. Gaussian latitudes).
+// The spectral coefficients are split in a symmetric (n-m even) and an
+// antisymmetric (n-m odd) part, so that the polynomials are only required on
+// the northern latitudes, and the transformation is computed as two dense
+// matrix products:
+//     leg_north = sym + antisym,    leg_south = sym - antisym
+// The output for every latitude contains the real parts of all fields,
+// followed by the imaginary parts of all fields.
+//
+void invtrans_legendre_symmetric(
+    const size_t trc,        // truncation (in)
+    const size_t trcLP,      // truncation of Legendre polynomials data legpol. Needs to be >= trc (in)
+    const size_t jm,         // zonal wavenumber (in)
+    const size_t nb_lats,    // number of northern latitudes
+    const double* legpol[],  // per northern latitude: values of associated Legendre functions (in)
+    const int nb_fields,     // number of fields
+    const double spec[],     // spectral data, size (trc+1)*(trc+2)*nb_fields (in)
+    double leg_north[],      // northern latitudes, size nb_lats*2*nb_fields (out)
+    double leg_south[] );    // mirrored southern latitudes, in order of the northern ones, size nb_lats*2*nb_fields (out)
+
+//-----------------------------------------------------------------------------
+// Routine to compute the direct Legendre transformation for one zonal
+// wavenumber jm, by Gaussian quadrature over all latitudes
+//
+void dirtrans_legendre( const size_t trc,    // truncation (in)
+                        const size_t trcLP,  // truncation of Legendre polynomials data legpol. Needs to be >= trc (in)
+                        const size_t jm,     // zonal wavenumber (in)
+                        const size_t nb_lats,        // number of latitudes
+                        const double* legpol[],      // per latitude: values of associated Legendre functions (in)
+                        const double weights[],      // quadrature weights per latitude, normalised to sum 1 (in)
+                        const int nb_fields,         // number of fields
+                        const double four_real[],    // real part of Fourier coefficients, size nb_lats*nb_fields (in)
+                        const double four_imag[],    // imag part of Fourier coefficients, size nb_lats*nb_fields (in)
+                        double spec[] );  // spectral data, size (trc+1)*(trc+2)*nb_fields, only jm is written (out)
+
+//-----------------------------------------------------------------------------
+// Routine to compute vorticity and divergence spectra for one zonal
+// wavenumber jm out of the Fourier coefficients of the wind components u and v
+//
+void dirtrans_legendre_vordiv(
+    const size_t trc,             // truncation (in)
+    const size_t trcLP,           // truncation of Legendre polynomials data legpol. Needs to be >= trc+1 (in)
+    const size_t jm,              // zonal wavenumber (in)
+    const size_t nb_lats,         // number of latitudes
+    const double* legpol[],       // per latitude: values of associated Legendre functions (in)
+    const double weights[],       // quadrature weights / ( radius * cos(lat) ) per latitude (in)
+    const int nb_fields,          // number of wind fields
+    const double u_real[],        // real part of Fourier coefficients of u, size nb_lats*nb_fields (in)
+    const double u_imag[],        // imag part of Fourier coefficients of u, size nb_lats*nb_fields (in)
+    const double v_real[],        // real part of Fourier coefficients of v, size nb_lats*nb_fields (in)
+    const double v_imag[],        // imag part of Fourier coefficients of v, size nb_lats*nb_fields (in)
+    double vorticity_spectra[],   // size (trc+1)*(trc+2)*nb_fields, only jm is written (out)
+    double divergence_spectra[] );  // size (trc+1)*(trc+2)*nb_fields, only jm is written (out)
+
 // --------------------------------------------------------------------------------------------------------------------
 
 }  // namespace trans
@@ -8,16 +8,27 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <utility>
+
 #include "atlas/trans/local/TransLocal.h"
 #include "atlas/array.h"
+#include "atlas/field/Field.h"
+#include "atlas/field/FieldSet.h"
+#include "atlas/grid/detail/spacing/gaussian/Latitudes.h"
 #include "atlas/option.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/ErrorHandling.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/trans/VorDivToUV.h"
 #include "atlas/trans/local/FourierTransforms.h"
+#include "atlas/trans/local/LegendreCacheFile.h"
 #include "atlas/trans/local/LegendrePolynomials.h"
 #include "atlas/trans/local/LegendreTransforms.h"
+#include "atlas/util/Earth.h"
 
 namespace atlas {
 namespace trans {
@@ -35,8 +46,144 @@ size_t legendre_size( const size_t truncation ) {
     return ( truncation + 2 ) * ( truncation + 1 ) / 2;
 }
 
+// Number of latitudes, or of latitude pairs for symmetric latitudes, transformed at once in invtrans_uv
+static const size_t latitude_block_size = 32;
+
+bool fft_applicable( const Grid& grid ) {
+    grid::StructuredGrid g( grid );
+    return g && not g.projection() && g.periodic();
+}
+
+/// True if the longitudes of latitude j are equally spaced over the full circle
+bool regular_longitudes( const grid::StructuredGrid& g, size_t j ) {
+    const double dx = g.x( 1, j ) - g.x( 0, j );
+    return std::abs( g.nx( j ) * dx - 360. ) < 1.e-10;
+}
+
+/// True if latitudes are mirrored about the equator, as for Gaussian grids
+bool symmetric_latitudes( const grid::StructuredGrid& g ) {
+    if ( g.projection() ) { return false; }
+    const size_t ny = g.ny();
+    for ( size_t j = 0; j < ny / 2; ++j ) {
+        if ( std::abs( g.y( j ) + g.y( ny - 1 - j ) ) > 1.e-10 ) { return false; }
+    }
+    if ( ny % 2 && std::abs( g.y( ny / 2 ) ) > 1.e-10 ) { return false; }
+    return true;
+}
+
+/// True if the latitudes of the grid are all the given latitudes, e.g. of a global Gaussian grid, and not a subset
+/// of them as for a cropped grid
+bool all_latitudes( const grid::StructuredGrid& g, const std::vector<double>& lats ) {
+    if ( g.ny() != lats.size() ) { return false; }
+    for ( size_t j = 0; j < lats.size(); ++j ) {
+        if ( std::abs( g.y( j ) - lats[j] ) > 1.e-10 ) { return false; }
+    }
+    return true;
+}
+
+void assert_full_grid( const Field& field, const Grid& grid ) {
+    if ( field.shape( 0 ) != grid.size() ) {
+        throw eckit::NotImplemented(
+            "TransLocal only supports gridpoint fields containing all points of the grid, "
+            "distributed fields are not supported",
+            Here() );
+    }
+}
+
+void assert_spectral_size( const Field& field, const size_t nb_coeff ) {
+    if ( field.shape( 0 ) != nb_coeff ) {
+        throw eckit::BadParameter( "Spectral field " + field.name() + " does not match truncation of TransLocal",
+                                   Here() );
+    }
+}
+
+// Copy gridpoint fields with layout (point,values) to layout (field,point) as expected by the IFS style API
+void pack_gridpoints( const FieldSet& fields, std::vector<double>& gp ) {
+    size_t ngp = fields[0].shape( 0 );
+    size_t nb_fields( 0 );
+    for ( size_t jfld = 0; jfld < fields.size(); ++jfld ) {
+        nb_fields += fields[jfld].stride( 0 );
+    }
+    gp.resize( nb_fields * ngp );
+    size_t f( 0 );
+    for ( size_t jfld = 0; jfld < fields.size(); ++jfld ) {
+        const size_t nvar  = fields[jfld].stride( 0 );
+        const double* data = fields[jfld].data<double>();
+        for ( size_t jvar = 0; jvar < nvar; ++jvar, ++f ) {
+            for ( size_t jgp = 0; jgp < ngp; ++jgp ) {
+                gp[f * ngp + jgp] = data[jgp * nvar + jvar];
+            }
+        }
+    }
+}
+
+void unpack_gridpoints( const std::vector<double>& gp, FieldSet& fields ) {
+    size_t ngp = fields[0].shape( 0 );
+    size_t f( 0 );
+    for ( size_t jfld = 0; jfld < fields.size(); ++jfld ) {
+        const size_t nvar = fields[jfld].stride( 0 );
+        double* data      = fields[jfld].data<double>();
+        for ( size_t jvar = 0; jvar < nvar; ++jvar, ++f ) {
+            for ( size_t jgp = 0; jgp < ngp; ++jgp ) {
+                data[jgp * nvar + jvar] = gp[f * ngp + jgp];
+            }
+        }
+    }
+}
+
+// Copy spectral fields with layout (coefficient,values) to layout (coefficient,field)
+void pack_spectral( const FieldSet& fields, std::vector<double>& sp ) {
+    size_t ncoeff = fields[0].shape( 0 );
+    size_t nb_fields( 0 );
+    for ( size_t jfld = 0; jfld < fields.size(); ++jfld ) {
+        nb_fields += fields[jfld].stride( 0 );
+    }
+    sp.resize( nb_fields * ncoeff );
+    size_t f( 0 );
+    for ( size_t jfld = 0; jfld < fields.size(); ++jfld ) {
+        const size_t nvar  = fields[jfld].stride( 0 );
+        const double* data = fields[jfld].data<double>();
+        for ( size_t jc = 0; jc < ncoeff; ++jc ) {
+            for ( size_t jvar = 0; jvar < nvar; ++jvar ) {
+                sp[jc * nb_fields + f + jvar] = data[jc * nvar + jvar];
+            }
+        }
+        f += nvar;
+    }
+}
+
+void unpack_spectral( const std::vector<double>& sp, FieldSet& fields ) {
+    size_t ncoeff = fields[0].shape( 0 );
+    size_t nb_fields( sp.size() / ncoeff );
+    size_t f( 0 );
+    for ( size_t jfld = 0; jfld < fields.size(); ++jfld ) {
+        const size_t nvar = fields[jfld].stride( 0 );
+        double* data      = fields[jfld].data<double>();
+        for ( size_t jc = 0; jc < ncoeff; ++jc ) {
+            for ( size_t jvar = 0; jvar < nvar; ++jvar ) {
+                data[jc * nvar + jvar] = sp[jc * nb_fields + f + jvar];
+            }
+        }
+        f += nvar;
+    }
+}
+
+FieldSet as_fieldset( const Field& field ) {
+    FieldSet fieldset;
+    fieldset.add( field );
+    return fieldset;
+}
+
 }  // namespace
 
+// --------------------------------------------------------------------------------------------------------------------
+// Class FFTCache
+// --------------------------------------------------------------------------------------------------------------------
+
+FFTCache::FFTCache( const Grid& grid ) :
+    Cache( std::make_shared<EmptyCacheEntry>(),
+           std::shared_ptr<TransCacheEntry>( new FFTPlans( grid::StructuredGrid( grid ).nx() ) ) ) {}
+
 // --------------------------------------------------------------------------------------------------------------------
 // Class TransLocal
 // --------------------------------------------------------------------------------------------------------------------
@@ -45,37 +192,92 @@ TransLocal::TransLocal( const Cache& cache, const Grid& grid, const long truncat
                         const eckit::Configuration& config ) :
     grid_( grid ),
     truncation_( truncation ),
-    precompute_( config.getBool( "precompute", true ) ) {
-    if ( precompute_ ) {
-        if ( grid::StructuredGrid( grid_ ) && not grid_.projection() ) {
-            ATLAS_TRACE( "Precompute legendre structured" );
-            grid::StructuredGrid g( grid_ );
-            size_t size( 0 );
-            legendre_begin_.resize( g.ny() );
-            for ( size_t j = 0; j < g.ny(); ++j ) {
-                legendre_begin_[j] = size;
-                size += legendre_size( truncation_ + 1 );
+    precompute_( config.getBool( "precompute", true ) ),
+    cache_( cache ) {
+    if ( config.getBool( "fft", true ) && fft_applicable( grid_ ) ) {
+        fft_ = dynamic_cast<const FFTPlans*>( &cache_.fft() );
+        if ( not fft_ ) {
+            ATLAS_TRACE( "Create FFT plans" );
+            fft_plans_.reset( new FFTPlans( grid::StructuredGrid( grid_ ).nx() ) );
+            fft_ = fft_plans_.get();
+        }
+    }
+    if ( grid::GaussianGrid g = grid_ ) {
+        ATLAS_TRACE( "Compute Gaussian quadrature weights" );
+        // The quadrature is only valid over all latitudes of a Gaussian grid. For a cropped grid the latitudes
+        // differ from those of N = ny/2, no weights are computed and direct transforms are not possible.
+        const size_t N = g.ny() / 2;
+        std::vector<double> lats( 2 * N );
+        std::vector<double> weights( 2 * N );
+        grid::spacing::gaussian::gaussian_quadrature_npole_spole( N, lats.data(), weights.data() );
+        if ( all_latitudes( g, lats ) ) {
+            double sum = 0.;
+            for ( double w : weights ) {
+                sum += w;
+            }
+            for ( double& w : weights ) {
+                w /= sum;
             }
-            legendre_.resize( size );
+            quadrature_weights_ = std::move( weights );
+        }
+    }
+    if ( precompute_ ) {
+        // Legendre polynomials are stored for every latitude of a structured grid, or for every point otherwise
+        const bool structured = grid::StructuredGrid( grid_ ) && not grid_.projection();
+        const size_t nb_rows  = structured ? grid::StructuredGrid( grid_ ).ny() : grid_.size();
+        const size_t size     = legendre_size( truncation_ + 1 );
+        legendre_begin_.resize( nb_rows );
+        for ( size_t j = 0; j < nb_rows; ++j ) {
+            legendre_begin_[j] = j * size;
+        }
 
-            for ( size_t j = 0; j < g.ny(); ++j ) {
-                double lat = g.y( j ) * util::Constants::degreesToRadians();
-                compute_legendre_polynomials( truncation_ + 1, lat, legendre_data( j ) );
+        // Use polynomials from a cache when possible
+        const std::string cache_directory = config.getString( "legendre_cache", "" );
+        eckit::PathName cache_file;
+        if ( not cache_directory.empty() ) {
+            cache_file = LegendreCacheFile::path( cache_directory, grid_, truncation_ + 1 );
+        }
+        if ( cache_.legendre() ) {
+            legendre_data_ = LegendreCacheFile::data( cache_.legendre(), grid_, truncation_ + 1, nb_rows * size );
+        }
+        if ( not legendre_data_ && not cache_directory.empty() ) {
+            if ( cache_file.exists() ) {
+                ATLAS_TRACE( "Map legendre cache file" );
+                legendre_cache_.reset( new TransCacheFileEntry( cache_file ) );
+                legendre_data_ = LegendreCacheFile::data( *legendre_cache_, grid_, truncation_ + 1, nb_rows * size );
             }
         }
-        else {
-            ATLAS_TRACE( "Precompute legendre unstructured" );
-            size_t size( 0 );
-            legendre_begin_.resize( grid_.size() );
-            for ( size_t j = 0; j < grid_.size(); ++j ) {
-                legendre_begin_[j] = size;
-                size += legendre_size( truncation_ + 1 );
+
+        if ( not legendre_data_ ) {
+            legendre_.resize( nb_rows * size );
+            if ( structured ) {
+                ATLAS_TRACE( "Precompute legendre structured" );
+                grid::StructuredGrid g( grid_ );
+                atlas_omp_parallel_for( size_t j = 0; j < nb_rows; ++j ) {
+                    double lat = g.y( j ) * util::Constants::degreesToRadians();
+                    compute_legendre_polynomials( truncation_ + 1, lat, legendre_.data() + legendre_begin_[j] );
+                }
             }
-            legendre_.resize( size );
-            int j( 0 );
-            for ( PointXY p : grid_.xy() ) {
-                double lat = p.y() * util::Constants::degreesToRadians();
-                compute_legendre_polynomials( truncation_ + 1, lat, legendre_data( j++ ) );
+            else {
+                ATLAS_TRACE( "Precompute legendre unstructured" );
+                std::vector<double> xy( 2 * nb_rows );
+                grid_.fill_xy( xy.data() );
+                atlas_omp_parallel_for( size_t j = 0; j < nb_rows; ++j ) {
+                    double lat = xy[2 * j + 1] * util::Constants::degreesToRadians();
+                    compute_legendre_polynomials( truncation_ + 1, lat, legendre_.data() + legendre_begin_[j] );
+                }
+            }
+            legendre_data_ = legendre_.data();
+
+            if ( not cache_directory.empty() && mpi::comm().rank() == 0 ) {
+                ATLAS_TRACE( "Write legendre cache file" );
+                try {
+                    LegendreCacheFile::write( cache_file, grid_, truncation_ + 1, legendre_ );
+                }
+                catch ( const eckit::Exception& e ) {
+                    Log::warning() << "Could not write legendre cache file " << cache_file << ": " << e.what()
+                                   << std::endl;
+                }
             }
         }
     }
@@ -93,35 +295,114 @@ TransLocal::~TransLocal() {}
 // --------------------------------------------------------------------------------------------------------------------
 
 void TransLocal::invtrans( const Field& spfield, Field& gpfield, const eckit::Configuration& config ) const {
-    NOTIMP;
+    FieldSet gpfields = as_fieldset( gpfield );
+    invtrans( as_fieldset( spfield ), gpfields, config );
 }
 
 // --------------------------------------------------------------------------------------------------------------------
 
 void TransLocal::invtrans( const FieldSet& spfields, FieldSet& gpfields, const eckit::Configuration& config ) const {
-    NOTIMP;
+    ASSERT( spfields.size() == gpfields.size() );
+    if ( spfields.size() == 0 ) { return; }
+    int nb_fields( 0 );
+    for ( size_t jfld = 0; jfld < spfields.size(); ++jfld ) {
+        assert_spectral_size( spfields[jfld], spectralCoefficients() );
+        assert_full_grid( gpfields[jfld], grid_ );
+        ASSERT( spfields[jfld].stride( 0 ) == gpfields[jfld].stride( 0 ) );
+        nb_fields += spfields[jfld].stride( 0 );
+    }
+    std::vector<double> sp;
+    std::vector<double> gp( nb_fields * grid_.size() );
+    pack_spectral( spfields, sp );
+    invtrans( nb_fields, sp.data(), gp.data(), config );
+    unpack_gridpoints( gp, gpfields );
 }
 
 // --------------------------------------------------------------------------------------------------------------------
 
 void TransLocal::invtrans_grad( const Field& spfield, Field& gradfield, const eckit::Configuration& config ) const {
-    NOTIMP;
+    // The gradient of a scalar is the divergent wind of the velocity potential chi=scalar,
+    // so it is computed with the vorticity/divergence transform of
+    //    vorticity = 0,  divergence = laplacian(scalar) = -n(n+1)/a^2 * scalar
+    // Components are ( d/dx, d/dy ) = ( 1/(a cos(lat)) d/dlon, 1/a d/dlat )
+    assert_spectral_size( spfield, spectralCoefficients() );
+    assert_full_grid( gradfield, grid_ );
+    const int nb_fields = spfield.stride( 0 );
+    ASSERT( gradfield.stride( 0 ) == size_t( 2 * nb_fields ) );
+
+    std::vector<double> scalar;
+    pack_spectral( as_fieldset( spfield ), scalar );
+
+    const double a2 = util::Earth::radiusInMeters() * util::Earth::radiusInMeters();
+    std::vector<double> vorticity( scalar.size(), 0. );
+    std::vector<double> divergence( scalar.size() );
+    int k = 0;
+    for ( int m = 0; m <= truncation_; ++m ) {          // zonal wavenumber
+        for ( int n = m; n <= truncation_; ++n ) {      // total wavenumber
+            for ( int imag = 0; imag < 2; ++imag ) {    // real/imaginary part
+                for ( int jfld = 0; jfld < nb_fields; ++jfld, ++k ) {
+                    divergence[k] = -n * ( n + 1. ) / a2 * scalar[k];
+                }
+            }
+        }
+    }
+
+    std::vector<double> gp( 2 * nb_fields * grid_.size() );
+    invtrans( nb_fields, vorticity.data(), divergence.data(), gp.data(), config );
+
+    const size_t ngp = grid_.size();
+    double* data     = gradfield.data<double>();
+    for ( int jfld = 0; jfld < nb_fields; ++jfld ) {
+        for ( size_t jgp = 0; jgp < ngp; ++jgp ) {
+            data[jgp * 2 * nb_fields + 2 * jfld + 0] = gp[jfld * ngp + jgp];
+            data[jgp * 2 * nb_fields + 2 * jfld + 1] = gp[( nb_fields + jfld ) * ngp + jgp];
+        }
+    }
 }
 
 // --------------------------------------------------------------------------------------------------------------------
 
 void TransLocal::invtrans_grad( const FieldSet& spfields, FieldSet& gradfields,
                                 const eckit::Configuration& config ) const {
-    NOTIMP;
+    ASSERT( spfields.size() == gradfields.size() );
+    for ( size_t jfld = 0; jfld < spfields.size(); ++jfld ) {
+        Field gradfield = gradfields[jfld];
+        invtrans_grad( spfields[jfld], gradfield, config );
+    }
 }
 
 // --------------------------------------------------------------------------------------------------------------------
 
 void TransLocal::invtrans_vordiv2wind( const Field& spvor, const Field& spdiv, Field& gpwind,
                                        const eckit::Configuration& config ) const {
-    NOTIMP;
+    assert_spectral_size( spvor, spectralCoefficients() );
+    assert_spectral_size( spdiv, spectralCoefficients() );
+    assert_full_grid( gpwind, grid_ );
+    const int nb_fields = spvor.stride( 0 );
+    ASSERT( spdiv.stride( 0 ) == size_t( nb_fields ) );
+    ASSERT( gpwind.stride( 0 ) == size_t( 2 * nb_fields ) );
+
+    std::vector<double> vorticity;
+    std::vector<double> divergence;
+    pack_spectral( as_fieldset( spvor ), vorticity );
+    pack_spectral( as_fieldset( spdiv ), divergence );
+
+    std::vector<double> gp( 2 * nb_fields * grid_.size() );
+    invtrans( nb_fields, vorticity.data(), divergence.data(), gp.data(), config );
+
+    // gp contains all u components, followed by all v components
+    const size_t ngp = grid_.size();
+    double* data     = gpwind.data<double>();
+    for ( int jfld = 0; jfld < nb_fields; ++jfld ) {
+        for ( size_t jgp = 0; jgp < ngp; ++jgp ) {
+            data[jgp * 2 * nb_fields + 2 * jfld + 0] = gp[jfld * ngp + jgp];
+            data[jgp * 2 * nb_fields + 2 * jfld + 1] = gp[( nb_fields + jfld ) * ngp + jgp];
+        }
+    }
 }
 
+// --------------------------------------------------------------------------------------------------------------------
+
 void TransLocal::invtrans( const int nb_scalar_fields, const double scalar_spectra[], double gp_fields[],
                            const eckit::Configuration& config ) const {
     invtrans_uv( truncation_, nb_scalar_fields, 0, scalar_spectra, gp_fields, config );
@@ -173,25 +454,123 @@ void TransLocal::invtrans_uv( const int truncation, const int nb_scalar_fields,
         // Transform
         if ( grid::StructuredGrid g = grid_ ) {
             ATLAS_TRACE( "invtrans_uv structured" );
-            int idx = 0;
-            for ( size_t j = 0; j < g.ny(); ++j ) {
-                double lat = g.y( j ) * util::Constants::degreesToRadians();
-                double trcFT =
-                    fourier_truncation( truncation, g.nx( j ), g.nxmax(), g.ny(), lat, grid::RegularGrid( grid_ ) );
+            const size_t ny = g.ny();
+
+            std::vector<size_t> row_begin( ny );
+            std::vector<int> trcFT( ny );
+            for ( size_t j = 0, n = 0; j < ny; n += g.nx( j ), ++j ) {
+                double lat   = g.y( j ) * util::Constants::degreesToRadians();
+                row_begin[j] = n;
+                trcFT[j] =
+                    fourier_truncation( truncation, g.nx( j ), g.nxmax(), ny, lat, grid::RegularGrid( grid_ ) );
+            }
 
-                // Legendre transform:
-                invtrans_legendre( truncation, trcFT, truncation_ + 1, legPol( lat, j ), nb_fields, scalar_spectra,
-                                   legReal.data(), legImag.data() );
+            // The latitudes are transformed in blocks, so that the Legendre polynomials (unless precomputed) and the
+            // Legendre space data are only held for one block at a time. With symmetric latitudes a block consists of
+            // northern latitudes and their mirrored southern latitudes.
+            // Layout of leg_real and leg_imag: ( slot of latitude in block, zonal wavenumber, field )
+            const size_t nb_m      = truncation + 1;
+            const bool symmetric   = symmetric_latitudes( g );
+            const size_t nb_north  = ( ny + 1 ) / 2;  // northern latitudes, including the equator for odd ny
+            const size_t nb_blocks = symmetric ? nb_north : ny;
+            std::vector<double> legendre_storage;
+            std::vector<double> leg_real( 2 * latitude_block_size * nb_m * nb_fields );
+            std::vector<double> leg_imag( 2 * latitude_block_size * nb_m * nb_fields );
+            std::vector<std::pair<size_t, size_t>> block_latitudes;  // ( latitude, slot )
+            block_latitudes.reserve( 2 * latitude_block_size );
+
+            for ( size_t jbegin = 0; jbegin < nb_blocks; jbegin += latitude_block_size ) {
+                const size_t jend = std::min( jbegin + latitude_block_size, nb_blocks );
+                const size_t nb   = jend - jbegin;
+
+                std::vector<const double*> legpol = legendre_latitudes( jbegin, jend, legendre_storage );
+
+                block_latitudes.clear();
+                for ( size_t k = 0; k < nb; ++k ) {
+                    block_latitudes.emplace_back( jbegin + k, k );
+                }
 
-                // Fourier transform:
-                for ( size_t i = 0; i < g.nx( j ); ++i ) {
-                    double lon = g.x( i, j ) * util::Constants::degreesToRadians();
-                    invtrans_fourier( trcFT, lon, nb_fields, legReal.data(), legImag.data(),
-                                      gp_tmp.data() + ( nb_fields * idx ) );
-                    for ( int jfld = 0; jfld < nb_vordiv_fields; ++jfld ) {
-                        gp_tmp[nb_fields * idx + jfld] /= std::cos( lat );
+                // Legendre transform
+                if ( symmetric ) {
+                    ATLAS_TRACE( "Legendre transform (symmetric, batched)" );
+                    for ( size_t k = 0; k < nb; ++k ) {
+                        const size_t jsouth = ny - 1 - ( jbegin + k );
+                        if ( jsouth != jbegin + k ) { block_latitudes.emplace_back( jsouth, nb + k ); }
+                    }
+                    atlas_omp_parallel {
+                        std::vector<double> leg_north( nb * 2 * nb_fields );
+                        std::vector<double> leg_south( nb * 2 * nb_fields );
+                        std::vector<const double*> legpol_m( nb );
+                        std::vector<size_t> slots_m( nb );
+                        atlas_omp_for( int jm = 0; jm <= truncation; ++jm ) {
+                            // Only latitude pairs whose Fourier truncation includes jm
+                            size_t nb_lats_m = 0;
+                            for ( size_t k = 0; k < nb; ++k ) {
+                                const size_t j = jbegin + k;
+                                if ( std::max( trcFT[j], trcFT[ny - 1 - j] ) >= jm ) {
+                                    legpol_m[nb_lats_m]  = legpol[k];
+                                    slots_m[nb_lats_m++] = k;
+                                }
+                            }
+                            if ( nb_lats_m == 0 ) { continue; }
+                            invtrans_legendre_symmetric( truncation, truncation_ + 1, jm, nb_lats_m,
+                                                         legpol_m.data(), nb_fields, scalar_spectra, leg_north.data(),
+                                                         leg_south.data() );
+                            for ( size_t l = 0; l < nb_lats_m; ++l ) {
+                                const size_t k  = slots_m[l];
+                                const size_t jn = ( k * nb_m + jm ) * nb_fields;
+                                const size_t js = ( ( nb + k ) * nb_m + jm ) * nb_fields;
+                                for ( int jfld = 0; jfld < nb_fields; ++jfld ) {
+                                    leg_real[jn + jfld] = leg_north[2 * l * nb_fields + jfld];
+                                    leg_imag[jn + jfld] = leg_north[( 2 * l + 1 ) * nb_fields + jfld];
+                                }
+                                for ( int jfld = 0; jfld < nb_fields; ++jfld ) {
+                                    leg_real[js + jfld] = leg_south[2 * l * nb_fields + jfld];
+                                    leg_imag[js + jfld] = leg_south[( 2 * l + 1 ) * nb_fields + jfld];
+                                }
+                            }
+                        }
+                    }
+                }
+                else {
+                    ATLAS_TRACE( "Legendre transform" );
+                    atlas_omp_parallel_for( size_t k = 0; k < nb; ++k ) {
+                        invtrans_legendre( truncation, trcFT[jbegin + k], truncation_ + 1, legpol[k], nb_fields,
+                                           scalar_spectra, leg_real.data() + k * nb_m * nb_fields,
+                                           leg_imag.data() + k * nb_m * nb_fields );
+                    }
+                }
+
+                // Fourier transform
+                ATLAS_TRACE_SCOPE( "Fourier transform" ) {
+                    atlas_omp_parallel {
+                        std::vector<std::complex<double>> fft_work( fft_ ? 2 * g.nxmax() : 0 );
+                        atlas_omp_for( size_t l = 0; l < block_latitudes.size(); ++l ) {
+                            const size_t j        = block_latitudes[l].first;
+                            const size_t slot     = block_latitudes[l].second;
+                            const double lat      = g.y( j ) * util::Constants::degreesToRadians();
+                            const double* legReal = leg_real.data() + slot * nb_m * nb_fields;
+                            const double* legImag = leg_imag.data() + slot * nb_m * nb_fields;
+                            double* gp_row        = gp_tmp.data() + nb_fields * row_begin[j];
+                            if ( fft_ && fft_->has( g.nx( j ) ) && regular_longitudes( g, j ) ) {
+                                double lon0 = g.x( 0, j ) * util::Constants::degreesToRadians();
+                                invtrans_fourier_regular( fft_->plan( g.nx( j ) ), trcFT[j], lon0, nb_fields, legReal,
+                                                          legImag, gp_row, fft_work.data() );
+                            }
+                            else {
+                                for ( size_t i = 0; i < g.nx( j ); ++i ) {
+                                    double lon = g.x( i, j ) * util::Constants::degreesToRadians();
+                                    invtrans_fourier( trcFT[j], lon, nb_fields, legReal, legImag,
+                                                      gp_row + nb_fields * i );
+                                }
+                            }
+                            for ( size_t i = 0; i < g.nx( j ); ++i ) {
+                                for ( int jfld = 0; jfld < nb_vordiv_fields; ++jfld ) {
+                                    gp_row[nb_fields * i + jfld] /= std::cos( lat );
+                                }
+                            }
+                        }
                     }
-                    ++idx;
                 }
             }
         }
@@ -280,44 +659,221 @@ void TransLocal::invtrans( const int nb_scalar_fields, const double scalar_spect
 // --------------------------------------------------------------------------------------------------------------------
 
 void TransLocal::dirtrans( const Field& gpfield, Field& spfield, const eckit::Configuration& config ) const {
-    NOTIMP;
-    // Not implemented and not planned.
-    // Use the TransIFS implementation instead.
+    FieldSet spfields = as_fieldset( spfield );
+    dirtrans( as_fieldset( gpfield ), spfields, config );
 }
 
 // --------------------------------------------------------------------------------------------------------------------
 
 void TransLocal::dirtrans( const FieldSet& gpfields, FieldSet& spfields, const eckit::Configuration& config ) const {
-    NOTIMP;
-    // Not implemented and not planned.
-    // Use the TransIFS implementation instead.
+    ASSERT( spfields.size() == gpfields.size() );
+    if ( gpfields.size() == 0 ) { return; }
+    int nb_fields( 0 );
+    for ( size_t jfld = 0; jfld < gpfields.size(); ++jfld ) {
+        assert_full_grid( gpfields[jfld], grid_ );
+        assert_spectral_size( spfields[jfld], spectralCoefficients() );
+        ASSERT( spfields[jfld].stride( 0 ) == gpfields[jfld].stride( 0 ) );
+        nb_fields += gpfields[jfld].stride( 0 );
+    }
+    std::vector<double> gp;
+    std::vector<double> sp( nb_fields * spectralCoefficients() );
+    pack_gridpoints( gpfields, gp );
+    dirtrans( nb_fields, gp.data(), sp.data(), config );
+    unpack_spectral( sp, spfields );
 }
 
 // --------------------------------------------------------------------------------------------------------------------
 
 void TransLocal::dirtrans_wind2vordiv( const Field& gpwind, Field& spvor, Field& spdiv,
                                        const eckit::Configuration& config ) const {
-    NOTIMP;
-    // Not implemented and not planned.
-    // Use the TransIFS implementation instead.
+    assert_full_grid( gpwind, grid_ );
+    assert_spectral_size( spvor, spectralCoefficients() );
+    assert_spectral_size( spdiv, spectralCoefficients() );
+    const int nb_fields = spvor.stride( 0 );
+    ASSERT( spdiv.stride( 0 ) == size_t( nb_fields ) );
+    ASSERT( gpwind.stride( 0 ) == size_t( 2 * nb_fields ) );
+
+    // Reorder to all u components, followed by all v components
+    const size_t ngp   = grid_.size();
+    const double* data = gpwind.data<double>();
+    std::vector<double> gp( 2 * nb_fields * ngp );
+    for ( int jfld = 0; jfld < nb_fields; ++jfld ) {
+        for ( size_t jgp = 0; jgp < ngp; ++jgp ) {
+            gp[jfld * ngp + jgp]                 = data[jgp * 2 * nb_fields + 2 * jfld + 0];
+            gp[( nb_fields + jfld ) * ngp + jgp] = data[jgp * 2 * nb_fields + 2 * jfld + 1];
+        }
+    }
+
+    std::vector<double> vorticity( nb_fields * spectralCoefficients() );
+    std::vector<double> divergence( nb_fields * spectralCoefficients() );
+    dirtrans( nb_fields, gp.data(), vorticity.data(), divergence.data(), config );
+
+    FieldSet spvors = as_fieldset( spvor );
+    FieldSet spdivs = as_fieldset( spdiv );
+    unpack_spectral( vorticity, spvors );
+    unpack_spectral( divergence, spdivs );
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+void TransLocal::assert_dirtrans_possible() const {
+    if ( quadrature_weights_.empty() ) {
+        throw eckit::NotImplemented(
+            "TransLocal::dirtrans is only possible for global Gaussian grids, "
+            "as it relies on Gaussian quadrature",
+            Here() );
+    }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+
+std::vector<const double*> TransLocal::legendre_latitudes( size_t jbegin, size_t jend,
+                                                           std::vector<double>& storage ) const {
+    grid::StructuredGrid g( grid_ );
+    std::vector<const double*> legpol( jend - jbegin );
+    if ( precompute_ ) {
+        for ( size_t j = jbegin; j < jend; ++j ) {
+            legpol[j - jbegin] = legendre_data( j );
+        }
+    }
+    else {
+        ATLAS_TRACE( "Compute legendre" );
+        const size_t size = legendre_size( truncation_ + 1 );
+        storage.resize( ( jend - jbegin ) * size );
+        atlas_omp_parallel_for( size_t j = jbegin; j < jend; ++j ) {
+            double lat = g.y( j ) * util::Constants::degreesToRadians();
+            compute_legendre_polynomials( truncation_ + 1, lat, storage.data() + ( j - jbegin ) * size );
+        }
+        for ( size_t j = jbegin; j < jend; ++j ) {
+            legpol[j - jbegin] = storage.data() + ( j - jbegin ) * size;
+        }
+    }
+    return legpol;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// Fourier analysis of every latitude of a global structured grid.
+// Output layout of four_real and four_imag: ( zonal wavenumber, latitude, field )
+//
+void TransLocal::dirtrans_fourier_latitudes( const int truncation, const int nb_fields, const double gp_fields[],
+                                             std::vector<double>& four_real,
+                                             std::vector<double>& four_imag ) const {
+    ATLAS_TRACE( "Fourier analysis" );
+    grid::StructuredGrid g( grid_ );
+    const size_t ngp      = grid_.size();
+    const size_t ny       = g.ny();
+    const bool regulargrid = grid::RegularGrid( grid_ );
+
+    four_real.assign( ( truncation + 1 ) * ny * nb_fields, 0. );
+    four_imag.assign( ( truncation + 1 ) * ny * nb_fields, 0. );
+
+    std::vector<size_t> row_begin( ny );
+    for ( size_t j = 0, n = 0; j < ny; n += g.nx( j ), ++j ) {
+        row_begin[j] = n;
+    }
+
+    atlas_omp_parallel {
+        std::vector<double> gp_row( g.nxmax() * nb_fields );
+        std::vector<double> leg_real( ( truncation + 1 ) * nb_fields );
+        std::vector<double> leg_imag( ( truncation + 1 ) * nb_fields );
+        std::vector<std::complex<double>> fft_work( fft_ ? 2 * g.nxmax() : 0 );
+
+        atlas_omp_for( size_t j = 0; j < ny; ++j ) {
+            const size_t nx  = g.nx( j );
+            const double lat = g.y( j ) * util::Constants::degreesToRadians();
+            const int trcFT  = fourier_truncation( truncation, nx, g.nxmax(), ny, lat, regulargrid );
+
+            for ( size_t i = 0; i < nx; ++i ) {
+                for ( int jfld = 0; jfld < nb_fields; ++jfld ) {
+                    gp_row[i * nb_fields + jfld] = gp_fields[jfld * ngp + row_begin[j] + i];
+                }
+            }
+
+            if ( fft_ && fft_->has( nx ) && regular_longitudes( g, j ) ) {
+                double lon0 = g.x( 0, j ) * util::Constants::degreesToRadians();
+                dirtrans_fourier_regular( fft_->plan( nx ), trcFT, lon0, nb_fields, gp_row.data(), leg_real.data(),
+                                          leg_imag.data(), fft_work.data() );
+            }
+            else {
+                std::fill( leg_real.begin(), leg_real.end(), 0. );
+                std::fill( leg_imag.begin(), leg_imag.end(), 0. );
+                for ( size_t i = 0; i < nx; ++i ) {
+                    double lon = g.x( i, j ) * util::Constants::degreesToRadians();
+                    dirtrans_fourier( trcFT, lon, nb_fields, gp_row.data() + i * nb_fields, leg_real.data(),
+                                      leg_imag.data() );
+                }
+                for ( int k = 0; k < ( trcFT + 1 ) * nb_fields; ++k ) {
+                    leg_real[k] /= double( nx );
+                    leg_imag[k] /= double( nx );
+                }
+            }
+
+            for ( int jm = 0; jm <= trcFT; ++jm ) {
+                for ( int jfld = 0; jfld < nb_fields; ++jfld ) {
+                    four_real[( jm * ny + j ) * nb_fields + jfld] = leg_real[jm * nb_fields + jfld];
+                    four_imag[( jm * ny + j ) * nb_fields + jfld] = leg_imag[jm * nb_fields + jfld];
+                }
+            }
+        }
+    }
 }
 
 // --------------------------------------------------------------------------------------------------------------------
 
 void TransLocal::dirtrans( const int nb_fields, const double scalar_fields[], double scalar_spectra[],
                            const eckit::Configuration& ) const {
-    NOTIMP;
-    // Not implemented and not planned.
-    // Use the TransIFS implementation instead.
+    ATLAS_TRACE( "TransLocal::dirtrans" );
+    assert_dirtrans_possible();
+    const size_t ny = grid::StructuredGrid( grid_ ).ny();
+
+    std::vector<double> four_real;
+    std::vector<double> four_imag;
+    dirtrans_fourier_latitudes( truncation_, nb_fields, scalar_fields, four_real, four_imag );
+
+    std::vector<double> legendre_storage;
+    std::vector<const double*> legpol = legendre_latitudes( 0, grid::StructuredGrid( grid_ ).ny(), legendre_storage );
+
+    ATLAS_TRACE_SCOPE( "Legendre analysis" ) {
+        atlas_omp_parallel_for( int jm = 0; jm <= truncation_; ++jm ) {
+            dirtrans_legendre( truncation_, truncation_ + 1, jm, ny, legpol.data(), quadrature_weights_.data(),
+                               nb_fields, four_real.data() + jm * ny * nb_fields,
+                               four_imag.data() + jm * ny * nb_fields, scalar_spectra );
+        }
+    }
 }
 
 // --------------------------------------------------------------------------------------------------------------------
 
 void TransLocal::dirtrans( const int nb_fields, const double wind_fields[], double vorticity_spectra[],
                            double divergence_spectra[], const eckit::Configuration& ) const {
-    NOTIMP;
-    // Not implemented and not planned.
-    // Use the TransIFS implementation instead.
+    ATLAS_TRACE( "TransLocal::dirtrans vordiv" );
+    assert_dirtrans_possible();
+    grid::StructuredGrid g( grid_ );
+    const size_t ny  = g.ny();
+    const size_t ngp = grid_.size();
+
+    // wind_fields contains all u components, followed by all v components
+    std::vector<double> u_real, u_imag, v_real, v_imag;
+    dirtrans_fourier_latitudes( truncation_, nb_fields, wind_fields, u_real, u_imag );
+    dirtrans_fourier_latitudes( truncation_, nb_fields, wind_fields + nb_fields * ngp, v_real, v_imag );
+
+    std::vector<double> legendre_storage;
+    std::vector<const double*> legpol = legendre_latitudes( 0, grid::StructuredGrid( grid_ ).ny(), legendre_storage );
+
+    std::vector<double> weights( ny );
+    for ( size_t j = 0; j < ny; ++j ) {
+        double coslat = std::cos( g.y( j ) * util::Constants::degreesToRadians() );
+        weights[j]    = quadrature_weights_[j] / ( util::Earth::radiusInMeters() * coslat );
+    }
+
+    ATLAS_TRACE_SCOPE( "Legendre analysis" ) {
+        atlas_omp_parallel_for( int jm = 0; jm <= truncation_; ++jm ) {
+            const size_t offset = jm * ny * nb_fields;
+            dirtrans_legendre_vordiv( truncation_, truncation_ + 1, jm, ny, legpol.data(), weights.data(), nb_fields,
+                                      u_real.data() + offset, u_imag.data() + offset, v_real.data() + offset,
+                                      v_imag.data() + offset, vorticity_spectra, divergence_spectra );
+        }
+    }
 }
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "atlas/grid/Grid.h"
@@ -30,18 +31,40 @@ namespace trans {
 
 //-----------------------------------------------------------------------------
 
+class FFTPlans;
+
+//-----------------------------------------------------------------------------
+
+/// @class FFTCache
+///
+/// Cache holding FFT plans for every distinct number of longitudes of a structured grid.
+/// Pass it to TransLocal to share the plans between transforms of grids with the same latitudes.
+class FFTCache : public Cache {
+public:
+    FFTCache( const Grid& );
+};
+
+//-----------------------------------------------------------------------------
+
 /// @class TransLocal
 ///
 /// Local spherical harmonics transformations to any grid
-/// Optimisations are present for structured grids
+/// Optimisations are present for structured grids.
+/// For latitudes with equally spaced longitudes spanning the full circle, the Fourier
+/// transform is computed with an FFT (configurable with "fft", default true).
+/// For structured grids with latitudes mirrored about the equator, the Legendre
+/// transform is computed for all latitudes and fields at once per zonal wavenumber,
+/// as matrix products of the symmetric and antisymmetric parts.
 /// For global grids, please consider using TransIFS instead.
 ///
-/// @todo:
-///  - support multiple fields
-///  - support atlas::Field and atlas::FieldSet based on function spaces
+/// Precomputed Legendre polynomials can be cached in a file with the configuration option
+/// "legendre_cache" set to a directory. The file is written on the first run, and memory mapped
+/// on later runs so that all tasks on a node share it. Alternatively pass a LegendreCache( path ).
 ///
-/// @note: Direct transforms are not implemented and cannot be unless
-///        the grid is global. There are no plans to support this at the moment.
+/// @note: Direct transforms are only possible for global Gaussian grids,
+///        as they rely on Gaussian quadrature.
+///        Field based transforms require gridpoint fields containing
+///        all points of the grid (no distribution).
 class TransLocal : public trans::TransImpl {
 public:
     TransLocal( const Grid& g, const long truncation, const eckit::Configuration& = util::NoConfig() );
@@ -82,7 +105,7 @@ public:
                            const double divergence_spectra[], double gp_fields[],
                            const eckit::Configuration& = util::NoConfig() ) const override;
 
-    // -- NOT SUPPORTED -- //
+    // -- Only for global Gaussian grids -- //
 
     virtual void dirtrans( const Field& gpfield, Field& spfield,
                            const eckit::Configuration& = util::NoConfig() ) const override;
@@ -100,19 +123,32 @@ public:
                            double divergence_spectra[], const eckit::Configuration& = util::NoConfig() ) const override;
 
 private:
-    const double* legendre_data( int j ) const { return legendre_.data() + legendre_begin_[j]; }
-    double* legendre_data( int j ) { return legendre_.data() + legendre_begin_[j]; }
+    const double* legendre_data( int j ) const { return legendre_data_ + legendre_begin_[j]; }
 
     void invtrans_uv( const int truncation, const int nb_scalar_fields, const int nb_vordiv_fields,
                       const double scalar_spectra[], double gp_fields[],
                       const eckit::Configuration& = util::NoConfig() ) const;
 
+    void assert_dirtrans_possible() const;
+
+    /// Legendre polynomials for latitudes [jbegin,jend), computed into storage unless precomputed
+    std::vector<const double*> legendre_latitudes( size_t jbegin, size_t jend, std::vector<double>& storage ) const;
+
+    void dirtrans_fourier_latitudes( const int truncation, const int nb_fields, const double gp_fields[],
+                                     std::vector<double>& four_real, std::vector<double>& four_imag ) const;
+
 private:
     int truncation_;
     Grid grid_;
     bool precompute_;
+    Cache cache_;
+    std::shared_ptr<const FFTPlans> fft_plans_;
+    const FFTPlans* fft_{nullptr};
     std::vector<double> legendre_;
     std::vector<size_t> legendre_begin_;
+    std::shared_ptr<TransCacheEntry> legendre_cache_;
+    const double* legendre_data_{nullptr};
+    std::vector<double> quadrature_weights_;
 };
 
 //-----------------------------------------------------------------------------
@@ -1,6 +1,7 @@
 
 #include <stdint.h>
 #include <cstddef>
+#include <cstring>
 
 #include "atlas/util/Checksum.h"
 
@@ -20,6 +21,30 @@ static uint16_t fletcher16( const uint8_t* data, int size ) {
     return s2;
 }
 
+// Finaliser of splitmix64: every input bit affects every output bit
+uint64_t mix64( uint64_t h ) {
+    h = ( h ^ ( h >> 30 ) ) * 0xbf58476d1ce4e5b9ul;
+    h = ( h ^ ( h >> 27 ) ) * 0x94d049bb133111ebul;
+    return h ^ ( h >> 31 );
+}
+
+// Hash 8 bytes at a time, then the remaining bytes
+uint64_t hash64( const char* data, size_t size, uint64_t seed ) {
+    uint64_t h = mix64( seed + 0x9e3779b97f4a7c15ul );
+    size_t i   = 0;
+    for ( ; i + sizeof( uint64_t ) <= size; i += sizeof( uint64_t ) ) {
+        uint64_t word;
+        std::memcpy( &word, data + i, sizeof( uint64_t ) );
+        h = mix64( h ^ word );
+    }
+    if ( i < size ) {
+        uint64_t word = 0;
+        std::memcpy( &word, data + i, size - i );
+        h = mix64( h ^ word );
+    }
+    return mix64( h ^ size );
+}
+
 }  // namespace
 
 static checksum_t checksum( const char* data, size_t size ) {
@@ -50,5 +75,21 @@ checksum_t checksum( const checksum_t values[], size_t size ) {
     return checksum( reinterpret_cast<const char*>( &values[0] ), size * sizeof( checksum_t ) / sizeof( char ) );
 }
 
+checksum_t checksum( const int values[], size_t size, checksum_t key ) {
+    return hash64( reinterpret_cast<const char*>( values ), size * sizeof( int ), key );
+}
+
+checksum_t checksum( const long values[], size_t size, checksum_t key ) {
+    return hash64( reinterpret_cast<const char*>( values ), size * sizeof( long ), key );
+}
+
+checksum_t checksum( const float values[], size_t size, checksum_t key ) {
+    return hash64( reinterpret_cast<const char*>( values ), size * sizeof( float ), key );
+}
+
+checksum_t checksum( const double values[], size_t size, checksum_t key ) {
+    return hash64( reinterpret_cast<const char*>( values ), size * sizeof( double ), key );
+}
+
 }  // namespace util
 }  // namespace atlas
@@ -13,5 +13,13 @@ checksum_t checksum( const float values[], size_t size );
 checksum_t checksum( const double values[], size_t size );
 checksum_t checksum( const checksum_t values[], size_t size );
 
+/// Well mixed 64-bit hash of the bytes of values, seeded with key.
+/// Suitable to be combined with addition over a set of keys, which gives a checksum
+/// that does not depend on the order in which the keys are visited.
+checksum_t checksum( const int values[], size_t size, checksum_t key );
+checksum_t checksum( const long values[], size_t size, checksum_t key );
+checksum_t checksum( const float values[], size_t size, checksum_t key );
+checksum_t checksum( const double values[], size_t size, checksum_t key );
+
 }  // namespace util
 }  // namespace atlas
@@ -8,8 +8,10 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
+#include <sstream>
 
 #include "eckit/exception/Exceptions.h"
 #include "eckit/types/FloatCompare.h"
@@ -33,6 +35,27 @@ static inline double between_m180_and_p180( double a ) {
     return a;
 }
 
+/// Sines and cosines of latitude ϕ and longitude λ (in degrees), with numerical conditioning for both ϕ (poles)
+/// and λ (Greenwich/Date Line)
+static inline void conditioned_sin_cos( const double& lon, const double& lat, double& sin_phi, double& cos_phi,
+                                        double& sin_lambda, double& cos_lambda ) {
+    if ( !( -90. <= lat && lat <= 90. ) ) {
+        std::ostringstream oss;
+        oss.precision( std::numeric_limits<double>::max_digits10 );
+        oss << "Invalid latitude " << lat;
+        throw eckit::BadValue( oss.str(), Here() );
+    }
+
+    const double lambda_deg = between_m180_and_p180( lon );
+    const double lambda     = Constants::degreesToRadians() * lambda_deg;
+    const double phi        = Constants::degreesToRadians() * lat;
+
+    sin_phi    = std::sin( phi );
+    cos_phi    = std::sqrt( 1. - sin_phi * sin_phi );
+    sin_lambda = std::abs( lambda_deg ) < 180. ? std::sin( lambda ) : 0.;
+    cos_lambda = std::abs( lambda_deg ) > 90. ? std::cos( lambda ) : std::sqrt( 1. - sin_lambda * sin_lambda );
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 
 double Sphere::centralAngle( const PointLonLat& p1, const PointLonLat& p2 ) {
@@ -133,27 +156,12 @@ void Sphere::greatCircleLatitudeGivenLongitude( const PointLonLat& p1, const Poi
 PointXYZ Sphere::convertSphericalToCartesian( const PointLonLat& p, const double& radius, const double& height ) {
     ASSERT( radius > 0. );
 
-    if ( !( -90. <= p.lat() && p.lat() <= 90. ) ) {
-        std::ostringstream oss;
-        oss.precision( std::numeric_limits<double>::max_digits10 );
-        oss << "Invalid latitude " << p.lat();
-        throw eckit::BadValue( oss.str(), Here() );
-    }
-
     // See https://en.wikipedia.org/wiki/Reference_ellipsoid#Coordinates
-    // numerical conditioning for both ϕ (poles) and λ (Greenwich/Date Line)
     const double& a = radius;
     const double& b = radius;
 
-    const double lambda_deg = between_m180_and_p180( p.lon() );
-    const double lambda     = Constants::degreesToRadians() * lambda_deg;
-    const double phi        = Constants::degreesToRadians() * p.lat();
-
-    const double sin_phi    = std::sin( phi );
-    const double cos_phi    = std::sqrt( 1. - sin_phi * sin_phi );
-    const double sin_lambda = std::abs( lambda_deg ) < 180. ? std::sin( lambda ) : 0.;
-    const double cos_lambda =
-        std::abs( lambda_deg ) > 90. ? std::cos( lambda ) : std::sqrt( 1. - sin_lambda * sin_lambda );
+    double sin_phi, cos_phi, sin_lambda, cos_lambda;
+    conditioned_sin_cos( p.lon(), p.lat(), sin_phi, cos_phi, sin_lambda, cos_lambda );
 
     if ( eckit::types::is_approximately_equal( a, b ) ) {  // no eccentricity case
 
@@ -170,14 +178,31 @@ PointXYZ Sphere::convertSphericalToCartesian( const PointLonLat& p, const double
 PointLonLat Sphere::convertCartesianToSpherical( const PointXYZ& p, const double& radius ) {
     ASSERT( radius > 0. );
 
+    const double xyz[] = {p.x(), p.y(), std::min( radius, std::max( -radius, p.z() ) ) / radius};
+
+    PointLonLat lonlat;
+    convertCartesianToSpherical( xyz, lonlat.lon(), lonlat.lat() );
+    return lonlat;
+}
+
+void Sphere::convertSphericalToCartesian( const double& lon, const double& lat, double xyz[] ) {
+    double sin_phi, cos_phi, sin_lambda, cos_lambda;
+    conditioned_sin_cos( lon, lat, sin_phi, cos_phi, sin_lambda, cos_lambda );
+
+    xyz[0] = cos_phi * cos_lambda;
+    xyz[1] = cos_phi * sin_lambda;
+    xyz[2] = sin_phi;
+}
+
+void Sphere::convertCartesianToSpherical( const double xyz[], double& lon, double& lat ) {
     // numerical conditioning for both z (poles) and y
 
-    const double x = p.x();
-    const double y = eckit::types::is_approximately_equal( p.y(), 0. ) ? 0. : p.y();
-    const double z = std::min( radius, std::max( -radius, p.z() ) ) / radius;
+    const double x = xyz[0];
+    const double y = eckit::types::is_approximately_equal( xyz[1], 0. ) ? 0. : xyz[1];
+    const double z = std::min( 1., std::max( -1., xyz[2] ) );
 
-    return PointLonLat( Constants::radiansToDegrees() * std::atan2( y, x ),
-                        Constants::radiansToDegrees() * std::asin( z ) );
+    lon = Constants::radiansToDegrees() * std::atan2( y, x );
+    lat = Constants::radiansToDegrees() * std::asin( z );
 }
 
 //----------------------------------------------------------------------------------------------------------------------
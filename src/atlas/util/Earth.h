@@ -42,6 +42,12 @@ struct Sphere {
 
     // Convert Cartesian coordinates to spherical
     static PointLonLat convertCartesianToSpherical( const PointXYZ&, const double& radius );
+
+    // Convert spherical coordinates to Cartesian on the unit sphere, without constructing points
+    static void convertSphericalToCartesian( const double& lon, const double& lat, double xyz[] );
+
+    // Convert Cartesian coordinates on the unit sphere to spherical, without constructing points
+    static void convertCartesianToSpherical( const double xyz[], double& lon, double& lat );
 };
 
 //------------------------------------------------------------------------------------------------------
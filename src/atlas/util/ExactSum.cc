@@ -0,0 +1,126 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <cmath>
+#include <cstdint>
+
+#include "atlas/util/ExactSum.h"
+
+namespace atlas {
+namespace util {
+
+namespace {
+
+static_assert( sizeof( ExactSum::limb_t ) == 8, "ExactSum needs 64 bit digits" );
+
+// Bit position of 2^0 in the fixed point number; the smallest subnormal double is 2^-1074
+constexpr int bias = 1074;
+
+constexpr std::uint64_t digit_mask = 0xffffffffull;
+
+// Each addition changes a digit by less than 2^32, so 2^30 additions fit in 63 bits
+constexpr size_t max_additions = size_t( 1 ) << 30;
+
+}  // namespace
+
+void ExactSum::clear() {
+    limbs_.fill( 0 );
+    special_      = 0.;
+    nb_additions_ = 0;
+}
+
+void ExactSum::add( double value ) {
+    if ( value == 0. ) { return; }
+    if ( not std::isfinite( value ) ) {
+        special_ += value;
+        return;
+    }
+
+    // value = +/- mantissa * 2^( exponent - 53 ), with mantissa an integer below 2^53
+    int exponent;
+    const double fraction = std::frexp( std::abs( value ), &exponent );
+    std::uint64_t mantissa = std::uint64_t( std::ldexp( fraction, 53 ) );
+    int position           = exponent - 53 + bias;
+    if ( position < 0 ) {
+        // subnormal: the bits shifted out are zero
+        mantissa >>= -position;
+        position = 0;
+    }
+
+    const size_t digit = size_t( position ) / 32;
+    const int shift    = position % 32;
+    const std::uint64_t lo = ( mantissa & digit_mask ) << shift;
+    const std::uint64_t hi = ( mantissa >> 32 ) << shift;
+
+    const limb_t d0 = limb_t( lo & digit_mask );
+    const limb_t d1 = limb_t( lo >> 32 ) + limb_t( hi & digit_mask );
+    const limb_t d2 = limb_t( hi >> 32 );
+    if ( value > 0 ) {
+        limbs_[digit] += d0;
+        limbs_[digit + 1] += d1;
+        limbs_[digit + 2] += d2;
+    }
+    else {
+        limbs_[digit] -= d0;
+        limbs_[digit + 1] -= d1;
+        limbs_[digit + 2] -= d2;
+    }
+
+    // d1 may be up to 2^33, which counts as two additions
+    nb_additions_ += 2;
+    if ( nb_additions_ >= max_additions ) { normalise(); }
+}
+
+ExactSum& ExactSum::operator+=( const ExactSum& other ) {
+    ExactSum normalised( other );
+    normalised.normalise();
+    normalise();
+    for ( size_t i = 0; i < size(); ++i ) {
+        limbs_[i] += normalised.limbs_[i];
+    }
+    special_ += other.special_;
+    nb_additions_ = 2;
+    return *this;
+}
+
+void ExactSum::normalise() {
+    for ( size_t i = 0; i + 1 < size(); ++i ) {
+        // floor division by 2^32, also for negative digits
+        const limb_t carry = limbs_[i] >= 0 ? limbs_[i] >> 32 : -( ( -limbs_[i] + limb_t( digit_mask ) ) >> 32 );
+        limbs_[i] -= carry * ( limb_t( 1 ) << 32 );
+        limbs_[i + 1] += carry;
+    }
+    nb_additions_ = 0;
+}
+
+double ExactSum::value() const {
+    if ( special_ != 0. ) { return special_; }
+
+    ExactSum magnitude( *this );
+    magnitude.normalise();
+    const bool negative = magnitude.limbs_[size() - 1] < 0;
+    if ( negative ) {
+        for ( size_t i = 0; i < size(); ++i ) {
+            magnitude.limbs_[i] = -magnitude.limbs_[i];
+        }
+        magnitude.normalise();
+    }
+
+    // All digits are now non-negative. Adding them from the most significant one down
+    // rounds faithfully: the digits below the first three only affect the last bit.
+    double result = 0.;
+    for ( size_t i = size(); i-- > 0; ) {
+        if ( magnitude.limbs_[i] ) { result += std::ldexp( double( magnitude.limbs_[i] ), int( 32 * i ) - bias ); }
+    }
+    return negative ? -result : result;
+}
+
+}  // namespace util
+}  // namespace atlas
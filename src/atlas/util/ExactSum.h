@@ -0,0 +1,66 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace atlas {
+namespace util {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// @brief Exact accumulator for sums of floating point values
+///
+/// The sum is kept as a fixed point number that is wide enough to hold any double exactly.
+/// Additions are therefore exact, and the accumulated state does not depend on the order
+/// in which values are added, nor on how they are split over threads or MPI tasks before
+/// the accumulators are combined. Only value() rounds, always in the same way.
+class ExactSum {
+public:
+    using limb_t = long;
+
+    /// Number of 32 bit digits, covering the exponent range of double plus headroom for carries
+    static constexpr size_t size() { return 70; }
+
+public:
+    ExactSum() { clear(); }
+
+    void clear();
+
+    void add( double value );
+
+    ExactSum& operator+=( const ExactSum& other );
+
+    /// Sum rounded to double
+    double value() const;
+
+    /// Bring all digits but the last in the range [0,2^32). Normalised digits of up to 2^31
+    /// accumulators can be summed as integers, e.g. with an MPI reduction, without overflow.
+    void normalise();
+
+    /// Sum of the non-finite values that were added, or 0 if there were none
+    double nonfinite() const { return special_; }
+
+    /// Digits, with the least significant first
+    limb_t* data() { return limbs_.data(); }
+    const limb_t* data() const { return limbs_.data(); }
+
+private:
+    std::array<limb_t, 70> limbs_;
+    double special_;       // sum of non-finite values
+    size_t nb_additions_;  // additions since the last normalisation
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace util
+}  // namespace atlas
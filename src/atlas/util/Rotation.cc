@@ -242,5 +242,76 @@ void Rotation::unrotate( double crd[] ) const {
     crd[LAT] = L.lat();
 }
 
+namespace {
+
+inline void rotate_xyz( const double p[], const RotationMatrix& R, double pt[] ) {
+    pt[XX] = R[XX][XX] * p[XX] + R[XX][YY] * p[YY] + R[XX][ZZ] * p[ZZ];
+    pt[YY] = R[YY][XX] * p[XX] + R[YY][YY] * p[YY] + R[YY][ZZ] * p[ZZ];
+    pt[ZZ] = R[ZZ][XX] * p[XX] + R[ZZ][YY] * p[YY] + R[ZZ][ZZ] * p[ZZ];
+}
+
+}  // namespace
+
+void Rotation::rotate( size_t n, double lon[], double lat[], size_t stride ) const {
+#if OLD_IMPLEMENTATION
+    for ( size_t k = 0; k < n; ++k ) {
+        double crd[] = {lon[k * stride], lat[k * stride]};
+        rotate_old( crd );
+        lon[k * stride] = crd[LON];
+        lat[k * stride] = crd[LAT];
+    }
+    return;
+#endif
+
+    if ( !rotated_ ) { return; }
+    else if ( rotation_angle_only_ ) {
+        for ( size_t k = 0; k < n; ++k ) {
+            lon[k * stride] -= angle_;
+        }
+        return;
+    }
+
+    const RotationMatrix R = rotate_;
+    const double angle     = angle_;
+    double P[3], Pt[3];
+    for ( size_t k = 0; k < n; ++k ) {
+        const size_t i = k * stride;
+        Sphere::convertSphericalToCartesian( lon[i], lat[i], P );
+        rotate_xyz( P, R, Pt );
+        Sphere::convertCartesianToSpherical( Pt, lon[i], lat[i] );
+        lon[i] -= angle;
+    }
+}
+
+void Rotation::unrotate( size_t n, double lon[], double lat[], size_t stride ) const {
+#if OLD_IMPLEMENTATION
+    for ( size_t k = 0; k < n; ++k ) {
+        double crd[] = {lon[k * stride], lat[k * stride]};
+        unrotate_old( crd );
+        lon[k * stride] = crd[LON];
+        lat[k * stride] = crd[LAT];
+    }
+    return;
+#endif
+
+    if ( !rotated_ ) { return; }
+    else if ( rotation_angle_only_ ) {
+        for ( size_t k = 0; k < n; ++k ) {
+            lon[k * stride] += angle_;
+        }
+        return;
+    }
+
+    const RotationMatrix R = unrotate_;
+    const double angle     = angle_;
+    double Pt[3], P[3];
+    for ( size_t k = 0; k < n; ++k ) {
+        const size_t i = k * stride;
+        Sphere::convertSphericalToCartesian( lon[i] + angle, lat[i], Pt );
+        rotate_xyz( Pt, R, P );
+        Sphere::convertCartesianToSpherical( P, lon[i], lat[i] );
+    }
+}
+
 }  // namespace util
 }  // namespace atlas
@@ -11,6 +11,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <iosfwd>
 
 #include "atlas/util/Point.h"
@@ -40,6 +41,11 @@ public:
     void rotate( double crd[] ) const;
     void unrotate( double crd[] ) const;
 
+    /// Rotate n points in place, accessed with given stride.
+    /// Gives the same result as rotating point by point, without per-point setup.
+    void rotate( size_t n, double lon[], double lat[], size_t stride = 1 ) const;
+    void unrotate( size_t n, double lon[], double lat[], size_t stride = 1 ) const;
+
 private:
     void precompute();
 
@@ -0,0 +1,225 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace atlas {
+namespace util {
+
+//------------------------------------------------------------------------------------------------------
+
+/// @brief Hash of integral keys for FlatHashMap
+///
+/// 64-bit avalanche (murmur3 finaliser), so that the structured bit patterns
+/// of uids (micro-degree lon/lat packed in one integer) spread over all slots
+template <typename Key>
+struct FlatHash {
+    size_t operator()( const Key& key ) const {
+        uint64_t h = static_cast<uint64_t>( key );
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return static_cast<size_t>( h );
+    }
+};
+
+/// @brief Open-addressing hash map with linear probing, for integral keys
+///
+/// Keys, values and slot states are stored in three flat arrays whose capacity is a
+/// power of two, kept at most half full. Erased elements leave a tombstone, so that
+/// the probe sequences of other keys stay intact; tombstones are reused by following
+/// insertions and dropped when the map is rehashed.
+/// clear() empties the map but keeps its capacity so that it can be refilled
+/// without reallocation.
+/// Intended for the large uid -> local index lookups in mesh actions, where
+/// std::map spends most of its time in node allocation and pointer chasing.
+template <typename Key, typename Value, typename Hash = FlatHash<Key>>
+class FlatHashMap {
+public:
+    using key_type   = Key;
+    using value_type = Value;
+
+    FlatHashMap() = default;
+
+    explicit FlatHashMap( size_t n ) { reserve( n ); }
+
+    size_t size() const { return size_; }
+
+    bool empty() const { return size_ == 0; }
+
+    size_t capacity() const { return keys_.size(); }
+
+    /// Make room for n elements without further rehashing
+    void reserve( size_t n ) {
+        size_t capacity = min_capacity();
+        while ( capacity < 2 * n ) {
+            capacity *= 2;
+        }
+        if ( capacity > keys_.size() ) rehash( capacity );
+    }
+
+    /// Remove all elements, keeping the allocated capacity
+    void clear() {
+        std::fill( state_.begin(), state_.end(), EMPTY );
+        size_   = 0;
+        erased_ = 0;
+    }
+
+    /// Return pointer to value mapped to key, or nullptr if not present
+    const Value* find( const Key& key ) const {
+        if ( size_ == 0 ) return nullptr;
+        size_t i = slot( key );
+        while ( state_[i] != EMPTY ) {
+            if ( state_[i] == USED && keys_[i] == key ) return &values_[i];
+            i = ( i + 1 ) & mask_;
+        }
+        return nullptr;
+    }
+
+    Value* find( const Key& key ) {
+        return const_cast<Value*>( static_cast<const FlatHashMap&>( *this ).find( key ) );
+    }
+
+    bool contains( const Key& key ) const { return find( key ) != nullptr; }
+
+    /// Insert (key,value) if key is not yet present.
+    /// @return true if inserted, false if key was already present (value is then untouched)
+    bool insert( const Key& key, const Value& value ) {
+        bool inserted;
+        Value& v = emplace( key, inserted );
+        if ( inserted ) v = value;
+        return inserted;
+    }
+
+    /// Access value mapped to key, inserting a value-initialised one if not present
+    Value& operator[]( const Key& key ) {
+        bool inserted;
+        return emplace( key, inserted );
+    }
+
+    /// Remove key from the map
+    /// @return true if removed, false if key was not present
+    bool erase( const Key& key ) {
+        const Value* v = find( key );
+        if ( v == nullptr ) return false;
+        const size_t i = size_t( v - values_.data() );
+        state_[i]      = ERASED;
+        --size_;
+        ++erased_;
+        return true;
+    }
+
+private:
+    enum State : unsigned char
+    {
+        EMPTY  = 0,
+        USED   = 1,
+        ERASED = 2
+    };
+
+    static size_t min_capacity() { return 16; }
+
+    size_t slot( const Key& key ) const { return Hash()( key ) & mask_; }
+
+    Value& emplace( const Key& key, bool& inserted ) {
+        if ( 2 * ( size_ + erased_ + 1 ) > keys_.size() ) {
+            // Grow when the elements fill the map, otherwise only drop the tombstones
+            rehash( keys_.empty() ? min_capacity() : ( 4 * ( size_ + 1 ) > keys_.size() ? 2 : 1 ) * keys_.size() );
+        }
+        size_t i         = slot( key );
+        size_t tombstone = keys_.size();
+        while ( state_[i] != EMPTY ) {
+            if ( state_[i] == USED && keys_[i] == key ) {
+                inserted = false;
+                return values_[i];
+            }
+            if ( state_[i] == ERASED && tombstone == keys_.size() ) tombstone = i;
+            i = ( i + 1 ) & mask_;
+        }
+        if ( tombstone != keys_.size() ) {
+            i = tombstone;
+            --erased_;
+        }
+        state_[i]  = USED;
+        keys_[i]   = key;
+        values_[i] = Value();
+        ++size_;
+        inserted = true;
+        return values_[i];
+    }
+
+    void rehash( size_t capacity ) {
+        std::vector<Key> keys( capacity );
+        std::vector<Value> values( capacity );
+        std::vector<unsigned char> state( capacity, EMPTY );
+        keys_.swap( keys );
+        values_.swap( values );
+        state_.swap( state );
+        mask_   = capacity - 1;
+        size_   = 0;
+        erased_ = 0;
+        bool inserted;
+        for ( size_t j = 0; j < state.size(); ++j ) {
+            if ( state[j] == USED ) emplace( keys[j], inserted ) = values[j];
+        }
+    }
+
+private:
+    std::vector<Key> keys_;
+    std::vector<Value> values_;
+    std::vector<unsigned char> state_;
+    size_t mask_{0};
+    size_t size_{0};
+    size_t erased_{0};
+};
+
+//------------------------------------------------------------------------------------------------------
+
+/// @brief Open-addressing hash set for integral keys, see FlatHashMap
+template <typename Key>
+class FlatHashSet {
+public:
+    using key_type = Key;
+
+    FlatHashSet() = default;
+
+    explicit FlatHashSet( size_t n ) : map_( n ) {}
+
+    size_t size() const { return map_.size(); }
+
+    bool empty() const { return map_.empty(); }
+
+    void reserve( size_t n ) { map_.reserve( n ); }
+
+    void clear() { map_.clear(); }
+
+    bool contains( const Key& key ) const { return map_.contains( key ); }
+
+    /// @return true if inserted, false if key was already present
+    bool insert( const Key& key ) { return map_.insert( key, 1 ); }
+
+    /// @return true if removed, false if key was not present
+    bool erase( const Key& key ) { return map_.erase( key ); }
+
+private:
+    FlatHashMap<Key, unsigned char> map_;
+};
+
+//------------------------------------------------------------------------------------------------------
+
+}  // namespace util
+}  // namespace atlas
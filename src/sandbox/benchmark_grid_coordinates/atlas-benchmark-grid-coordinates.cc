@@ -0,0 +1,139 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+
+#include "atlas/grid.h"
+#include "atlas/runtime/AtlasTool.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
+
+//------------------------------------------------------------------------------
+
+using namespace atlas;
+using namespace atlas::grid;
+
+//------------------------------------------------------------------------------
+
+class Tool : public AtlasTool {
+    virtual void execute( const Args& args );
+    virtual std::string briefDescription() {
+        return "Tool to compare per-point grid iteration with the bulk fill_xy/fill_lonlat coordinate API";
+    }
+    virtual std::string usage() { return name() + " --grid=name [OPTION]... [--help]"; }
+
+public:
+    Tool( int argc, char** argv );
+};
+
+//-----------------------------------------------------------------------------
+
+Tool::Tool( int argc, char** argv ) : AtlasTool( argc, argv ) {
+    add_option( new SimpleOption<std::string>(
+        "grid", "Grid unique identifier\n" + indent() + "     Example values: N80, F40, O24, L32" ) );
+    add_option( new SimpleOption<long>( "iterations", "Number of iterations (default=5)" ) );
+}
+
+//-----------------------------------------------------------------------------
+
+void Tool::execute( const Args& args ) {
+    std::string key;
+    args.get( "grid", key );
+
+    Grid grid;
+    if ( key.size() ) {
+        try {
+            grid = Grid( key );
+        }
+        catch ( eckit::BadParameter& e ) {
+        }
+    }
+    else {
+        Log::error() << "No grid specified." << std::endl;
+    }
+
+    if ( !grid ) return;
+
+    long iterations = args.getLong( "iterations", 5 );
+
+    const size_t size = grid.size();
+    std::vector<double> xy_iterator( 2 * size );
+    std::vector<double> lonlat_iterator( 2 * size );
+    std::vector<double> xy_bulk( 2 * size );
+    std::vector<double> lonlat_bulk( 2 * size );
+
+    double time_xy_iterator     = 0.;
+    double time_lonlat_iterator = 0.;
+    double time_xy_bulk         = 0.;
+    double time_lonlat_bulk     = 0.;
+
+    for ( long i = 0; i < iterations; ++i ) {
+        {
+            Trace timer( Here(), "xy iterator" );
+            size_t n = 0;
+            for ( PointXY p : grid.xy() ) {
+                xy_iterator[n++] = p.x();
+                xy_iterator[n++] = p.y();
+            }
+            timer.stop();
+            time_xy_iterator += timer.elapsed();
+        }
+        {
+            Trace timer( Here(), "lonlat iterator" );
+            size_t n = 0;
+            for ( PointLonLat p : grid.lonlat() ) {
+                lonlat_iterator[n++] = p.lon();
+                lonlat_iterator[n++] = p.lat();
+            }
+            timer.stop();
+            time_lonlat_iterator += timer.elapsed();
+        }
+        {
+            Trace timer( Here(), "fill_xy" );
+            grid.fill_xy( xy_bulk.data() );
+            timer.stop();
+            time_xy_bulk += timer.elapsed();
+        }
+        {
+            Trace timer( Here(), "fill_lonlat" );
+            grid.fill_lonlat( lonlat_bulk.data() );
+            timer.stop();
+            time_lonlat_bulk += timer.elapsed();
+        }
+    }
+
+    if ( xy_iterator != xy_bulk || lonlat_iterator != lonlat_bulk ) {
+        throw eckit::SeriousBug( "Bulk coordinates differ from iterated coordinates", Here() );
+    }
+
+    Log::info() << "grid: " << grid.name() << "  points: " << size << "  iterations: " << iterations << std::endl;
+    Log::info() << "  xy iterator     : " << std::setprecision( 5 ) << time_xy_iterator / iterations << " s"
+                << std::endl;
+    Log::info() << "  fill_xy         : " << std::setprecision( 5 ) << time_xy_bulk / iterations << " s" << std::endl;
+    Log::info() << "  speedup         : " << time_xy_iterator / time_xy_bulk << std::endl;
+    Log::info() << "  lonlat iterator : " << std::setprecision( 5 ) << time_lonlat_iterator / iterations << " s"
+                << std::endl;
+    Log::info() << "  fill_lonlat     : " << std::setprecision( 5 ) << time_lonlat_bulk / iterations << " s"
+                << std::endl;
+    Log::info() << "  speedup         : " << time_lonlat_iterator / time_lonlat_bulk << std::endl;
+    Log::info() << Trace::report() << std::endl;
+}
+
+//------------------------------------------------------------------------------
+
+int main( int argc, char** argv ) {
+    Tool tool( argc, argv );
+    return tool.start();
+}
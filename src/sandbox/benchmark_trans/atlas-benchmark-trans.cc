@@ -0,0 +1,127 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+
+#include "atlas/grid.h"
+#include "atlas/runtime/AtlasTool.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/trans/Trans.h"
+#include "atlas/util/Config.h"
+
+//------------------------------------------------------------------------------
+
+using namespace atlas;
+using namespace atlas::grid;
+using atlas::util::Config;
+
+//------------------------------------------------------------------------------
+
+class Tool : public AtlasTool {
+    virtual void execute( const Args& args );
+    virtual std::string briefDescription() {
+        return "Tool to compare the FFT and the pointwise Fourier transform of the local inverse spectral "
+               "transform";
+    }
+    virtual std::string usage() { return name() + " --grid=name --truncation=T [OPTION]... [--help]"; }
+
+public:
+    Tool( int argc, char** argv );
+};
+
+//-----------------------------------------------------------------------------
+
+Tool::Tool( int argc, char** argv ) : AtlasTool( argc, argv ) {
+    add_option( new SimpleOption<std::string>(
+        "grid", "Grid unique identifier\n" + indent() + "     Example values: N80, F40, O24, L32" ) );
+    add_option( new SimpleOption<long>( "truncation", "Spectral truncation (default=N-1)" ) );
+    add_option( new SimpleOption<long>( "fields", "Number of fields (default=1)" ) );
+    add_option( new SimpleOption<long>( "iterations", "Number of iterations (default=1)" ) );
+}
+
+//-----------------------------------------------------------------------------
+
+void Tool::execute( const Args& args ) {
+    std::string key;
+    args.get( "grid", key );
+
+    StructuredGrid grid;
+    if ( key.size() ) {
+        try {
+            grid = Grid( key );
+        }
+        catch ( eckit::BadParameter& e ) {
+        }
+    }
+    else {
+        Log::error() << "No grid specified." << std::endl;
+    }
+
+    if ( !grid ) return;
+
+    long truncation = args.getLong( "truncation", grid.ny() - 1 );
+    long nb_fields  = args.getLong( "fields", 1 );
+    long iterations = args.getLong( "iterations", 1 );
+
+    trans::Trans trans_fft( grid, truncation, Config( "type", "local" ) | Config( "fft", true ) );
+    trans::Trans trans_dft( grid, truncation, Config( "type", "local" ) | Config( "fft", false ) );
+
+    std::vector<double> rspec( nb_fields * trans_fft.spectralCoefficients() );
+    for ( size_t j = 0; j < rspec.size(); ++j ) {
+        rspec[j] = 1. / ( 1. + j );
+    }
+    std::vector<double> rgp_fft( nb_fields * grid.size() );
+    std::vector<double> rgp_dft( nb_fields * grid.size() );
+
+    double time_fft = 0.;
+    double time_dft = 0.;
+    for ( long i = 0; i < iterations; ++i ) {
+        {
+            Trace timer( Here(), "invtrans fft" );
+            trans_fft.invtrans( nb_fields, rspec.data(), rgp_fft.data() );
+            timer.stop();
+            time_fft += timer.elapsed();
+        }
+        {
+            Trace timer( Here(), "invtrans pointwise" );
+            trans_dft.invtrans( nb_fields, rspec.data(), rgp_dft.data() );
+            timer.stop();
+            time_dft += timer.elapsed();
+        }
+    }
+
+    double maxdiff = 0.;
+    for ( size_t j = 0; j < rgp_fft.size(); ++j ) {
+        maxdiff = std::max( maxdiff, std::abs( rgp_fft[j] - rgp_dft[j] ) );
+    }
+
+    Log::info() << "grid: " << grid.name() << "  truncation: " << truncation << "  fields: " << nb_fields
+                << "  iterations: " << iterations << std::endl;
+    Log::info() << "  invtrans fft       : " << std::setprecision( 5 ) << time_fft / iterations << " s" << std::endl;
+    Log::info() << "  invtrans pointwise : " << std::setprecision( 5 ) << time_dft / iterations << " s" << std::endl;
+    Log::info() << "  speedup            : " << time_dft / time_fft << std::endl;
+    Log::info() << "  max difference     : " << maxdiff << std::endl;
+    Log::info() << Trace::report() << std::endl;
+}
+
+//------------------------------------------------------------------------------
+
+int main( int argc, char** argv ) {
+    Tool tool( argc, argv );
+    return tool.start();
+}
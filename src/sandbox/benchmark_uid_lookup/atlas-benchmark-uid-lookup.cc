@@ -0,0 +1,178 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+
+#include "atlas/grid.h"
+#include "atlas/mesh.h"
+#include "atlas/meshgenerator.h"
+#include "atlas/runtime/AtlasTool.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/Config.h"
+#include "atlas/util/Unique.h"
+#include "atlas/util/detail/FlatHashMap.h"
+
+//------------------------------------------------------------------------------
+
+using namespace atlas;
+using namespace atlas::grid;
+using atlas::util::Config;
+
+//------------------------------------------------------------------------------
+
+class Tool : public AtlasTool {
+    virtual void execute( const Args& args );
+    virtual std::string briefDescription() {
+        return "Tool to compare std::map/std::set with flat hash/sorted containers for the uid lookups "
+               "done in BuildHalo and BuildParallelFields";
+    }
+    virtual std::string usage() { return name() + " --grid=name [OPTION]... [--help]"; }
+
+public:
+    Tool( int argc, char** argv );
+};
+
+//-----------------------------------------------------------------------------
+
+Tool::Tool( int argc, char** argv ) : AtlasTool( argc, argv ) {
+    add_option( new SimpleOption<std::string>(
+        "grid", "Grid unique identifier\n" + indent() + "     Example values: N80, F40, O24, L32" ) );
+    add_option( new SimpleOption<long>( "iterations", "Number of iterations, mimicking halo levels (default=3)" ) );
+}
+
+//-----------------------------------------------------------------------------
+
+void Tool::execute( const Args& args ) {
+    std::string key;
+    args.get( "grid", key );
+
+    StructuredGrid grid;
+    if ( key.size() ) {
+        try {
+            grid = Grid( key );
+        }
+        catch ( eckit::BadParameter& e ) {
+        }
+    }
+    else {
+        Log::error() << "No grid specified." << std::endl;
+    }
+
+    if ( !grid ) return;
+
+    long iterations = args.getLong( "iterations", 3 );
+
+    Mesh mesh = MeshGenerator( "structured" ).generate( grid );
+
+    const mesh::HybridElements::Connectivity& elem_nodes = mesh.cells().node_connectivity();
+
+    const size_t nb_nodes = mesh.nodes().size();
+    const size_t nb_elems = mesh.cells().size();
+
+    util::UniqueLonLat compute_uid( mesh );
+    std::vector<uidx_t> node_uid( nb_nodes );
+    for ( size_t jnode = 0; jnode < nb_nodes; ++jnode ) {
+        node_uid[jnode] = compute_uid( jnode );
+    }
+    std::vector<uidx_t> elem_node_uid;
+    elem_node_uid.reserve( 4 * nb_elems );
+    for ( size_t jelem = 0; jelem < nb_elems; ++jelem ) {
+        for ( size_t n = 0; n < elem_nodes.cols( jelem ); ++n ) {
+            elem_node_uid.push_back( node_uid[elem_nodes( jelem, n )] );
+        }
+    }
+
+    double time_map      = 0.;
+    double time_flat_map = 0.;
+    double time_set      = 0.;
+    double time_sorted   = 0.;
+    long checksum_map    = 0;
+    long checksum_flat   = 0;
+    size_t unique_set    = 0;
+    size_t unique_sorted = 0;
+
+    // Storage reused across iterations, as uid2node is across halo levels
+    util::FlatHashMap<uidx_t, int> flat_map;
+    std::vector<uidx_t> sorted;
+
+    for ( long i = 0; i < iterations; ++i ) {
+        {
+            Trace timer( Here(), "std::map build+lookup" );
+            std::map<uidx_t, int> map;
+            for ( size_t jnode = 0; jnode < nb_nodes; ++jnode ) {
+                map.insert( std::make_pair( node_uid[jnode], jnode ) );
+            }
+            for ( size_t j = 0; j < elem_node_uid.size(); ++j ) {
+                checksum_map += map.find( elem_node_uid[j] )->second;
+            }
+            timer.stop();
+            time_map += timer.elapsed();
+        }
+        {
+            Trace timer( Here(), "FlatHashMap build+lookup" );
+            flat_map.clear();
+            flat_map.reserve( nb_nodes );
+            for ( size_t jnode = 0; jnode < nb_nodes; ++jnode ) {
+                flat_map.insert( node_uid[jnode], jnode );
+            }
+            for ( size_t j = 0; j < elem_node_uid.size(); ++j ) {
+                checksum_flat += *flat_map.find( elem_node_uid[j] );
+            }
+            timer.stop();
+            time_flat_map += timer.elapsed();
+        }
+        {
+            Trace timer( Here(), "std::set accumulate" );
+            std::set<uidx_t> set( elem_node_uid.begin(), elem_node_uid.end() );
+            unique_set = set.size();
+            timer.stop();
+            time_set += timer.elapsed();
+        }
+        {
+            Trace timer( Here(), "sort+unique accumulate" );
+            sorted.assign( elem_node_uid.begin(), elem_node_uid.end() );
+            std::sort( sorted.begin(), sorted.end() );
+            sorted.erase( std::unique( sorted.begin(), sorted.end() ), sorted.end() );
+            unique_sorted = sorted.size();
+            timer.stop();
+            time_sorted += timer.elapsed();
+        }
+    }
+
+    if ( checksum_map != checksum_flat || unique_set != unique_sorted ) {
+        throw eckit::SeriousBug( "FlatHashMap or sorted vector results differ from std::map/std::set", Here() );
+    }
+
+    Log::info() << "grid: " << grid.name() << "  nodes: " << nb_nodes << "  element-node lookups: "
+                << elem_node_uid.size() << "  iterations: " << iterations << std::endl;
+    Log::info() << "  std::map     : " << std::setprecision( 5 ) << time_map / iterations << " s" << std::endl;
+    Log::info() << "  FlatHashMap  : " << std::setprecision( 5 ) << time_flat_map / iterations << " s" << std::endl;
+    Log::info() << "  speedup      : " << time_map / time_flat_map << std::endl;
+    Log::info() << "  std::set     : " << std::setprecision( 5 ) << time_set / iterations << " s" << std::endl;
+    Log::info() << "  sort+unique  : " << std::setprecision( 5 ) << time_sorted / iterations << " s" << std::endl;
+    Log::info() << "  speedup      : " << time_set / time_sorted << std::endl;
+    Log::info() << Trace::report() << std::endl;
+}
+
+//------------------------------------------------------------------------------
+
+int main( int argc, char** argv ) {
+    Tool tool( argc, argv );
+    return tool.start();
+}
@@ -15,6 +15,10 @@
 #include "atlas/library/config.h"
 #include "tests/AtlasTestEnvironment.h"
 
+#if !ATLAS_HAVE_GRIDTOOLS_STORAGE
+#include "atlas/array/native/NativeAllocator.h"
+#endif
+
 #ifdef ATLAS_HAVE_GRIDTOOLS_STORAGE
 #if ATLAS_GRIDTOOLS_STORAGE_BACKEND_CUDA
 #define PADDED 1
@@ -568,6 +572,57 @@ CASE( "test_wrap" ) {
     EXPECT( view( 2 ) == 19 );
 }
 
+#if !ATLAS_HAVE_GRIDTOOLS_STORAGE
+CASE( "test_allocation" ) {
+    SECTION( "default allocation is aligned and zero-initialised" ) {
+        Array* ds = Array::create<double>( 1000 );
+        EXPECT( reinterpret_cast<size_t>( ds->storage() ) % 64 == 0 );
+        auto view = make_view<double, 1>( *ds );
+        for ( size_t j = 0; j < view.size(); ++j ) {
+            EXPECT( view( j ) == 0. );
+        }
+        delete ds;
+    }
+
+    SECTION( "allocation from spec is kept on resize" ) {
+        ArrayAllocation allocation;
+        allocation.alignment( 256 ).first_touch( true );
+        Array* ds = Array::create( DataType::create<float>(), ArraySpec( ArrayShape{10, 3}, allocation ) );
+        EXPECT( ds->spec().allocation().alignment() == 256 );
+        EXPECT( reinterpret_cast<size_t>( ds->storage() ) % 256 == 0 );
+        make_view<float, 2>( *ds )( 9, 2 ) = 5.f;
+        ds->resize( 20, 3 );
+        EXPECT( ds->spec().allocation().alignment() == 256 );
+        EXPECT( ds->spec().allocation().first_touch() );
+        EXPECT( reinterpret_cast<size_t>( ds->storage() ) % 256 == 0 );
+        EXPECT( make_view<float, 2>( *ds )( 9, 2 ) == 5.f );
+        EXPECT( make_view<float, 2>( *ds )( 19, 2 ) == 0.f );
+        delete ds;
+    }
+
+    SECTION( "pooled storage is recycled" ) {
+        native::release_pool();
+        ArrayAllocation allocation;
+        allocation.pool( true );
+        Array* ds1 = Array::create( DataType::create<double>(), ArraySpec( ArrayShape{100}, allocation ) );
+        void* storage = ds1->storage();
+        make_view<double, 1>( *ds1 )( 0 ) = 1.;
+        delete ds1;
+        EXPECT( native::pool_footprint() == 100 * sizeof( double ) );
+
+        Array* ds2 = Array::create( DataType::create<double>(), ArraySpec( ArrayShape{100}, allocation ) );
+        EXPECT( ds2->storage() == storage );
+        EXPECT( make_view<double, 1>( *ds2 )( 0 ) == 0. );
+        EXPECT( native::pool_footprint() == 0 );
+        delete ds2;
+        native::release_pool();
+        EXPECT( native::pool_footprint() == 0 );
+    }
+
+    SECTION( "invalid alignment" ) { EXPECT_THROWS_AS( ArrayAllocation().alignment( 48 ), eckit::BadParameter ); }
+}
+#endif
+
 CASE( "test_acc_map" ) {
     Array* ds = Array::create<double>( 2, 3, 4 );
     if( ATLAS_HAVE_ACC ) {
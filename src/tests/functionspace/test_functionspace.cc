@@ -8,6 +8,10 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
+#include <utility>
+
+#include "eckit/exception/Exceptions.h"
 #include "eckit/memory/ScopedPtr.h"
 #include "eckit/types/Types.h"
 
@@ -55,6 +59,179 @@ CASE( "test_functionspace_NodeColumns_no_halo" ) {
     }
 }
 
+CASE( "test_functionspace_NodeColumns_haloExchangeStart" ) {
+    Grid grid( "O16" );
+    Mesh mesh = meshgenerator::StructuredMeshGenerator().generate( grid );
+    functionspace::NodeColumns nodes_fs( mesh, option::halo( 1 ) | option::levels( 2 ) );
+
+    FieldSet fields;
+    fields.add( nodes_fs.createField<double>( option::name( "overlapped" ) ) );
+    fields.add( nodes_fs.createField<int>( option::name( "overlapped_vector" ) | option::variables( 2 ) ) );
+    Field reference = nodes_fs.createField<double>( option::name( "reference" ) );
+    Field work      = nodes_fs.createField<double>( option::name( "work" ) );
+
+    auto overlapped        = array::make_view<double, 2>( fields[0] );
+    auto overlapped_vector = array::make_view<int, 3>( fields[1] );
+    auto reference_view    = array::make_view<double, 2>( reference );
+    auto work_view         = array::make_view<double, 2>( work );
+    auto ghost             = array::make_view<int, 1>( mesh.nodes().ghost() );
+    auto gidx              = array::make_view<gidx_t, 1>( mesh.nodes().global_index() );
+    const size_t nb_nodes  = nodes_fs.nb_nodes();
+    for ( size_t j = 0; j < nb_nodes; ++j ) {
+        for ( size_t jlev = 0; jlev < 2; ++jlev ) {
+            const double value        = ghost( j ) ? -1. : gidx( j ) + 0.5 * jlev;
+            overlapped( j, jlev )     = value;
+            reference_view( j, jlev ) = value;
+            for ( size_t jvar = 0; jvar < 2; ++jvar ) {
+                overlapped_vector( j, jlev, jvar ) = ghost( j ) ? -1 : gidx( j ) * ( 1 + jvar );
+            }
+        }
+    }
+    nodes_fs.haloExchange( reference );
+
+    parallel::HaloExchange::Handle handle = nodes_fs.haloExchangeStart( fields );
+    EXPECT( handle.active() );
+
+    // Interior work on owned values while the halo is exchanged
+    for ( size_t j = 0; j < nb_nodes; ++j ) {
+        if ( ghost( j ) ) continue;
+        for ( size_t jlev = 0; jlev < 2; ++jlev ) {
+            work_view( j, jlev ) = 2. * overlapped( j, jlev );
+        }
+    }
+
+    nodes_fs.haloExchangeWait( handle );
+    EXPECT( not handle.active() );
+
+    for ( size_t j = 0; j < nb_nodes; ++j ) {
+        for ( size_t jlev = 0; jlev < 2; ++jlev ) {
+            EXPECT( overlapped( j, jlev ) == reference_view( j, jlev ) );
+            EXPECT( overlapped( j, jlev ) != -1. );
+            EXPECT( overlapped_vector( j, jlev, 0 ) * 2 == overlapped_vector( j, jlev, 1 ) );
+            if ( not ghost( j ) ) { EXPECT( work_view( j, jlev ) == 2. * overlapped( j, jlev ) ); }
+        }
+    }
+
+    // An active handle cannot be overwritten, and completes the communication when destroyed without wait
+    {
+        parallel::HaloExchange::Handle active    = nodes_fs.haloExchangeStart( fields );
+        parallel::HaloExchange::Handle abandoned = nodes_fs.haloExchangeStart( fields );
+        EXPECT_THROWS_AS( active = std::move( abandoned ), eckit::AssertionFailed );
+        nodes_fs.haloExchangeWait( active );
+    }
+    nodes_fs.haloExchange( fields );
+    for ( size_t j = 0; j < nb_nodes; ++j ) {
+        for ( size_t jlev = 0; jlev < 2; ++jlev ) {
+            EXPECT( overlapped( j, jlev ) == reference_view( j, jlev ) );
+        }
+    }
+}
+
+/// Check chunked gather and scatter of a field against the unchunked gather, with the field
+/// addressed as ( nodes, levels, variables ), where levels or variables may be absent
+void check_chunked_gather_scatter( const functionspace::NodeColumns& fs, const Field& field, size_t levels_per_chunk,
+                                   size_t expected_chunks ) {
+    const size_t root  = 0;
+    const size_t nlev  = std::max<size_t>( field.levels(), 1 );
+    const size_t nvar  = std::max<size_t>( field.variables(), 1 );
+    const bool on_root = mpi::comm().rank() == root;
+
+    Field field_glb = fs.createField( field, option::name( field.name() + "_global" ) | option::global( root ) );
+    fs.gather( field, field_glb );
+    const double* glb = field_glb.data<double>();
+
+    size_t nb_chunks = 0;
+    size_t nb_levels = 0;
+    fs.gather( field,
+               [&]( Field& chunk, size_t begin, size_t end ) {
+                   EXPECT( chunk.shape( 0 ) == field_glb.shape( 0 ) );
+                   EXPECT( chunk.size() == field_glb.shape( 0 ) * ( end - begin ) * nvar );
+                   const double* c = chunk.data<double>();
+                   for ( size_t n = 0; n < chunk.shape( 0 ); ++n ) {
+                       for ( size_t k = begin; k < end; ++k ) {
+                           for ( size_t v = 0; v < nvar; ++v ) {
+                               EXPECT( c[( n * ( end - begin ) + k - begin ) * nvar + v] ==
+                                       glb[( n * nlev + k ) * nvar + v] );
+                           }
+                       }
+                   }
+                   ++nb_chunks;
+                   nb_levels += end - begin;
+               },
+               levels_per_chunk, root );
+    EXPECT( nb_chunks == ( on_root ? expected_chunks : 0 ) );
+    EXPECT( nb_levels == ( on_root ? nlev : 0 ) );
+
+    Field scattered = fs.createField( field, option::name( field.name() + "_scattered" ) );
+    fs.scatter(
+        [&]( Field& chunk, size_t begin, size_t end ) {
+            double* c = chunk.data<double>();
+            for ( size_t n = 0; n < chunk.shape( 0 ); ++n ) {
+                for ( size_t k = begin; k < end; ++k ) {
+                    for ( size_t v = 0; v < nvar; ++v ) {
+                        c[( n * ( end - begin ) + k - begin ) * nvar + v] = glb[( n * nlev + k ) * nvar + v];
+                    }
+                }
+            }
+        },
+        scattered, levels_per_chunk, root );
+
+    auto ghost              = array::make_view<int, 1>( fs.nodes().ghost() );
+    const double* original  = field.data<double>();
+    const double* recovered = scattered.data<double>();
+    for ( size_t n = 0; n < fs.nb_nodes(); ++n ) {
+        if ( ghost( n ) ) continue;
+        for ( size_t j = 0; j < nlev * nvar; ++j ) {
+            EXPECT( recovered[n * nlev * nvar + j] == original[n * nlev * nvar + j] );
+        }
+    }
+}
+
+CASE( "test_functionspace_NodeColumns_chunked_gather_scatter" ) {
+    Grid grid( "O8" );
+    Mesh mesh = meshgenerator::StructuredMeshGenerator().generate( grid );
+    functionspace::NodeColumns fs( mesh );
+
+    auto gidx = array::make_view<gidx_t, 1>( mesh.nodes().global_index() );
+
+    SECTION( "levels and variables" ) {
+        Field field = fs.createField<double>( option::name( "field" ) | option::levels( 5 ) | option::variables( 2 ) );
+        auto v      = array::make_view<double, 3>( field );
+        for ( size_t n = 0; n < fs.nb_nodes(); ++n ) {
+            for ( size_t k = 0; k < 5; ++k ) {
+                for ( size_t j = 0; j < 2; ++j ) {
+                    v( n, k, j ) = 100. * gidx( n ) + 10. * k + j;
+                }
+            }
+        }
+        check_chunked_gather_scatter( fs, field, 2, 3 );
+    }
+
+    SECTION( "levels" ) {
+        Field field = fs.createField<double>( option::name( "field" ) | option::levels( 5 ) );
+        auto v      = array::make_view<double, 2>( field );
+        for ( size_t n = 0; n < fs.nb_nodes(); ++n ) {
+            for ( size_t k = 0; k < 5; ++k ) {
+                v( n, k ) = 100. * gidx( n ) + 10. * k;
+            }
+        }
+        check_chunked_gather_scatter( fs, field, 5, 1 );
+    }
+
+    SECTION( "variables without levels" ) {
+        Field field =
+            fs.createField<double>( option::name( "field" ) | option::levels( false ) | option::variables( 3 ) );
+        EXPECT( field.rank() == 2 );
+        auto v = array::make_view<double, 2>( field );
+        for ( size_t n = 0; n < fs.nb_nodes(); ++n ) {
+            for ( size_t j = 0; j < 3; ++j ) {
+                v( n, j ) = 100. * gidx( n ) + j;
+            }
+        }
+        check_chunked_gather_scatter( fs, field, 2, 1 );
+    }
+}
+
 CASE( "test_functionspace_NodeColumns" ) {
     // ScopedPtr<grid::Grid> grid( Grid::create("O2") );
 
@@ -227,10 +404,13 @@ CASE( "test_functionspace_NodeColumns" ) {
         fs.orderIndependentSum( field, sum, N );
         Log::info() << "oisum: " << sum << std::endl;
         Log::info() << "oiN: " << N << std::endl;
+        const double oisum = sum;
 
         fs.sum( field, sum, N );
         Log::info() << "sum: " << sum << std::endl;
         Log::info() << "N: " << N << std::endl;
+        // values are integers, so also the plain sum is exact
+        EXPECT( oisum == sum );
 
         fs.mean( field, mean, N );
         Log::info() << "mean: " << mean << std::endl;
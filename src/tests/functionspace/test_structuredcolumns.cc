@@ -90,6 +90,74 @@ CASE( "test_functionspace_StructuredColumns_no_halo" ) {
     gmsh.write( field );
 }
 
+CASE( "test_functionspace_StructuredColumns_chunked_gather_scatter" ) {
+    int root    = 0;
+    size_t nlev = 5;
+    Grid grid( "O8" );
+    functionspace::StructuredColumns fs( grid, grid::Partitioner( "equal_regions" ) );
+
+    Field field = fs.createField<double>( option::name( "field" ) | option::levels( nlev ) );
+    Field field_glb =
+        fs.createField<double>( option::name( "field_global" ) | option::levels( nlev ) | option::global( root ) );
+
+    auto value = array::make_view<double, 2>( field );
+    auto g     = array::make_view<gidx_t, 1>( fs.global_index() );
+    for ( size_t n = 0; n < fs.size(); ++n ) {
+        for ( size_t k = 0; k < nlev; ++k ) {
+            value( n, k ) = 1000. * k + g( n );
+        }
+    }
+
+    fs.gather( field, field_glb );
+    auto value_glb = array::make_view<double, 2>( field_glb );
+
+    SECTION( "gather" ) {
+        size_t nb_chunks = 0;
+        size_t nb_levels = 0;
+        fs.gather( field,
+                   [&]( Field& chunk, size_t begin, size_t end ) {
+                       auto v = array::make_view<double, 2>( chunk );
+                       EXPECT( v.shape( 0 ) == value_glb.shape( 0 ) );
+                       EXPECT( v.shape( 1 ) == end - begin );
+                       for ( size_t n = 0; n < v.shape( 0 ); ++n ) {
+                           for ( size_t k = begin; k < end; ++k ) {
+                               EXPECT( v( n, k - begin ) == value_glb( n, k ) );
+                           }
+                       }
+                       ++nb_chunks;
+                       nb_levels += end - begin;
+                   },
+                   2, root );
+        if ( mpi::comm().rank() == root ) {
+            EXPECT( nb_chunks == 3 );
+            EXPECT( nb_levels == nlev );
+        }
+        else {
+            EXPECT( nb_chunks == 0 );
+        }
+    }
+
+    SECTION( "scatter" ) {
+        Field scattered = fs.createField<double>( option::name( "scattered" ) | option::levels( nlev ) );
+        fs.scatter(
+            [&]( Field& chunk, size_t begin, size_t end ) {
+                auto v = array::make_view<double, 2>( chunk );
+                for ( size_t n = 0; n < v.shape( 0 ); ++n ) {
+                    for ( size_t k = begin; k < end; ++k ) {
+                        v( n, k - begin ) = value_glb( n, k );
+                    }
+                }
+            },
+            scattered, 2, root );
+        auto s = array::make_view<double, 2>( scattered );
+        for ( size_t n = 0; n < fs.sizeOwned(); ++n ) {
+            for ( size_t k = 0; k < nlev; ++k ) {
+                EXPECT( s( n, k ) == value( n, k ) );
+            }
+        }
+    }
+}
+
 CASE( "test_functionspace_StructuredColumns_halo" ) {
     ATLAS_DEBUG_VAR( mpi::comm().size() );
     int root = 0;
@@ -17,7 +17,9 @@
 #include "eckit/types/FloatCompare.h"
 
 #include "atlas/grid.h"
+#include "atlas/grid/Distribution.h"
 #include "atlas/grid/Grid.h"
+#include "atlas/grid/Partitioner.h"
 #include "atlas/library/Library.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/util/Config.h"
@@ -137,6 +139,115 @@ CASE( "test_reducedgaussian" ) {
     EXPECT( N640.size() == custom.size() );
 }
 
+CASE( "test_compact_distribution" ) {
+    for ( std::string gridname : {"O32", "N24", "L36x19"} ) {
+        Grid grid( gridname );
+        for ( size_t nb_parts : {1, 5, 12, 48} ) {
+            grid::Partitioner partitioner( "equal_regions", nb_parts );
+            grid::Distribution dense( grid, partitioner );
+            grid::Distribution compact( grid, partitioner, util::Config( "compact", true ) );
+
+            EXPECT( not dense.compact() );
+            EXPECT( compact.compact() );
+            EXPECT( compact.size() == grid.size() );
+            EXPECT( compact.get()->nb_runs() < grid.size() / 2 );
+            EXPECT( compact.nb_partitions() == nb_parts );
+            EXPECT( compact.nb_pts() == dense.nb_pts() );
+            EXPECT( compact.max_pts() == dense.max_pts() );
+            EXPECT( compact.min_pts() == dense.min_pts() );
+
+            bool same = true;
+            for ( gidx_t gidx = 0; gidx < gidx_t( grid.size() ); ++gidx ) {
+                same = same && ( compact.partition( gidx ) == dense.partition( gidx ) );
+            }
+            EXPECT( same );
+
+            // Runs of a partition, and partitions of a range of global indices
+            for ( int part : {0, int( nb_parts ) - 1} ) {
+                auto runs = compact.runs( part );
+                EXPECT( runs == dense.runs( part ) );
+                size_t nb_pts = 0;
+                for ( const auto& run : runs ) {
+                    nb_pts += run.second - run.first;
+                    same = same && compact.partition( run.first ) == part &&
+                           compact.partition( run.second - 1 ) == part;
+                }
+                EXPECT( same );
+                EXPECT( nb_pts == size_t( dense.nb_pts()[part] ) );
+            }
+            const gidx_t begin = grid.size() / 3;
+            const gidx_t end   = 2 * grid.size() / 3;
+            std::vector<int> range( end - begin );
+            compact.partition( begin, end, range.data() );
+            EXPECT( range == std::vector<int>( dense.partition().begin() + begin, dense.partition().begin() + end ) );
+
+            // Expanding is still possible
+            EXPECT( compact.partition() == dense.partition() );
+        }
+    }
+}
+
+CASE( "test_fill_xy_lonlat" ) {
+    util::Config projection( "type", "rotated_lonlat" );
+    projection.set( "north_pole", std::vector<double>{-176., 40.} );
+    util::Config rotated( "name", "O32" );
+    rotated.set( "projection", projection );
+
+    std::vector<Grid> grids{Grid( "O32" ), Grid( "L36x19" ), Grid( rotated ),
+                            grid::UnstructuredGrid( {{0., 10.}, {20., -30.}, {340., 89.}, {120., -89.}} )};
+    for ( Grid grid : grids ) {
+        const size_t size = grid.size();
+        std::vector<double> xy( 2 * size );
+        std::vector<double> lonlat( 2 * size );
+        grid.fill_xy( xy.data() );
+        grid.fill_lonlat( lonlat.data() );
+
+        bool same = true;
+        size_t n  = 0;
+        for ( PointXY p : grid.xy() ) {
+            same = same && xy[2 * n] == p.x() && xy[2 * n + 1] == p.y();
+            ++n;
+        }
+        EXPECT( n == size );
+        n = 0;
+        for ( PointLonLat p : grid.lonlat() ) {
+            same = same && lonlat[2 * n] == p.lon() && lonlat[2 * n + 1] == p.lat();
+            ++n;
+        }
+        EXPECT( same );
+
+        // Sub-ranges, also starting and ending in the middle of a row
+        for ( gidx_t begin : {gidx_t( 0 ), gidx_t( size / 3 ), gidx_t( size - 1 )} ) {
+            for ( gidx_t end : {begin, begin + 1, gidx_t( size )} ) {
+                std::vector<double> sub( 2 * ( end - begin ) );
+                grid.fill_xy( begin, end, sub.data() );
+                EXPECT( std::equal( sub.begin(), sub.end(), xy.begin() + 2 * begin ) );
+                grid.fill_lonlat( begin, end, sub.data() );
+                EXPECT( std::equal( sub.begin(), sub.end(), lonlat.begin() + 2 * begin ) );
+            }
+        }
+
+        StructuredGrid structured( grid );
+        if ( structured ) {
+            const size_t j_begin = structured.ny() / 4;
+            const size_t j_end   = structured.ny() / 2;
+            gidx_t begin         = 0;
+            for ( size_t j = 0; j < j_begin; ++j ) {
+                begin += structured.nx( j );
+            }
+            gidx_t end = begin;
+            for ( size_t j = j_begin; j < j_end; ++j ) {
+                end += structured.nx( j );
+            }
+            std::vector<double> rows( 2 * ( end - begin ) );
+            structured.fill_xy_rows( j_begin, j_end, rows.data() );
+            EXPECT( std::equal( rows.begin(), rows.end(), xy.begin() + 2 * begin ) );
+            structured.fill_lonlat_rows( j_begin, j_end, rows.data() );
+            EXPECT( std::equal( rows.begin(), rows.end(), lonlat.begin() + 2 * begin ) );
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
@@ -13,6 +13,7 @@
 #include "eckit/types/FloatCompare.h"
 
 #include "atlas/library/Library.h"
+#include "atlas/projection/Projection.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/util/Config.h"
 #include "atlas/util/Constants.h"
@@ -219,6 +220,77 @@ CASE( "test_rotation_angle_only" ) {
     EXPECT_EQUIVALENT( rotation.unrotate( r ), p );
 }
 
+CASE( "test_batch_projections" ) {
+    std::vector<Config> configs;
+    configs.push_back( Config( "type", "lonlat" ) );
+    configs.push_back( Config( "type", "rotated_lonlat" ) );
+    configs.back().set( "north_pole", std::vector<double>{-176, 40} );
+    configs.push_back( Config( "type", "rotated_lonlat" ) );
+    configs.back().set( "rotation_angle", -180. );
+    configs.push_back( Config( "type", "rotated_schmidt" ) );
+    configs.back().set( "stretching_factor", 2.4 );
+    configs.back().set( "north_pole", std::vector<double>{2., 46.7} );
+    configs.push_back( Config( "type", "rotated_mercator" ) );
+    configs.back().set( "north_pole", std::vector<double>{-176, 40} );
+    configs.push_back( Config( "type", "lambert" ) );
+    configs.back().set( "latitude1", 56.3 );
+    configs.back().set( "longitude0", 0. );
+
+    std::vector<double> lon, lat;
+    for ( double y = -80.; y <= 80.; y += 10. ) {
+        for ( double x = -180.; x < 360.; x += 15. ) {
+            lon.push_back( x );
+            lat.push_back( y );
+        }
+    }
+    const size_t n = lon.size();
+
+    for ( const Config& config : configs ) {
+        Projection projection( config );
+        Log::info() << projection.type() << std::endl;
+
+        // Reference, point by point
+        std::vector<double> x( n ), y( n ), lon_ref( n ), lat_ref( n );
+        for ( size_t i = 0; i < n; ++i ) {
+            double crd[] = {lon[i], lat[i]};
+            projection.lonlat2xy( crd );
+            x[i] = crd[0];
+            y[i] = crd[1];
+            projection.xy2lonlat( crd );
+            lon_ref[i] = crd[0];
+            lat_ref[i] = crd[1];
+        }
+
+        // Separate arrays
+        std::vector<double> bx( n ), by( n ), blon( n ), blat( n );
+        projection.lonlat2xy( n, lon.data(), lat.data(), bx.data(), by.data() );
+        projection.xy2lonlat( n, bx.data(), by.data(), blon.data(), blat.data() );
+
+        // Interleaved, in place
+        std::vector<double> crd( 2 * n );
+        for ( size_t i = 0; i < n; ++i ) {
+            crd[2 * i + 0] = lon[i];
+            crd[2 * i + 1] = lat[i];
+        }
+        projection.lonlat2xy( n, crd.data(), crd.data() );
+        bool same = true;
+        for ( size_t i = 0; i < n; ++i ) {
+            same = same && eckit::types::is_approximately_equal( bx[i], x[i], eps() ) &&
+                   eckit::types::is_approximately_equal( by[i], y[i], eps() ) &&
+                   eckit::types::is_approximately_equal( crd[2 * i + 0], x[i], eps() ) &&
+                   eckit::types::is_approximately_equal( crd[2 * i + 1], y[i], eps() );
+        }
+        projection.xy2lonlat( n, crd.data(), crd.data() );
+        for ( size_t i = 0; i < n; ++i ) {
+            same = same && eckit::types::is_approximately_equal( blon[i], lon_ref[i], eps() ) &&
+                   eckit::types::is_approximately_equal( blat[i], lat_ref[i], eps() ) &&
+                   eckit::types::is_approximately_equal( crd[2 * i + 0], lon_ref[i], eps() ) &&
+                   eckit::types::is_approximately_equal( crd[2 * i + 1], lat_ref[i], eps() );
+        }
+        EXPECT( same );
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
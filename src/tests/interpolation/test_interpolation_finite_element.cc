@@ -8,7 +8,10 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <string>
 
 #include "eckit/types/FloatCompare.h"
 
@@ -17,8 +20,11 @@
 #include "atlas/functionspace.h"
 #include "atlas/grid.h"
 #include "atlas/interpolation.h"
+#include "atlas/interpolation/method/MatrixCache.h"
 #include "atlas/mesh.h"
 #include "atlas/meshgenerator.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/trace/StopWatch.h"
 #include "atlas/util/CoordinateEnums.h"
 
 #include "tests/AtlasTestEnvironment.h"
@@ -77,6 +83,175 @@ CASE( "test_interpolation_finite_element" ) {
     }
 }
 
+CASE( "test_interpolation_finite_element_multi_level" ) {
+    Grid grid( "O64" );
+    MeshGenerator meshgen( "structured" );
+    Mesh mesh = meshgen.generate( grid );
+    NodeColumns fs( mesh );
+
+    PointCloud pointcloud( {{00., 0.}, {10., 0.}, {20., 0.}, {30., 0.}, {40., 0.}} );
+
+    auto func = []( double x, size_t jlev, size_t jvar ) -> double {
+        return ( 1. + jlev + 10. * jvar ) * std::sin( x * M_PI / 180. );
+    };
+
+    Interpolation interpolation( Config( "type", "finite-element" ), fs, pointcloud );
+
+    const size_t nlev = 3;
+    const size_t nvar = 2;
+
+    // Fields of different datatype and shape, interpolated together
+    FieldSet source;
+    source.add( fs.createField<double>( option::name( "scalar" ) | option::levels( nlev ) ) );
+    source.add( fs.createField<float>( option::name( "vector" ) | option::levels( nlev ) | option::variables( nvar ) ) );
+
+    FieldSet target;
+    target.add( Field( "scalar", array::make_datatype<double>(), array::make_shape( pointcloud.size(), nlev ) ) );
+    target.add( Field( "vector", array::make_datatype<float>(), array::make_shape( pointcloud.size(), nlev, nvar ) ) );
+
+    auto lonlat        = array::make_view<double, 2>( fs.nodes().lonlat() );
+    auto source_scalar = array::make_view<double, 2>( source["scalar"] );
+    auto source_vector = array::make_view<float, 3>( source["vector"] );
+    for ( size_t j = 0; j < fs.nodes().size(); ++j ) {
+        for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
+            source_scalar( j, jlev ) = func( lonlat( j, LON ), jlev, 0 );
+            for ( size_t jvar = 0; jvar < nvar; ++jvar ) {
+                source_vector( j, jlev, jvar ) = func( lonlat( j, LON ), jlev, jvar );
+            }
+        }
+    }
+
+    interpolation.execute( source, target );
+
+    auto target_scalar = array::make_view<double, 2>( target["scalar"] );
+    auto target_vector = array::make_view<float, 3>( target["vector"] );
+    auto target_lonlat = array::make_view<double, 2>( pointcloud.lonlat() );
+    for ( size_t j = 0; j < pointcloud.size(); ++j ) {
+        for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
+            const double tolerance = 1.e-4 * ( 1. + jlev + 10. * nvar );
+            EXPECT( eckit::types::is_approximately_equal( target_scalar( j, jlev ),
+                                                          func( target_lonlat( j, LON ), jlev, 0 ), tolerance ) );
+            for ( size_t jvar = 0; jvar < nvar; ++jvar ) {
+                EXPECT( eckit::types::is_approximately_equal(
+                    double( target_vector( j, jlev, jvar ) ), func( target_lonlat( j, LON ), jlev, jvar ), tolerance ) );
+            }
+        }
+    }
+}
+
+CASE( "test_interpolation_finite_element_threads" ) {
+    using interpolation::MatrixCache;
+    using Matrix = MatrixCache::Matrix;
+
+    Grid grid( "O32" );
+    MeshGenerator meshgen( "structured" );
+    Mesh mesh = meshgen.generate( grid );
+    NodeColumns fs( mesh );
+
+    std::vector<PointXY> points;
+    for ( double lat = -88.; lat <= 88.; lat += 4. ) {
+        for ( double lon = 0.; lon < 360.; lon += 5. ) {
+            points.emplace_back( lon, lat );
+        }
+    }
+    PointCloud pointcloud( points );
+
+    // The matrix cache gives access to the computed matrix
+    const Config config = Config( "type", "finite-element" ) | Config( "matrix_cache", true );
+
+    auto compute_matrix = [&]( int nb_threads ) {
+        MatrixCache::clear();
+        atlas_omp_set_num_threads( nb_threads );
+        Interpolation interpolation( config, fs, pointcloud );
+        return MatrixCache( "finite-element", config, fs, pointcloud ).get();
+    };
+
+    const int max_threads                 = atlas_omp_get_max_threads();
+    std::shared_ptr<const Matrix> threads = compute_matrix( std::max( max_threads, 4 ) );
+    std::shared_ptr<const Matrix> serial  = compute_matrix( 1 );
+    atlas_omp_set_num_threads( max_threads );
+    MatrixCache::clear();
+
+    EXPECT( threads != nullptr );
+    EXPECT( serial != nullptr );
+    EXPECT( threads != serial );
+    EXPECT( threads->rows() == serial->rows() );
+    EXPECT( threads->cols() == serial->cols() );
+    EXPECT( threads->nonZeros() == serial->nonZeros() );
+    for ( size_t r = 0; r <= serial->rows(); ++r ) {
+        EXPECT( threads->outer()[r] == serial->outer()[r] );
+    }
+    for ( size_t n = 0; n < serial->nonZeros(); ++n ) {
+        EXPECT( threads->inner()[n] == serial->inner()[n] );
+        EXPECT( threads->data()[n] == serial->data()[n] );
+    }
+}
+
+CASE( "test_interpolation_matrix_cache_numeric_options" ) {
+    using interpolation::MatrixCache;
+
+    MeshGenerator meshgen( "structured" );
+    NodeColumns source( meshgen.generate( Grid( "O32" ) ) );
+    NodeColumns target( meshgen.generate( Grid( "O16" ) ) );
+
+    auto config = []( int k ) {
+        return Config( "type", "k-nearest-neighbours" ) | Config( "k-nearest-neighbours", k ) |
+               Config( "matrix_cache", true );
+    };
+
+    MatrixCache::clear();
+    Interpolation k4( config( 4 ), source, target );
+    EXPECT( MatrixCache::size() == 1 );
+    Interpolation k4_again( config( 4 ), source, target );
+    EXPECT( MatrixCache::size() == 1 );
+    Interpolation k2( config( 2 ), source, target );
+    EXPECT( MatrixCache::size() == 2 );
+
+    MatrixCache cache4( "k-nearest-neighbours", config( 4 ), source, target );
+    MatrixCache cache2( "k-nearest-neighbours", config( 2 ), source, target );
+    EXPECT( cache4.key() != cache2.key() );
+    EXPECT( cache4.get() != nullptr );
+    EXPECT( cache4.get()->nonZeros() == 4 * target.nodes().size() );
+    EXPECT( cache2.get()->nonZeros() == 2 * target.nodes().size() );
+    MatrixCache::clear();
+}
+
+CASE( "test_interpolation_threads_scaling" ) {
+    const int max_threads = atlas_omp_get_max_threads();
+    if ( max_threads < 2 ) {
+        Log::warning() << "Skipping thread scaling check, only one thread is available" << std::endl;
+        return;
+    }
+
+    MeshGenerator meshgen( "structured" );
+    NodeColumns source( meshgen.generate( Grid( "O64" ) ) );
+    NodeColumns target( meshgen.generate( Grid( "O320" ) ) );
+
+    // Best of a few runs, as the machine may be busy
+    auto setup_time = [&]( const std::string& type, int nb_threads ) {
+        atlas_omp_set_num_threads( nb_threads );
+        double best = std::numeric_limits<double>::max();
+        for ( int run = 0; run < 3; ++run ) {
+            runtime::trace::StopWatch watch;
+            watch.start();
+            Interpolation interpolation( Config( "type", type ), source, target );
+            watch.stop();
+            best = std::min( best, watch.elapsed() );
+        }
+        return best;
+    };
+
+    // Kd-tree searches are most of the setup of these methods; they must not be serialised
+    for ( std::string type : {"nearest-neighbour", "k-nearest-neighbours", "finite-element"} ) {
+        const double serial  = setup_time( type, 1 );
+        const double threads = setup_time( type, max_threads );
+        Log::info() << type << " setup: " << serial << " s with 1 thread, " << threads << " s with " << max_threads
+                    << " threads" << std::endl;
+        EXPECT( threads < serial );
+    }
+    atlas_omp_set_num_threads( max_threads );
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
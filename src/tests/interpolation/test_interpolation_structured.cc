@@ -0,0 +1,247 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <sys/stat.h>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "eckit/filesystem/PathName.h"
+#include "eckit/types/FloatCompare.h"
+
+#include "atlas/array.h"
+#include "atlas/functionspace/PointCloud.h"
+#include "atlas/functionspace/StructuredColumns.h"
+#include "atlas/grid.h"
+#include "atlas/interpolation.h"
+#include "atlas/interpolation/method/MatrixCache.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/util/CoordinateEnums.h"
+
+#include "tests/AtlasTestEnvironment.h"
+
+using namespace eckit;
+using namespace atlas::functionspace;
+using namespace atlas::util;
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+// Smooth on the sphere, including at the poles
+double func( double lon, double lat, size_t jlev = 0 ) {
+    const double d = M_PI / 180.;
+    return ( 1. + jlev ) * ( std::cos( lat * d ) * std::cos( lon * d ) + 0.5 * std::sin( lat * d ) +
+                             0.3 * std::cos( lat * d ) * std::cos( lat * d ) * std::sin( 2. * lon * d ) );
+}
+
+Field source_field( const StructuredColumns& fs, size_t nlev ) {
+    Field field = fs.createField<double>( option::name( "source" ) | option::levels( nlev ) );
+    auto xy     = array::make_view<double, 2>( fs.xy() );
+    auto source = array::make_view<double, 2>( field );
+    for ( size_t n = 0; n < fs.sizeOwned(); ++n ) {
+        for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
+            source( n, jlev ) = func( xy( n, XX ), xy( n, YY ), jlev );
+        }
+    }
+    fs.haloExchange( field );
+    return field;
+}
+
+/// @return true if the grid point nearest to (lon,lat) is owned by this MPI task,
+/// so that every point is interpolated by exactly one task
+bool owned( const StructuredColumns& fs, double lon, double lat ) {
+    const grid::StructuredGrid& grid = fs.grid();
+    idx_t j                          = 0;
+    for ( idx_t jj = 1; jj < idx_t( grid.ny() ); ++jj ) {
+        if ( std::abs( grid.y( jj ) - lat ) < std::abs( grid.y( j ) - lat ) ) { j = jj; }
+    }
+    if ( j < fs.j_begin() || j >= fs.j_end() ) { return false; }
+    const idx_t nx = idx_t( grid.nx( j ) );
+    idx_t i        = idx_t( std::round( ( lon - grid.x( 0, j ) ) * nx / 360. ) ) % nx;
+    if ( i < 0 ) { i += nx; }
+    return i >= fs.i_begin( j ) && i < fs.i_end( j );
+}
+
+PointCloud target_points( const StructuredColumns& fs ) {
+    const std::vector<PointXY> points{{0., 0.},      {10., 10.},     {-25., 45.}, {359.5, -30.}, {400., 60.},
+                                      {123.4, 88.5}, {271.8, -89.2}, {45., 90.},  {300., -90.}};
+    std::vector<PointXY> local;
+    for ( const PointXY& p : points ) {
+        if ( owned( fs, p.x(), p.y() ) ) { local.push_back( p ); }
+    }
+    int nb_points = int( local.size() );
+    mpi::comm().allReduceInPlace( nb_points, eckit::mpi::sum() );
+    EXPECT( size_t( nb_points ) == points.size() );
+    return PointCloud( local );
+}
+
+void check( const std::string& type, double tolerance ) {
+    const size_t nlev = 3;
+
+    StructuredColumns fs( Grid( "O32" ), option::halo( 2 ) );
+    PointCloud pointcloud = target_points( fs );
+
+    Interpolation interpolation( Config( "type", type ), fs, pointcloud );
+
+    Field field_source = source_field( fs, nlev );
+    Field field_target( "target", array::make_datatype<double>(), array::make_shape( pointcloud.size(), nlev ) );
+
+    interpolation.execute( field_source, field_target );
+
+    auto target = array::make_view<double, 2>( field_target );
+    auto lonlat = array::make_view<double, 2>( pointcloud.lonlat() );
+    for ( size_t j = 0; j < pointcloud.size(); ++j ) {
+        for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
+            const double exact = func( lonlat( j, LON ), lonlat( j, LAT ), jlev );
+            Log::debug() << type << "  " << target( j, jlev ) << "  " << exact << std::endl;
+            EXPECT( eckit::types::is_approximately_equal( target( j, jlev ), exact, ( 1. + jlev ) * tolerance ) );
+        }
+    }
+}
+
+CASE( "test_interpolation_structured_bilinear" ) {
+    check( "structured-bilinear", 2.e-3 );
+}
+
+CASE( "test_interpolation_structured_bicubic" ) {
+    check( "structured-bicubic", 2.e-5 );
+}
+
+CASE( "test_interpolation_structured_to_structured" ) {
+    // Interpolating to the source grid itself reproduces the source values
+    StructuredColumns fs( Grid( "O32" ), option::halo( 2 ) );
+    Interpolation interpolation( Config( "type", "structured-bicubic" ), fs, fs );
+
+    Field field_source = source_field( fs, 1 );
+    Field field_target = fs.createField<double>( option::name( "target" ) | option::levels( 1 ) );
+
+    interpolation.execute( field_source, field_target );
+
+    auto source = array::make_view<double, 2>( field_source );
+    auto target = array::make_view<double, 2>( field_target );
+    for ( size_t n = 0; n < fs.sizeOwned(); ++n ) {
+        EXPECT( eckit::types::is_approximately_equal( target( n, 0 ), source( n, 0 ), 1.e-12 ) );
+    }
+}
+
+// Identifies the contents of a file: a rewritten cache file is a new file, renamed over the old one
+using FileIdentity = std::pair<ino_t, time_t>;
+
+FileIdentity file_identity( const PathName& path ) {
+    struct stat s;
+    if ( ::stat( path.localPath(), &s ) != 0 ) { return FileIdentity( 0, 0 ); }
+    return FileIdentity( s.st_ino, s.st_mtime );
+}
+
+CASE( "test_interpolation_matrix_cache" ) {
+    using interpolation::MatrixCache;
+
+    const size_t nlev           = 2;
+    const std::string directory = "test_interpolation_matrix_cache";
+
+    StructuredColumns fs( Grid( "O32" ), option::halo( 2 ) );
+    PointCloud pointcloud = target_points( fs );
+    Field field_source    = source_field( fs, nlev );
+
+    Config config = Config( "type", "structured-bilinear" ) | Config( "matrix_cache_directory", directory );
+
+    auto interpolate = [&]() {
+        Interpolation interpolation( config, fs, pointcloud );
+        Field field_target( "target", array::make_datatype<double>(), array::make_shape( pointcloud.size(), nlev ) );
+        interpolation.execute( field_source, field_target );
+        return field_target;
+    };
+    auto equal = []( const Field& a, const Field& b ) {
+        auto va = array::make_view<double, 2>( a );
+        auto vb = array::make_view<double, 2>( b );
+        for ( size_t j = 0; j < va.shape( 0 ); ++j ) {
+            for ( size_t jlev = 0; jlev < va.shape( 1 ); ++jlev ) {
+                if ( va( j, jlev ) != vb( j, jlev ) ) { return false; }
+            }
+        }
+        return true;
+    };
+
+    Field reference;
+    {
+        Interpolation interpolation( Config( "type", "structured-bilinear" ), fs, pointcloud );
+        reference = Field( "reference", array::make_datatype<double>(), array::make_shape( pointcloud.size(), nlev ) );
+        interpolation.execute( field_source, reference );
+    }
+
+    MatrixCache::clear();
+    MatrixCache cache( "structured-bilinear", config, fs, pointcloud );
+    EXPECT( cache );
+    eckit::PathName file = MatrixCache::path( directory, "structured-bilinear", cache.key() );
+    if ( file.exists() ) { file.unlink(); }
+
+    SECTION( "computed" ) {
+        EXPECT( equal( interpolate(), reference ) );
+        EXPECT( MatrixCache::size() == 1 );
+        EXPECT( file.exists() );
+    }
+
+    SECTION( "from memory" ) {
+        interpolate();
+        auto matrix        = cache.get();
+        FileIdentity saved = file_identity( file );
+        EXPECT( matrix != nullptr );
+        EXPECT( equal( interpolate(), reference ) );
+        EXPECT( cache.get() == matrix );
+        EXPECT( file_identity( file ) == saved );
+        EXPECT( MatrixCache::size() == 1 );
+    }
+
+    SECTION( "from file" ) {
+        interpolate();
+        auto computed      = cache.get();
+        FileIdentity saved = file_identity( file );
+        MatrixCache::clear();
+        EXPECT( MatrixCache::size() == 0 );
+        EXPECT( equal( interpolate(), reference ) );
+        EXPECT( MatrixCache::size() == 1 );
+        auto mapped = cache.get();
+        EXPECT( mapped != nullptr );
+        EXPECT( mapped != computed );
+        EXPECT( equal( interpolate(), reference ) );
+        EXPECT( cache.get() == mapped );
+        EXPECT( file_identity( file ) == saved );
+    }
+
+    SECTION( "different configuration" ) {
+        Config other = Config( "type", "structured-bicubic" ) | Config( "matrix_cache_directory", directory );
+        EXPECT( MatrixCache( "structured-bicubic", other, fs, pointcloud ).key() != cache.key() );
+    }
+
+    SECTION( "cache options" ) {
+        Config other = Config( "type", "structured-bilinear" ) | Config( "matrix_cache", true );
+        EXPECT( MatrixCache( "structured-bilinear", other, fs, pointcloud ).key() == cache.key() );
+    }
+
+    SECTION( "disabled" ) {
+        EXPECT( not MatrixCache( "structured-bilinear", Config( "type", "structured-bilinear" ), fs, pointcloud ) );
+    }
+
+    MatrixCache::clear();
+    if ( file.exists() ) { file.unlink(); }
+    mpi::comm().barrier();
+    if ( mpi::comm().rank() == 0 && PathName( directory ).exists() ) { PathName( directory ).rmdir(); }
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main( int argc, char** argv ) {
+    return atlas::test::run( argc, argv );
+}
@@ -10,7 +10,9 @@
 
 #include <algorithm>
 #include <sstream>
+#include <string>
 
+#include "eckit/serialisation/FileStream.h"
 #include "eckit/types/FloatCompare.h"
 
 #include "atlas/array/ArrayView.h"
@@ -18,6 +20,7 @@
 #include "atlas/grid/Grid.h"
 #include "atlas/library/Library.h"
 #include "atlas/mesh/IsGhostNode.h"
+#include "atlas/mesh/HybridElements.h"
 #include "atlas/mesh/Mesh.h"
 #include "atlas/mesh/Nodes.h"
 #include "atlas/mesh/actions/BuildDualMesh.h"
@@ -125,6 +128,99 @@ CASE( "test_distribute_t63" ) {
 }
 //-----------------------------------------------------------------------------
 
+template <typename Value>
+bool equal_field( const Field& a, const Field& b ) {
+    auto va = array::make_view<Value, 1>( a );
+    auto vb = array::make_view<Value, 1>( b );
+    if ( va.size() != vb.size() ) return false;
+    for ( size_t j = 0; j < va.size(); ++j ) {
+        if ( va( j ) != vb( j ) ) return false;
+    }
+    return true;
+}
+
+template <typename Connectivity>
+bool equal_connectivity( const Connectivity& a, const Connectivity& b ) {
+    if ( a.rows() != b.rows() ) return false;
+    for ( size_t r = 0; r < a.rows(); ++r ) {
+        if ( a.cols( r ) != b.cols( r ) ) return false;
+        for ( size_t c = 0; c < a.cols( r ); ++c ) {
+            if ( a( r, c ) != b( r, c ) ) return false;
+        }
+    }
+    return true;
+}
+
+CASE( "test_distmesh_encode_decode" ) {
+    meshgenerator::StructuredMeshGenerator generate;
+    Mesh m( generate( Grid( "N16" ) ) );
+
+    mesh::actions::build_parallel_fields( m );
+    mesh::actions::build_periodic_boundaries( m );
+    mesh::actions::build_halo( m, 1 );
+    mesh::actions::build_edges( m );
+    mesh::actions::build_pole_edges( m );
+    mesh::actions::build_edges_parallel_fields( m );
+    mesh::actions::build_median_dual_mesh( m );
+
+    // A custom node connectivity where only the rows of even nodes are set, the others are missing
+    mesh::Nodes::Connectivity& custom = m.nodes().add( new mesh::Nodes::Connectivity( "custom" ) );
+    custom.add( m.nodes().size(), 2 );
+    for ( size_t n = 0; n < m.nodes().size(); n += 2 ) {
+        const idx_t values[] = {idx_t( n ), idx_t( n + 1 )};
+        custom.set( n, values );
+    }
+
+    eckit::PathName path( "test_distmesh_encode." + std::to_string( mpi::comm().rank() ) + ".bin" );
+    {
+        eckit::FileStream s( path, "w" );
+        m.encode( s );
+        s.close();
+    }
+
+    eckit::FileStream s( path, "r" );
+    Mesh restored( s );
+    s.close();
+
+    const mesh::Nodes& nodes          = m.nodes();
+    const mesh::Nodes& restored_nodes = restored.nodes();
+    EXPECT( restored_nodes.size() == nodes.size() );
+    EXPECT( restored.metadata().getInt( "halo" ) == 1 );
+    EXPECT( restored.grid().name() == "N16" );
+
+    auto xy          = array::make_view<double, 2>( nodes.xy() );
+    auto restored_xy = array::make_view<double, 2>( restored_nodes.xy() );
+    for ( size_t n = 0; n < nodes.size(); ++n ) {
+        EXPECT( restored_xy( n, XX ) == xy( n, XX ) );
+        EXPECT( restored_xy( n, YY ) == xy( n, YY ) );
+    }
+    EXPECT( equal_field<gidx_t>( restored_nodes.global_index(), nodes.global_index() ) );
+    EXPECT( equal_field<int>( restored_nodes.remote_index(), nodes.remote_index() ) );
+    EXPECT( equal_field<int>( restored_nodes.partition(), nodes.partition() ) );
+    EXPECT( equal_field<int>( restored_nodes.ghost(), nodes.ghost() ) );
+    EXPECT( equal_field<double>( restored_nodes.field( "dual_volumes" ), nodes.field( "dual_volumes" ) ) );
+
+    EXPECT( restored.cells().size() == m.cells().size() );
+    EXPECT( restored.edges().size() == m.edges().size() );
+    EXPECT( equal_connectivity( restored.cells().node_connectivity(), m.cells().node_connectivity() ) );
+    EXPECT( equal_connectivity( restored.edges().node_connectivity(), m.edges().node_connectivity() ) );
+    EXPECT( equal_connectivity( restored_nodes.edge_connectivity(), nodes.edge_connectivity() ) );
+    EXPECT( equal_connectivity( restored.edges().cell_connectivity(), m.edges().cell_connectivity() ) );
+
+    EXPECT( restored_nodes.nb_connectivities() == nodes.nb_connectivities() );
+    EXPECT( restored_nodes.has_connectivity( "custom" ) );
+    const mesh::Nodes::Connectivity& restored_custom = restored_nodes.connectivity( "custom" );
+    EXPECT( equal_connectivity( restored_custom, nodes.connectivity( "custom" ) ) );
+    EXPECT( restored_custom( 1, 0 ) == restored_custom.missing_value() );
+
+    double computed_dual_volume = test::dual_volume( restored );
+    EXPECT( eckit::types::is_approximately_equal( computed_dual_volume, 360. * 180., 0.0001 ) );
+
+    path.unlink();
+}
+
+//-----------------------------------------------------------------------------
+
 }  // namespace test
 }  // namespace atlas
 
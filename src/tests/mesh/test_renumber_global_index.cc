@@ -0,0 +1,82 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "atlas/library/config.h"
+#include "atlas/mesh/detail/RenumberGlobalIndex.h"
+#include "atlas/parallel/mpi/mpi.h"
+
+#include "tests/AtlasTestEnvironment.h"
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+CASE( "test_renumber_global_index" ) {
+    const size_t rank   = mpi::comm().rank();
+    const size_t nparts = mpi::comm().size();
+
+    // The same sparse set of values on every task, of which every task holds a random
+    // selection, with duplicates within and across tasks
+    std::mt19937 generator( 1 );
+    std::vector<gidx_t> values( 2000 );
+    for ( gidx_t& v : values ) {
+        v = gidx_t( generator() % 1000000 ) * 1009;
+    }
+
+    std::mt19937 local_generator( 100 + rank );
+    std::vector<gidx_t> glb_idx( 500 + 100 * rank );
+    for ( gidx_t& v : glb_idx ) {
+        v = values[local_generator() % values.size()];
+    }
+    const std::vector<gidx_t> original( glb_idx );
+
+    mesh::detail::renumber_global_index( glb_idx, 1 );
+
+    // Reference: dense numbering of all values, computed on every task
+    std::vector<gidx_t> all;
+    for ( size_t jpart = 0; jpart < nparts; ++jpart ) {
+        std::mt19937 g( 100 + jpart );
+        for ( size_t j = 0; j < 500 + 100 * jpart; ++j ) {
+            all.push_back( values[g() % values.size()] );
+        }
+    }
+    std::sort( all.begin(), all.end() );
+    all.erase( std::unique( all.begin(), all.end() ), all.end() );
+
+    for ( size_t j = 0; j < glb_idx.size(); ++j ) {
+        const gidx_t expected = 1 + ( std::lower_bound( all.begin(), all.end(), original[j] ) - all.begin() );
+        EXPECT( glb_idx[j] == expected );
+    }
+}
+
+CASE( "test_renumber_global_index_empty_task" ) {
+    std::vector<gidx_t> glb_idx;
+    if ( mpi::comm().rank() != 0 ) { glb_idx = {30, 10, 20, 10}; }
+
+    mesh::detail::renumber_global_index( glb_idx, 5 );
+
+    if ( mpi::comm().rank() != 0 ) {
+        EXPECT( glb_idx == ( std::vector<gidx_t>{7, 5, 6, 5} ) );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main( int argc, char** argv ) {
+    return atlas::test::run( argc, argv );
+}
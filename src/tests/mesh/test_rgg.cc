@@ -34,6 +34,7 @@
 #include "atlas/util/Config.h"
 #include "atlas/util/CoordinateEnums.h"
 #include "atlas/util/Metadata.h"
+#include "atlas/util/MicroDeg.h"
 
 #include "tests/AtlasTestEnvironment.h"
 
@@ -173,6 +174,76 @@ CASE( "test_partitioner" ) {
     }
 }
 
+CASE( "test_equal_regions_structured" ) {
+    using grid::detail::partitioner::EqualRegionsPartitioner;
+    using NodeInt = EqualRegionsPartitioner::NodeInt;
+
+    // Reference: sort all points of every band west to east, north to south
+    auto reference = []( const EqualRegionsPartitioner& partitioner, const grid::StructuredGrid& grid ) {
+        std::vector<NodeInt> nodes;
+        int n = 0;
+        for ( size_t j = 0; j < grid.ny(); ++j ) {
+            for ( size_t i = 0; i < grid.nx( j ); ++i, ++n ) {
+                nodes.push_back( NodeInt{util::microdeg( grid.x( i, j ) ), util::microdeg( grid.y( j ) ), n} );
+            }
+        }
+        auto compare_WE_NS = []( const NodeInt& node1, const NodeInt& node2 ) {
+            return node1.x < node2.x || ( node1.x == node2.x && node1.y > node2.y );
+        };
+        int nb_parts   = partitioner.nb_partitions();
+        int chunk_size = n / nb_parts;
+        int remainder  = n - chunk_size * nb_parts;
+        std::vector<int> part( n );
+        int p   = 0;
+        int end = 0;
+        for ( int band = 0; band < partitioner.nb_bands(); ++band ) {
+            int band_begin = end;
+            std::vector<int> count;
+            for ( int s = 0; s < partitioner.nb_regions( band ); ++s ) {
+                count.push_back( chunk_size + ( remainder-- > 0 ? 1 : 0 ) );
+                end += count.back();
+            }
+            std::sort( nodes.begin() + band_begin, nodes.begin() + end, compare_WE_NS );
+            int begin = band_begin;
+            for ( int c : count ) {
+                for ( int i = begin; i < begin + c; ++i ) {
+                    part[nodes[i].n] = p;
+                }
+                begin += c;
+                ++p;
+            }
+        }
+        return part;
+    };
+
+    for ( std::string gridname : {"O32", "N24", "L36x19"} ) {
+        grid::StructuredGrid grid( gridname );
+        for ( int nb_parts : {1, 5, 12, 48, 96} ) {
+            EqualRegionsPartitioner partitioner( nb_parts );
+            std::vector<int> expected = reference( partitioner, grid );
+
+            std::vector<int> part( grid.size() );
+            partitioner.partition( grid, part.data() );
+            EXPECT( part == expected );
+
+            for ( gidx_t gidx = 0; gidx < gidx_t( grid.size() ); gidx += 11 ) {
+                EXPECT( partitioner.partition( grid, gidx ) == expected[gidx] );
+            }
+
+            size_t nb_points = 0;
+            for ( int p = 0; p < nb_parts; ++p ) {
+                std::vector<gidx_t> points;
+                partitioner.points( grid, p, points );
+                for ( gidx_t gidx : points ) {
+                    EXPECT( expected[gidx] == p );
+                }
+                nb_points += points.size();
+            }
+            EXPECT( nb_points == grid.size() );
+        }
+    }
+}
+
 CASE( "test_gaussian_latitudes" ) {
     std::vector<double> factory_latitudes;
     std::vector<double> computed_latitudes;
@@ -22,6 +22,7 @@
 #include "atlas/meshgenerator/StructuredMeshGenerator.h"
 #include "atlas/numerics/Nabla.h"
 #include "atlas/numerics/fvm/Method.h"
+#include "atlas/numerics/fvm/Nabla.h"
 #include "atlas/option.h"
 #include "atlas/output/Gmsh.h"
 #include "atlas/parallel/mpi/mpi.h"
@@ -323,6 +324,50 @@ CASE( "test_lapl" ) {
     }
 }
 
+CASE( "test_lapl_overlap" ) {
+    Log::info() << "test_lapl_overlap" << std::endl;
+    size_t nlev         = 2;
+    const double radius = util::Earth::radiusInMeters();
+    Grid grid( griduid() );
+    MeshGenerator meshgenerator( "structured" );
+    Mesh mesh = meshgenerator.generate( grid, Distribution( grid, Partitioner( "equal_regions" ) ) );
+    fvm::Method fvm( mesh, util::Config( "radius", radius ) | option::levels( nlev ) );
+    fvm::Nabla nabla( fvm, util::Config() );
+
+    // There must be work to overlap with the halo exchange, and nodes that have to wait for it
+    const size_t nnodes = mesh.nodes().size();
+    EXPECT( nabla.nb_interior_nodes() > 0 );
+    EXPECT( nabla.nb_interior_nodes() < nnodes );
+    EXPECT( nabla.nb_interior_edges() > 0 );
+    EXPECT( nabla.nb_interior_edges() < mesh.edges().size() );
+
+    FieldSet fields;
+    fields.add( fvm.node_columns().createField<double>( option::name( "scal" ) ) );
+    fields.add( fvm.node_columns().createField<double>( option::name( "grad" ) | option::variables( 2 ) ) );
+    fields.add( fvm.node_columns().createField<double>( option::name( "lapl" ) ) );
+    fields.add( fvm.node_columns().createField<double>( option::name( "lapl_blocking" ) ) );
+
+    rotated_flow_magnitude( fvm, fields["scal"], M_PI_2 * 0.75 );
+
+    // Laplacian with the halo exchange of the gradient overlapping the interior computation
+    nabla.laplacian( fields["scal"], fields["lapl"] );
+
+    // Same with a blocking halo exchange
+    nabla.gradient( fields["scal"], fields["grad"] );
+    fvm.node_columns().haloExchange( fields["grad"] );
+    nabla.divergence( fields["grad"], fields["lapl_blocking"] );
+
+    auto lapl          = array::make_view<double, 2>( fields["lapl"] );
+    auto lapl_blocking = array::make_view<double, 2>( fields["lapl_blocking"] );
+    auto is_ghost      = array::make_view<int, 1>( mesh.nodes().ghost() );
+    for ( size_t jnode = 0; jnode < nnodes; ++jnode ) {
+        if ( is_ghost( jnode ) ) continue;
+        for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
+            EXPECT( lapl( jnode, jlev ) == lapl_blocking( jnode, jlev ) );
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
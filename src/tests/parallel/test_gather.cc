@@ -16,6 +16,7 @@
 #include "atlas/array/ArrayView.h"
 #include "atlas/array/MakeView.h"
 #include "atlas/library/config.h"
+#include "atlas/parallel/Checksum.h"
 #include "atlas/parallel/GatherScatter.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "eckit/utils/Translator.h"
@@ -684,6 +685,36 @@ CASE( "test_gather" ) {
     }
 }
 
+CASE( "test_checksum" ) {
+    Fixture f;
+    parallel::Checksum checksum;
+    checksum.setup( f.part.data(), f.ridx.data(), 0, f.gidx.data(), f.Nl );
+
+    std::vector<POD> loc( f.Nl );
+    for ( int j = 0; j < f.Nl; ++j ) {
+        loc[j] = ( size_t( f.part[j] ) != mpi::comm().rank() ? 0 : f.gidx[j] * 10 );
+    }
+    std::string reference = checksum.execute( loc.data(), 1 );
+
+    // Independent of the partitioning: same as the checksum of the global field
+    util::checksum_t expected = 0;
+    for ( gidx_t g = 1; g <= 9; ++g ) {
+        POD value = g * 10;
+        expected += util::checksum( &value, 1, util::checksum_t( g - 1 ) );
+    }
+    EXPECT( reference == eckit::Translator<util::checksum_t, std::string>()( expected ) );
+
+    // Ghost points do not contribute
+    for ( int j = 0; j < f.Nl; ++j ) {
+        if ( size_t( f.part[j] ) != mpi::comm().rank() ) { loc[j] = -1.; }
+    }
+    EXPECT( checksum.execute( loc.data(), 1 ) == reference );
+
+    // Owned points do
+    if ( mpi::comm().rank() == 1 ) { loc[1] += 1.; }
+    EXPECT( checksum.execute( loc.data(), 1 ) != reference );
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
@@ -625,6 +625,105 @@ void test_rank2_paralleldim2( Fixture& f ) {
     }
 }
 
+void test_multiple_arrays( Fixture& f ) {
+    // arrays of different datatype and rank, exchanged together
+    array::ArrayT<int> arr_int( f.N );
+    array::ArrayT<POD> arr_pod( f.N, 2 );
+    array::ArrayT<float> arr_float( f.N, 3, 2 );
+    auto vint   = array::make_host_view<int, 1>( arr_int );
+    auto vpod   = array::make_host_view<POD, 2>( arr_pod );
+    auto vfloat = array::make_host_view<float, 3>( arr_float );
+    for ( int j = 0; j < f.N; ++j ) {
+        bool owned   = size_t( f.part[j] ) == mpi::comm().rank();
+        vint( j )    = owned ? int( f.gidx[j] ) : 0;
+        vpod( j, 0 ) = owned ? f.gidx[j] * 10 : 0;
+        vpod( j, 1 ) = owned ? f.gidx[j] * 100 : 0;
+        for ( int k = 0; k < 3; ++k ) {
+            for ( int l = 0; l < 2; ++l ) {
+                vfloat( j, k, l ) = owned ? float( f.gidx[j] * ( 10 * k + l + 1 ) ) : 0.f;
+            }
+        }
+    }
+
+    std::vector<array::Array*> arrays{&arr_int, &arr_pod, &arr_float};
+    f.halo_exchange.execute( arrays );
+
+    std::vector<int> gidx_c;
+    switch ( mpi::comm().rank() ) {
+        case 0:
+            gidx_c = {9, 1, 2, 3, 4};
+            break;
+        case 1:
+            gidx_c = {3, 4, 5, 6, 7, 8};
+            break;
+        case 2:
+            gidx_c = {5, 6, 7, 8, 9, 1, 2};
+            break;
+    }
+    for ( int j = 0; j < f.N; ++j ) {
+        EXPECT( vint( j ) == gidx_c[j] );
+        EXPECT( vpod( j, 0 ) == gidx_c[j] * 10 );
+        EXPECT( vpod( j, 1 ) == gidx_c[j] * 100 );
+        for ( int k = 0; k < 3; ++k ) {
+            for ( int l = 0; l < 2; ++l ) {
+                EXPECT( vfloat( j, k, l ) == float( gidx_c[j] * ( 10 * k + l + 1 ) ) );
+            }
+        }
+    }
+}
+
+void test_start_wait( Fixture& f ) {
+    array::ArrayT<double> arr( f.N, 2 );
+    auto v = array::make_host_view<double, 2>( arr );
+    for ( int j = 0; j < f.N; ++j ) {
+        bool owned = size_t( f.part[j] ) == mpi::comm().rank();
+        v( j, 0 )  = owned ? f.gidx[j] * 10 : 0;
+        v( j, 1 )  = owned ? f.gidx[j] * 100 : 0;
+    }
+
+    std::vector<array::Array*> arrays{&arr};
+    parallel::HaloExchange::Handle handle = f.halo_exchange.start( arrays );
+    EXPECT( handle.active() );
+
+    // Owned values were packed by start(), so they may be modified while the halo is in flight
+    for ( int j = 0; j < f.N; ++j ) {
+        if ( size_t( f.part[j] ) == mpi::comm().rank() ) {
+            v( j, 0 ) = -v( j, 0 );
+            v( j, 1 ) = -v( j, 1 );
+        }
+    }
+
+    f.halo_exchange.wait( handle );
+    EXPECT( not handle.active() );
+
+    std::vector<int> gidx_c;
+    switch ( mpi::comm().rank() ) {
+        case 0:
+            gidx_c = {9, 1, 2, 3, 4};
+            break;
+        case 1:
+            gidx_c = {3, 4, 5, 6, 7, 8};
+            break;
+        case 2:
+            gidx_c = {5, 6, 7, 8, 9, 1, 2};
+            break;
+    }
+    for ( int j = 0; j < f.N; ++j ) {
+        double sign = size_t( f.part[j] ) == mpi::comm().rank() ? -1. : 1.;
+        EXPECT( v( j, 0 ) == sign * gidx_c[j] * 10 );
+        EXPECT( v( j, 1 ) == sign * gidx_c[j] * 100 );
+    }
+
+    // The handle can be reused for a next exchange
+    f.halo_exchange.start( arrays, handle );
+    f.halo_exchange.wait( handle );
+    for ( int j = 0; j < f.N; ++j ) {
+        EXPECT( v( j, 0 ) == -gidx_c[j] * 10 );
+    }
+
+    EXPECT_THROWS_AS( f.halo_exchange.wait( handle ), eckit::SeriousBug );
+}
+
 void test_rank1_cinterface( Fixture& f ) {
 #if ATLAS_GRIDTOOLS_STORAGE_BACKEND_HOST
     array::ArrayT<POD> arr( f.N, 2 );
@@ -689,6 +788,31 @@ CASE( "test_haloexchange" ) {
         SECTION( "test_rank2_paralleldim_2" ) { test_rank2_paralleldim2( f ); }
         SECTION( "test_rank1_cinterface" ) { test_rank1_cinterface( f ); }
 
+        SECTION( "test_multiple_arrays" ) { test_multiple_arrays( f ); }
+
+        SECTION( "test_start_wait" ) { test_start_wait( f ); }
+
+        SECTION( "test_repeated" ) {
+            // Plans and buffers are reused for the same datatype and variable size
+            size_t nb_plans = 0;
+            std::vector<const POD*> buffers;
+            for ( int j = 0; j < 3; ++j ) {
+                test_rank0_arrview( f );
+                test_rank1( f );
+                test_rank2( f );
+                std::vector<const POD*> b{f.halo_exchange.plan_send_buffer<POD>( 1 ),
+                                          f.halo_exchange.plan_send_buffer<POD>( 2 ),
+                                          f.halo_exchange.plan_send_buffer<POD>( 6 )};
+                if ( j == 0 ) {
+                    nb_plans = f.halo_exchange.nb_plans();
+                    buffers  = b;
+                }
+                EXPECT( f.halo_exchange.nb_plans() == 3 );
+                EXPECT( f.halo_exchange.nb_plans() == nb_plans );
+                EXPECT( b == buffers );
+            }
+        }
+
 #if ATLAS_GRIDTOOLS_STORAGE_BACKEND_CUDA
         f.on_device_ = true;
 
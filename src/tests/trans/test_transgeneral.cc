@@ -12,6 +12,7 @@
 #include <iomanip>
 
 #include "atlas/array/MakeView.h"
+#include "atlas/domain.h"
 #include "atlas/field/FieldSet.h"
 #include "atlas/functionspace/NodeColumns.h"
 #include "atlas/functionspace/Spectral.h"
@@ -30,8 +31,10 @@
 #include "atlas/runtime/Trace.h"
 #include "atlas/trans/Trans.h"
 #include "atlas/trans/local/FourierTransforms.h"
+#include "atlas/trans/local/LegendreCacheFile.h"
 #include "atlas/trans/local/LegendrePolynomials.h"
 #include "atlas/trans/local/LegendreTransforms.h"
+#include "atlas/trans/local/TransLocal.h"
 
 #include "tests/AtlasTestEnvironment.h"
 
@@ -833,6 +836,195 @@ CASE( "test_trans_invtrans" ) {
 
     trans.invtrans( 1, rspec.data(), rgp.data() );
 }
+
+//-----------------------------------------------------------------------------
+
+CASE( "test_trans_invtrans_fft" ) {
+    // compare FFT based Fourier transform with pointwise Fourier transform
+    for ( std::string gridname : {"O32", "F32", "L64x33"} ) {
+        Grid g( gridname );
+        int trc = 31;
+        trans::Trans trans_fft( g, trc, util::Config( "type", "local" ) );
+        trans::Trans trans_dft( g, trc, util::Config( "type", "local" ) | util::Config( "fft", false ) );
+        trans::Trans trans_cached( trans::FFTCache( g ), g, trc, util::Config( "type", "local" ) );
+
+        int nb_fields = 3;
+        std::vector<double> rspec( nb_fields * trans_fft.spectralCoefficients() );
+        for ( size_t j = 0; j < rspec.size(); ++j ) {
+            rspec[j] = std::sin( 0.1 * j ) / ( 1. + 0.01 * j );
+        }
+        std::vector<double> rgp_fft( nb_fields * g.size() );
+        std::vector<double> rgp_dft( nb_fields * g.size() );
+        std::vector<double> rgp_cached( nb_fields * g.size() );
+
+        trans_fft.invtrans( nb_fields, rspec.data(), rgp_fft.data() );
+        trans_dft.invtrans( nb_fields, rspec.data(), rgp_dft.data() );
+        trans_cached.invtrans( nb_fields, rspec.data(), rgp_cached.data() );
+
+        for ( int jfld = 0; jfld < nb_fields; ++jfld ) {
+            double rms = compute_rms( g.size(), rgp_fft.data() + jfld * g.size(), rgp_dft.data() + jfld * g.size() );
+            EXPECT( rms < 1.e-12 );
+        }
+        EXPECT( rgp_cached == rgp_fft );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+CASE( "test_trans_legendre_symmetric" ) {
+    // compare batched Legendre transform using north/south symmetry with the per latitude transform
+    int trc = 47, trcLP = trc + 1, nb_fields = 3, nb_lats = 7;
+    std::vector<double> rspec( nb_fields * ( trc + 1 ) * ( trc + 2 ) );
+    for ( size_t j = 0; j < rspec.size(); ++j ) {
+        rspec[j] = std::sin( 0.37 * j ) + 0.1;
+    }
+    size_t size = ( trcLP + 2 ) * ( trcLP + 1 ) / 2;
+    std::vector<double> legpol_north( nb_lats * size ), legpol_south( nb_lats * size );
+    std::vector<const double*> legpol( nb_lats );
+    for ( int j = 0; j < nb_lats; ++j ) {
+        double lat = 0.1 + 0.2 * j;
+        trans::compute_legendre_polynomials( trcLP, lat, legpol_north.data() + j * size );
+        trans::compute_legendre_polynomials( trcLP, -lat, legpol_south.data() + j * size );
+        legpol[j] = legpol_north.data() + j * size;
+    }
+    std::vector<double> leg_north( nb_lats * 2 * nb_fields ), leg_south( nb_lats * 2 * nb_fields );
+    std::vector<double> leg_real( ( trc + 1 ) * nb_fields ), leg_imag( ( trc + 1 ) * nb_fields );
+    double maxdiff = 0.;
+    for ( int jm = 0; jm <= trc; ++jm ) {
+        trans::invtrans_legendre_symmetric( trc, trcLP, jm, nb_lats, legpol.data(), nb_fields, rspec.data(),
+                                            leg_north.data(), leg_south.data() );
+        for ( int j = 0; j < nb_lats; ++j ) {
+            for ( auto hemisphere : {std::make_pair( &legpol_north, &leg_north ),
+                                     std::make_pair( &legpol_south, &leg_south )} ) {
+                trans::invtrans_legendre( trc, trc, trcLP, hemisphere.first->data() + j * size, nb_fields,
+                                          rspec.data(), leg_real.data(), leg_imag.data() );
+                const double* leg = hemisphere.second->data() + 2 * j * nb_fields;
+                for ( int jfld = 0; jfld < nb_fields; ++jfld ) {
+                    maxdiff = std::max( maxdiff, std::abs( leg[jfld] - leg_real[jm * nb_fields + jfld] ) );
+                    maxdiff = std::max( maxdiff, std::abs( leg[nb_fields + jfld] - leg_imag[jm * nb_fields + jfld] ) );
+                }
+            }
+        }
+    }
+    EXPECT( maxdiff < 1.e-12 );
+}
+
+//-----------------------------------------------------------------------------
+
+CASE( "test_trans_dirtrans" ) {
+    // spectral -> gridpoint -> spectral round trip with the local backend
+    Grid g( "F32" );
+    int trc = 31;
+    for ( bool fft : {true, false} ) {
+        trans::Trans trans( g, trc, util::Config( "type", "local" ) | util::Config( "fft", fft ) );
+
+        int nb_fields = 2;
+        std::vector<double> rspec( nb_fields * trans.spectralCoefficients() );
+        std::vector<double> vor( rspec.size() );
+        std::vector<double> div( rspec.size() );
+        int k = 0;
+        for ( int m = 0; m <= trc; ++m ) {
+            for ( int n = m; n <= trc; ++n ) {
+                for ( int imag = 0; imag < 2; ++imag ) {
+                    for ( int jfld = 0; jfld < nb_fields; ++jfld, ++k ) {
+                        bool zero = ( m == 0 && imag == 1 );
+                        rspec[k]  = zero ? 0. : std::sin( 0.1 * k ) / ( 1. + 0.01 * k );
+                        vor[k]    = ( zero || n == 0 ) ? 0. : 1.e-5 * std::cos( 0.2 * k ) / ( 1. + 0.1 * n );
+                        div[k]    = ( zero || n == 0 ) ? 0. : 1.e-6 * std::sin( 0.3 * k ) / ( 1. + 0.1 * n );
+                    }
+                }
+            }
+        }
+
+        // scalar fields
+        std::vector<double> rgp( nb_fields * g.size() );
+        std::vector<double> rspec_back( rspec.size() );
+        trans.invtrans( nb_fields, rspec.data(), rgp.data() );
+        trans.dirtrans( nb_fields, rgp.data(), rspec_back.data() );
+        EXPECT( compute_rms( rspec.size(), rspec.data(), rspec_back.data() ) < 1.e-12 );
+
+        // vorticity and divergence
+        std::vector<double> rwind( 2 * nb_fields * g.size() );
+        std::vector<double> vor_back( vor.size() );
+        std::vector<double> div_back( div.size() );
+        trans.invtrans( nb_fields, vor.data(), div.data(), rwind.data() );
+        trans.dirtrans( nb_fields, rwind.data(), vor_back.data(), div_back.data() );
+        EXPECT( compute_rms( vor.size(), vor.data(), vor_back.data() ) < 1.e-12 );
+        EXPECT( compute_rms( div.size(), div.data(), div_back.data() ) < 1.e-12 );
+    }
+
+    // direct transforms need Gaussian quadrature
+    trans::Trans trans_lonlat( Grid( "L64x33" ), trc, util::Config( "type", "local" ) );
+    std::vector<double> rgp( trans_lonlat.grid().size() );
+    std::vector<double> rspec( trans_lonlat.spectralCoefficients() );
+    EXPECT_THROWS_AS( trans_lonlat.dirtrans( 1, rgp.data(), rspec.data() ), eckit::NotImplemented );
+
+    // ... over all latitudes of the Gaussian grid, which a cropped grid does not have
+    trans::Trans trans_cropped( Grid( "F32", RectangularDomain( {-180., 180.}, {-45., 45.} ) ), trc,
+                                util::Config( "type", "local" ) );
+    std::vector<double> rgp_cropped( trans_cropped.grid().size() );
+    EXPECT_THROWS_AS( trans_cropped.dirtrans( 1, rgp_cropped.data(), rspec.data() ), eckit::NotImplemented );
+}
+
+//-----------------------------------------------------------------------------
+
+CASE( "test_trans_legendre_cache" ) {
+    Grid g( "O24" );
+    int trc = 23;
+    eckit::PathName cachefile = trans::LegendreCacheFile::path( ".", g, trc + 1 );
+    if ( mpi::comm().rank() == 0 && cachefile.exists() ) { cachefile.unlink(); }
+    mpi::comm().barrier();
+
+    std::vector<double> rspec( trans::Trans( g, trc, util::Config( "type", "local" ) ).spectralCoefficients() );
+    for ( size_t j = 0; j < rspec.size(); ++j ) {
+        rspec[j] = std::sin( 0.1 * j ) / ( 1. + 0.01 * j );
+    }
+    auto invtrans = [&]( const trans::Trans& trans ) {
+        std::vector<double> rgp( g.size() );
+        trans.invtrans( 1, rspec.data(), rgp.data() );
+        return rgp;
+    };
+
+    std::vector<double> rgp_nocache = invtrans( trans::Trans( g, trc, util::Config( "type", "local" ) ) );
+
+    // First run computes and writes the cache file
+    std::vector<double> rgp_write =
+        invtrans( trans::Trans( g, trc, util::Config( "type", "local" ) | util::Config( "legendre_cache", "." ) ) );
+    mpi::comm().barrier();
+    EXPECT( cachefile.exists() );
+
+    // Later runs map the cache file
+    std::vector<double> rgp_read =
+        invtrans( trans::Trans( g, trc, util::Config( "type", "local" ) | util::Config( "legendre_cache", "." ) ) );
+    std::vector<double> rgp_cache =
+        invtrans( trans::Trans( trans::LegendreCache( cachefile ), g, trc, util::Config( "type", "local" ) ) );
+
+    EXPECT( rgp_write == rgp_nocache );
+    EXPECT( rgp_read == rgp_nocache );
+    EXPECT( rgp_cache == rgp_nocache );
+
+    // A cache for another truncation is not used
+    std::vector<double> rgp_other =
+        invtrans( trans::Trans( trans::LegendreCache( cachefile ), g, trc - 1, util::Config( "type", "local" ) ) );
+    std::vector<double> rgp_other_nocache = invtrans( trans::Trans( g, trc - 1, util::Config( "type", "local" ) ) );
+    EXPECT( rgp_other == rgp_other_nocache );
+
+    // ... and the computed polynomials are written to the cache directory, when given
+    eckit::PathName otherfile = trans::LegendreCacheFile::path( ".", g, trc );
+    if ( mpi::comm().rank() == 0 && otherfile.exists() ) { otherfile.unlink(); }
+    mpi::comm().barrier();
+    rgp_other = invtrans( trans::Trans( trans::LegendreCache( cachefile ), g, trc - 1,
+                                        util::Config( "type", "local" ) | util::Config( "legendre_cache", "." ) ) );
+    mpi::comm().barrier();
+    EXPECT( otherfile.exists() );
+    EXPECT( rgp_other == rgp_other_nocache );
+
+    mpi::comm().barrier();
+    if ( mpi::comm().rank() == 0 ) {
+        cachefile.unlink();
+        otherfile.unlink();
+    }
+}
 #endif
 
     //-----------------------------------------------------------------------------
@@ -0,0 +1,89 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "atlas/util/ExactSum.h"
+
+#include "tests/AtlasTestEnvironment.h"
+
+using atlas::util::ExactSum;
+
+namespace atlas {
+namespace test {
+
+// -----------------------------------------------------------------------------
+
+CASE( "test_exactsum_cancellation" ) {
+    ExactSum sum;
+    sum.add( 1.e300 );
+    sum.add( 1. );
+    sum.add( -1.e300 );
+    EXPECT( sum.value() == 1. );
+
+    ExactSum tiny;
+    tiny.add( std::numeric_limits<double>::denorm_min() );
+    tiny.add( std::numeric_limits<double>::denorm_min() );
+    EXPECT( tiny.value() == 2. * std::numeric_limits<double>::denorm_min() );
+
+    ExactSum negative;
+    negative.add( -3.5 );
+    negative.add( 1.25 );
+    EXPECT( negative.value() == -2.25 );
+}
+
+CASE( "test_exactsum_order_independent" ) {
+    std::mt19937 generator( 7 );
+    std::normal_distribution<double> normal( 0., 1. );
+    std::vector<double> values( 10000 );
+    for ( size_t j = 0; j < values.size(); ++j ) {
+        values[j] = normal( generator ) * std::pow( 10., int( j % 21 ) - 10 );
+    }
+
+    ExactSum reference;
+    for ( double v : values ) {
+        reference.add( v );
+    }
+
+    // Different order, and split over several partial sums that are combined afterwards
+    std::shuffle( values.begin(), values.end(), generator );
+    std::vector<ExactSum> partial( 7 );
+    for ( size_t j = 0; j < values.size(); ++j ) {
+        partial[j % partial.size()].add( values[j] );
+    }
+    ExactSum combined;
+    for ( const ExactSum& p : partial ) {
+        combined += p;
+    }
+
+    EXPECT( combined.value() == reference.value() );
+}
+
+CASE( "test_exactsum_nonfinite" ) {
+    ExactSum sum;
+    sum.add( 1. );
+    sum.add( std::numeric_limits<double>::infinity() );
+    EXPECT( sum.value() == std::numeric_limits<double>::infinity() );
+    sum.add( -std::numeric_limits<double>::infinity() );
+    EXPECT( std::isnan( sum.value() ) );
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main( int argc, char** argv ) {
+    return atlas::test::run( argc, argv );
+}
@@ -0,0 +1,167 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <map>
+#include <random>
+
+#include "atlas/util/detail/FlatHashMap.h"
+
+#include "tests/AtlasTestEnvironment.h"
+
+using atlas::util::FlatHashMap;
+using atlas::util::FlatHashSet;
+
+namespace atlas {
+namespace test {
+
+// -----------------------------------------------------------------------------
+
+/// Maps every key to the same slot, so that all keys collide
+struct CollidingHash {
+    size_t operator()( long ) const { return 5; }
+};
+
+template <typename Map>
+bool equal( const Map& map, const std::map<long, int>& reference ) {
+    if ( map.size() != reference.size() ) return false;
+    for ( const auto& entry : reference ) {
+        const int* value = map.find( entry.first );
+        if ( value == nullptr || *value != entry.second ) return false;
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+CASE( "test_flathashmap_insert_find" ) {
+    FlatHashMap<long, int> map;
+    EXPECT( map.empty() );
+    EXPECT( map.find( 3 ) == nullptr );
+
+    EXPECT( map.insert( 3, 30 ) );
+    EXPECT( map.insert( -7, 70 ) );
+    EXPECT( not map.insert( 3, 31 ) );  // already present, value untouched
+    EXPECT( map.size() == 2 );
+    EXPECT( *map.find( 3 ) == 30 );
+    EXPECT( *map.find( -7 ) == 70 );
+    EXPECT( map.find( 4 ) == nullptr );
+    EXPECT( not map.contains( 4 ) );
+
+    map[4] += 2;  // value-initialised on insertion
+    EXPECT( *map.find( 4 ) == 2 );
+    *map.find( 3 ) = 33;
+    EXPECT( map[3] == 33 );
+    EXPECT( map.size() == 3 );
+
+    const size_t capacity = map.capacity();
+    map.clear();
+    EXPECT( map.empty() );
+    EXPECT( map.find( 3 ) == nullptr );
+    EXPECT( map.capacity() == capacity );
+}
+
+CASE( "test_flathashmap_erase" ) {
+    FlatHashMap<long, int, CollidingHash> map;
+    for ( long key = 0; key < 6; ++key ) {
+        EXPECT( map.insert( key, int( 10 * key ) ) );
+    }
+
+    // Keys probed after an erased key must still be found through its tombstone
+    EXPECT( map.erase( 2 ) );
+    EXPECT( not map.erase( 2 ) );
+    EXPECT( not map.erase( 100 ) );
+    EXPECT( map.size() == 5 );
+    EXPECT( map.find( 2 ) == nullptr );
+    for ( long key : {0, 1, 3, 4, 5} ) {
+        EXPECT( map.find( key ) != nullptr );
+        EXPECT( *map.find( key ) == 10 * key );
+    }
+
+    // A key inserted after erasure is found once, also when it was present before
+    EXPECT( map.insert( 5, 55 ) == false );
+    EXPECT( map.insert( 2, 22 ) );
+    EXPECT( *map.find( 2 ) == 22 );
+    EXPECT( map.size() == 6 );
+    EXPECT( map.erase( 2 ) );
+    EXPECT( map.erase( 5 ) );
+    EXPECT( map.insert( 5, 56 ) );
+    EXPECT( *map.find( 5 ) == 56 );
+    EXPECT( map.size() == 5 );
+
+    // Repeated insertion and erasure does not grow the map
+    const size_t capacity = map.capacity();
+    for ( int j = 0; j < 1000; ++j ) {
+        EXPECT( map.insert( 1000 + j, j ) );
+        EXPECT( map.erase( 1000 + j ) );
+    }
+    EXPECT( map.capacity() == capacity );
+    EXPECT( map.size() == 5 );
+
+    FlatHashSet<long> set;
+    EXPECT( set.insert( 8 ) );
+    EXPECT( set.erase( 8 ) );
+    EXPECT( not set.contains( 8 ) );
+    EXPECT( set.empty() );
+}
+
+CASE( "test_flathashmap_colliding_keys" ) {
+    FlatHashMap<long, int, CollidingHash> map;
+    std::map<long, int> reference;
+    for ( long key = 0; key < 100; ++key ) {
+        map[key * 17]       = int( key );
+        reference[key * 17]       = int( key );
+    }
+    EXPECT( equal( map, reference ) );
+    EXPECT( map.find( 1 ) == nullptr );
+}
+
+CASE( "test_flathashmap_rehash" ) {
+    FlatHashMap<long, int> map;
+    std::map<long, int> reference;
+    std::mt19937 generator( 7 );
+    std::uniform_int_distribution<long> distribution( -1000000, 1000000 );
+
+    size_t capacity = map.capacity();
+    size_t nb_grow  = 0;
+    for ( int j = 0; j < 10000; ++j ) {
+        const long key = distribution( generator );
+        EXPECT( map.insert( key, j ) == reference.insert( std::make_pair( key, j ) ).second );
+        EXPECT( 2 * map.size() <= map.capacity() );
+        if ( map.capacity() != capacity ) {
+            capacity = map.capacity();
+            ++nb_grow;
+        }
+        // Erase some keys, so that the map holds tombstones when it grows
+        if ( j % 3 == 0 ) {
+            const long erased = distribution( generator );
+            EXPECT( map.erase( erased ) == ( reference.erase( erased ) == 1 ) );
+        }
+    }
+    EXPECT( nb_grow > 5 );
+    EXPECT( equal( map, reference ) );
+
+    // Reserving up front avoids growing
+    FlatHashMap<long, int> reserved( reference.size() );
+    capacity = reserved.capacity();
+    for ( const auto& entry : reference ) {
+        reserved.insert( entry.first, entry.second );
+    }
+    EXPECT( reserved.capacity() == capacity );
+    EXPECT( equal( reserved, reference ) );
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main( int argc, char** argv ) {
+    return atlas::test::run( argc, argv );
+}
@@ -0,0 +1,128 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <sstream>
+#include <string>
+
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/runtime/trace/CallStack.h"
+#include "atlas/runtime/trace/Timeline.h"
+#include "atlas/util/Config.h"
+
+#include "tests/AtlasTestEnvironment.h"
+
+using atlas::runtime::trace::CallStack;
+using atlas::runtime::trace::Timeline;
+
+namespace atlas {
+namespace test {
+
+// -----------------------------------------------------------------------------
+
+/// Count column of the report line of the timer with given title, or -1 if not reported
+long reported_count( const std::string& report, const std::string& title ) {
+    std::istringstream in( report );
+    std::string line;
+    const std::string sep = " │ ";
+    while ( std::getline( in, line ) ) {
+        size_t pos = line.find( title + " " );
+        if ( pos == std::string::npos ) continue;
+        pos = line.find( sep, pos );
+        if ( pos == std::string::npos ) continue;
+        return std::stol( line.substr( pos + sep.size() ) );
+    }
+    return -1;
+}
+
+CASE( "test_callstack" ) {
+    CallStack a;
+    CallStack b;
+    a.push_front( eckit::CodeLocation( "file1", 10, "f" ) );
+    a.push_front( eckit::CodeLocation( "file2", 20, "g" ) );
+    b.push_front( eckit::CodeLocation( "file2", 20, "g" ) );
+    b.push_front( eckit::CodeLocation( "file1", 10, "f" ) );
+    EXPECT( a.size() == 2 );
+    EXPECT( a.hash() != b.hash() );
+
+    CallStack c( a );
+    EXPECT( c.hash() == a.hash() );
+    c.pop_front();
+    b.pop_front();
+    EXPECT( c.size() == 1 );
+    EXPECT( c.hash() != b.hash() );
+    b.pop_front();
+    b.push_front( eckit::CodeLocation( "file1", 10, "f" ) );
+    EXPECT( c.hash() == b.hash() );
+    EXPECT( *c.begin() == *a.rbegin() );
+
+    CallStack d( a, 1 );
+    EXPECT( d.size() == 1 );
+    EXPECT( d.hash() == c.hash() );
+}
+
+CASE( "test_trace_in_parallel_region" ) {
+    const long n = 1000;
+    {
+        Trace outer( Here(), "test_trace_outer" );
+        atlas_omp_parallel_for( long i = 0; i < n; ++i ) {
+            Trace inner( Here(), "test_trace_inner" );
+            inner.stop();
+        }
+    }
+
+    std::string report = Trace::report();
+    Log::info() << report << std::endl;
+    EXPECT( reported_count( report, "test_trace_outer" ) == 1 );
+    EXPECT( reported_count( report, "test_trace_inner" ) == n );
+}
+
+CASE( "test_trace_timeline" ) {
+    atlas::Library::instance().initialise( util::Config( "trace", util::Config( "timeline", true ) ) );
+    EXPECT( Timeline::enabled() );
+    Timeline::clear();
+
+    const long n = 10;
+    {
+        Trace outer( Here(), "test_timeline_outer" );
+        atlas_omp_parallel_for( long i = 0; i < n; ++i ) {
+            Trace inner( Here(), "test_timeline_inner" );
+        }
+    }
+    EXPECT( Timeline::size() == n + 1 );
+
+    std::stringstream json;
+    Timeline::write( json );
+    std::string str = json.str();
+    Log::info() << str << std::endl;
+
+    const std::string complete_event = "\"ph\":\"X\"";
+    size_t count                     = 0;
+    size_t pos                       = str.find( complete_event );
+    while ( pos != std::string::npos ) {
+        ++count;
+        pos = str.find( complete_event, pos + 1 );
+    }
+    EXPECT( count == n + 1 );
+    EXPECT( str.find( "\"name\":\"test_timeline_outer\"" ) != std::string::npos );
+    EXPECT( str.find( "\"name\":\"test_timeline_inner\"" ) != std::string::npos );
+
+    atlas::Library::instance().initialise( util::Config( "trace", util::Config( "timeline", false ) ) );
+    EXPECT( not Timeline::enabled() );
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main( int argc, char** argv ) {
+    return atlas::test::run( argc, argv );
+}